@@ -134,6 +134,34 @@ typedef rx_uint64 rx_size;
 #define RX_PARAM_DATA rxp_data
 
 #define RX_DATA RX_PARAM_DATA
+#define RX_SUITE_DATA rx_get_suite_data(RX_PARAM_CONTEXT)
+#define RX_BENCHMARK_ARG rx_get_benchmark_arg(RX_PARAM_CONTEXT)
+
+#define RX_SET_BYTES_PROCESSED(count)                                          \
+    rx_set_bytes_processed(RX_PARAM_CONTEXT, (count))
+#define RX_SET_ITEMS_PROCESSED(count)                                          \
+    rx_set_items_processed(RX_PARAM_CONTEXT, (count))
+#define RX_METRIC(name, value) rx_set_metric(RX_PARAM_CONTEXT, (name), (value))
+#define RX_RECORD_LATENCY(name, ns)                                            \
+    rx_record_latency(RX_PARAM_CONTEXT, (name), (ns))
+
+#define RX_PAUSE_TIMING() rx_pause_timing(RX_PARAM_CONTEXT)
+#define RX_RESUME_TIMING() rx_resume_timing(RX_PARAM_CONTEXT)
+
+/*
+   Optimizer barriers for the benchmarks. With GCC-compatible compilers, empty
+   inline assembly statements pretend to read the given value, or any memory.
+   Other compilers fall back to calling a function through a volatile pointer,
+   which the optimizer can't see through, in which case the value passed to
+   `RX_DO_NOT_OPTIMIZE()` must be an lvalue.
+*/
+#if defined(__GNUC__)
+#define RX_DO_NOT_OPTIMIZE(x) __asm__ __volatile__("" : : "r,m"(x) : "memory")
+#define RX_CLOBBER_MEMORY() __asm__ __volatile__("" : : : "memory")
+#else
+#define RX_DO_NOT_OPTIMIZE(x) rxp_escape((const volatile void *)&(x))
+#define RX_CLOBBER_MEMORY() rxp_escape(NULL)
+#endif
 
 enum rx_status {
     RX_SUCCESS = 0,
@@ -145,6 +173,26 @@ enum rx_status {
 
 enum rx_severity { RX_NONFATAL = 0, RX_FATAL = 1 };
 
+enum rx_complexity {
+    RX_COMPLEXITY_NONE = 0,
+    RX_COMPLEXITY_1 = 1,
+    RX_COMPLEXITY_LOG_N = 2,
+    RX_COMPLEXITY_N = 3,
+    RX_COMPLEXITY_N_LOG_N = 4,
+    RX_COMPLEXITY_N_SQUARED = 5
+};
+
+enum rx_usage_metric {
+    RX_USAGE_CPU_TIME = 0,
+    RX_USAGE_USER_TIME = 1,
+    RX_USAGE_SYSTEM_TIME = 2,
+    RX_USAGE_MAX_RSS_GROWTH = 3,
+    RX_USAGE_MINOR_FAULTS = 4,
+    RX_USAGE_MAJOR_FAULTS = 5,
+    RX_USAGE_VOLUNTARY_CONTEXT_SWITCHES = 6,
+    RX_USAGE_INVOLUNTARY_CONTEXT_SWITCHES = 7
+};
+
 enum rx_log_level {
     RX_LOG_LEVEL_NONE = 0,
     RX_LOG_LEVEL_FATAL = 1,
@@ -174,6 +222,8 @@ struct rx_fixture {
 struct rx_test_case_config {
     int skip;
     struct rx_fixture fixture;
+    double timeout;
+    struct rx_fixture suite_fixture;
 };
 
 struct rx_test_case {
@@ -191,6 +241,87 @@ struct rx_failure {
     const char *diagnostic_msg;
 };
 
+struct rx_perf_counters {
+    int available;
+    rx_uint64 cycles;
+    rx_uint64 instructions;
+    rx_uint64 cache_misses;
+    rx_uint64 branch_misses;
+};
+
+struct rx_resource_usage {
+    int available;
+    rx_uint64 user_time;
+    rx_uint64 system_time;
+    rx_uint64 max_rss_growth;
+    rx_uint64 minor_faults;
+    rx_uint64 major_faults;
+    rx_uint64 voluntary_context_switches;
+    rx_uint64 involuntary_context_switches;
+};
+
+struct rx_alloc_stats {
+    int available;
+    rx_uint64 allocation_count;
+    rx_uint64 free_count;
+    rx_uint64 allocated_bytes;
+    rx_uint64 peak_bytes;
+    rx_uint64 live_count;
+    rx_uint64 live_bytes;
+};
+
+struct rx_phase_times {
+    int set_up_available;
+    int run_available;
+    int tear_down_available;
+    rx_uint64 set_up;
+    rx_uint64 run;
+    rx_uint64 tear_down;
+};
+
+#define RXP_METRIC_MAX_COUNT 8
+
+struct rx_metric {
+    const char *name;
+    double value;
+};
+
+struct rx_metrics {
+    rx_uint64 bytes_processed;
+    rx_uint64 items_processed;
+    rx_size count;
+    struct rx_metric values[RXP_METRIC_MAX_COUNT];
+};
+
+/*
+   Log-linear histogram in the style of HdrHistogram: the values are split
+   into buckets covering the powers of two, each subdivided into 128 linear
+   sub-buckets, which bounds the relative error to below 0.8% for any value
+   up to 2^40 nanoseconds while keeping the memory used fixed. Larger values
+   are counted in the last bucket. The histograms are only allocated once
+   a sample is recorded under their name.
+*/
+#define RXP_LATENCY_HISTOGRAM_MAX_COUNT 4
+#define RXP_LATENCY_HISTOGRAM_SUB_BUCKET_BITS 8
+#define RXP_LATENCY_HISTOGRAM_VALUE_BITS 40
+#define RXP_LATENCY_HISTOGRAM_BUCKET_COUNT                                     \
+    ((RXP_LATENCY_HISTOGRAM_VALUE_BITS                                         \
+      - RXP_LATENCY_HISTOGRAM_SUB_BUCKET_BITS + 2)                             \
+     << (RXP_LATENCY_HISTOGRAM_SUB_BUCKET_BITS - 1))
+
+struct rx_latency_histogram {
+    const char *name;
+    rx_uint64 count;
+    rx_uint64 min;
+    rx_uint64 max;
+    rx_uint32 buckets[RXP_LATENCY_HISTOGRAM_BUCKET_COUNT];
+};
+
+struct rx_latency_histograms {
+    rx_size count;
+    struct rx_latency_histogram *values;
+};
+
 struct rx_summary {
     const struct rx_test_case *test_case;
     int skipped;
@@ -199,6 +330,13 @@ struct rx_summary {
     rx_size failure_count;
     struct rx_failure *failures;
     rx_uint64 elapsed;
+    struct rx_perf_counters perf_counters;
+    struct rx_resource_usage resource_usage;
+    struct rx_phase_times wall_time;
+    struct rx_phase_times cpu_time;
+    struct rx_metrics metrics;
+    struct rx_alloc_stats alloc_stats;
+    struct rx_latency_histograms latencies;
 };
 
 struct rx_summary_group {
@@ -206,6 +344,89 @@ struct rx_summary_group {
     const struct rx_summary *array;
 };
 
+struct rx_repetition_summary {
+    const struct rx_test_case *test_case;
+    rx_size run_count;
+    rx_size pass_count;
+    rx_size fail_count;
+    rx_uint64 elapsed_min;
+    rx_uint64 elapsed_median;
+    rx_uint64 elapsed_max;
+};
+
+struct rx_benchmark_config {
+    int skip;
+    struct rx_fixture fixture;
+    double min_time;
+    rx_size repetition_count;
+    rx_uint64 range_min;
+    rx_uint64 range_max;
+    rx_uint64 range_multiplier;
+    enum rx_complexity complexity_bound;
+};
+
+struct rx_benchmark {
+    const char *suite_name;
+    const char *name;
+    rx_run_fn run;
+    struct rx_benchmark_config config;
+};
+
+struct rx_benchmark_summary {
+    const struct rx_benchmark *benchmark;
+    int skipped;
+    const char *error;
+    rx_size failure_count;
+    struct rx_failure *failures;
+    rx_uint64 arg;
+    rx_uint64 iteration_count;
+    rx_size sample_count;
+    double *samples;
+    double *cpu_samples;
+    double median;
+    double mean;
+    double stddev;
+    double cpu_median;
+    double cpu_mean;
+    double cpu_stddev;
+    int unstable;
+    struct rx_metrics metrics;
+};
+
+struct rx_run_config {
+    rx_size job_count;
+    int isolate;
+    const char *timings_path;
+    int longest_first;
+    rx_size shard_index;
+    rx_size shard_count;
+    const char *shard_manifest_path;
+    double timeout;
+    int fail_fast;
+    rx_size repeat_count;
+    int until_fail;
+    int shuffle;
+    rx_uint64 shuffle_seed;
+    const char *failures_path;
+    int failed_first;
+    int only_failed;
+    int bench;
+    double bench_min_time;
+    rx_size bench_repetition_count;
+    const char *bench_save_path;
+    const char *bench_compare_path;
+    double bench_threshold;
+    int bench_stable;
+    rx_size bench_warm_up_count;
+    double bench_max_cv;
+    rx_size bench_max_repetition_count;
+    const char *bench_json_path;
+    int perf_counters;
+    const char *profile_path;
+    rx_size top_count;
+    enum rx_usage_metric top_metric;
+};
+
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -213,6 +434,34 @@ extern "C" {
 RXP_STORAGE void
 rx_abort(struct rx_context *context);
 
+RXP_STORAGE const void *
+rx_get_suite_data(const struct rx_context *context);
+
+RXP_STORAGE rx_uint64
+rx_get_benchmark_arg(const struct rx_context *context);
+
+RXP_STORAGE void
+rx_set_bytes_processed(struct rx_context *context, rx_uint64 count);
+
+RXP_STORAGE void
+rx_set_items_processed(struct rx_context *context, rx_uint64 count);
+
+RXP_STORAGE enum rx_status
+rx_set_metric(struct rx_context *context, const char *name, double value);
+
+RXP_STORAGE enum rx_status
+rx_record_latency(struct rx_context *context, const char *name, rx_uint64 ns);
+
+RXP_STORAGE rx_uint64
+rx_latency_histogram_get_percentile(
+    const struct rx_latency_histogram *histogram, double percentile);
+
+RXP_STORAGE void
+rx_pause_timing(struct rx_context *context);
+
+RXP_STORAGE void
+rx_resume_timing(struct rx_context *context);
+
 RXP_STORAGE enum rx_status
 rx_handle_test_result(struct rx_context *context,
                       int result,
@@ -232,6 +481,9 @@ rx_summary_terminate(struct rx_summary *summary);
 RXP_STORAGE void
 rx_summary_print(const struct rx_summary *summary);
 
+RXP_STORAGE void
+rx_repetition_summary_print(const struct rx_repetition_summary *summary);
+
 RXP_STORAGE void
 rx_sort_summaries_by_test_suite(struct rx_summary *summaries,
                                 rx_size summary_count);
@@ -250,9 +502,42 @@ RXP_STORAGE void
 rx_enumerate_test_cases(rx_size *test_case_count,
                         struct rx_test_case *test_cases);
 
+RXP_STORAGE enum rx_status
+rx_benchmark_summary_initialize(struct rx_benchmark_summary *summary,
+                                const struct rx_benchmark *benchmark);
+
+RXP_STORAGE void
+rx_benchmark_summary_terminate(struct rx_benchmark_summary *summary);
+
+RXP_STORAGE void
+rx_benchmark_summary_print(const struct rx_benchmark_summary *summary);
+
+RXP_STORAGE enum rx_status
+rx_benchmark_run(struct rx_benchmark_summary *summary,
+                 const struct rx_benchmark *benchmark);
+
+RXP_STORAGE void
+rx_enumerate_benchmarks(rx_size *benchmark_count,
+                        struct rx_benchmark *benchmarks);
+
+RXP_STORAGE enum rx_status
+rx_run_config_parse(struct rx_run_config *config,
+                    int argc,
+                    const char *const *argv);
+
 RXP_STORAGE enum rx_status
 rx_run(rx_size test_case_count, const struct rx_test_case *test_cases);
 
+RXP_STORAGE enum rx_status
+rx_run_with_config(const struct rx_run_config *config,
+                   rx_size test_case_count,
+                   const struct rx_test_case *test_cases);
+
+RXP_STORAGE enum rx_status
+rx_run_benchmarks(const struct rx_run_config *config,
+                  rx_size benchmark_count,
+                  const struct rx_benchmark *benchmarks);
+
 RXP_STORAGE enum rx_status
 rx_main(rx_size test_case_count,
         const struct rx_test_case *test_cases,
@@ -399,6 +684,24 @@ rx_main(rx_size test_case_count,
 #define RX_TEST_CASE_2(SUIE_ID, ID, _0, _1)                                    \
     RXP_TEST_CASE_1(SUIE_ID, ID, 2, (_0, _1))
 
+#if RXP_HAS_VARIADIC_MACROS
+#define RX_BENCHMARK(...)                                                      \
+    RXP_EXPAND(RXP_CONCAT(RXP_BENCHMARK_DISPATCH_,                             \
+                          RXP_HAS_AT_LEAST_3_ARGS(__VA_ARGS__))(__VA_ARGS__))
+
+#define RXP_BENCHMARK_DISPATCH_0(SUITE_ID, ID) RXP_BENCHMARK_0(SUITE_ID, ID)
+
+#define RXP_BENCHMARK_DISPATCH_1(SUITE_ID, ID, ...)                            \
+    RXP_BENCHMARK_1(SUITE_ID, ID, RXP_COUNT_ARGS(__VA_ARGS__), (__VA_ARGS__))
+#else
+#define RX_BENCHMARK(SUITE_ID, ID) RXP_BENCHMARK_0(SUITE_ID, ID)
+#endif
+
+#define RX_BENCHMARK_1(SUITE_ID, ID, _0) RXP_BENCHMARK_1(SUITE_ID, ID, 1, (_0))
+
+#define RX_BENCHMARK_2(SUITE_ID, ID, _0, _1)                                   \
+    RXP_BENCHMARK_1(SUITE_ID, ID, 2, (_0, _1))
+
 /* Implementation: Helpers                                         O-(''Q)
    -------------------------------------------------------------------------- */
 
@@ -422,6 +725,7 @@ rx_main(rx_size test_case_count,
 #endif
 
 #include <ctype.h>
+#include <math.h>
 #include <setjmp.h>
 #include <stdarg.h>
 #include <stddef.h>
@@ -434,6 +738,73 @@ rx_main(rx_size test_case_count,
 #define RX_ASSERT assert
 #endif
 
+/*
+   Allocation tracking replaces the allocation functions of the whole program
+   with ones forwarding to glibc's internal functions, which is why it must
+   only be enabled in a single translation unit. The sanitizers replacing
+   these functions too, both can't be combined.
+*/
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define RXP_SANITIZED_ALLOCATIONS
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(memory_sanitizer)       \
+    || __has_feature(thread_sanitizer)
+#define RXP_SANITIZED_ALLOCATIONS
+#endif
+#endif
+
+#if defined(RX_ENABLE_ALLOC_TRACKING) && defined(RXP_PLATFORM_LINUX)           \
+    && defined(__GLIBC__) && defined(__GNUC__)                                 \
+    && !defined(RXP_SANITIZED_ALLOCATIONS)
+#define RXP_ALLOC_TRACKING 1
+#else
+#define RXP_ALLOC_TRACKING 0
+#endif
+
+#if RXP_ALLOC_TRACKING
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+extern void *
+__libc_malloc(size_t size);
+
+extern void *
+__libc_calloc(size_t count, size_t size);
+
+extern void *
+__libc_realloc(void *ptr, size_t size);
+
+extern void
+__libc_free(void *ptr);
+
+extern void *
+__libc_memalign(size_t alignment, size_t size);
+
+extern void *
+__libc_valloc(size_t size);
+
+extern void *
+__libc_pvalloc(size_t size);
+
+#if defined(__cplusplus)
+}
+#endif
+
+/* Rexo's own allocations are left out of the tracking. */
+#ifndef RX_MALLOC
+#define RX_MALLOC __libc_malloc
+#endif
+
+#ifndef RX_REALLOC
+#define RX_REALLOC __libc_realloc
+#endif
+
+#ifndef RX_FREE
+#define RX_FREE __libc_free
+#endif
+#endif
+
 #ifndef RX_MALLOC
 #include <stdlib.h>
 #define RX_MALLOC malloc
@@ -459,6 +830,15 @@ rx_main(rx_size test_case_count,
 #define RXP_FILENO fileno
 #endif
 
+#if defined(RXP_PLATFORM_LINUX)
+#include <sys/syscall.h>
+#if !defined(__cplusplus) && !defined(__USE_MISC)
+/* Not declared by glibc when only the POSIX features are requested. */
+extern long
+syscall(long number, ...);
+#endif
+#endif
+
 typedef char rxp_invalid_size_type[sizeof(rx_size) == sizeof(size_t) ? 1 : -1];
 
 #define RXP_UNUSED(X) (void)(X)
@@ -541,15 +921,85 @@ typedef char rxp_invalid_size_type[sizeof(rx_size) == sizeof(size_t) ? 1 : -1];
 #define RXP_TEST_CASE_CONFIG_BLUEPRINT_GET_UPDATE_FN_ID(ID)                    \
     rxp_test_case_config_blueprint_update_fn_##ID
 
+#define RXP_BENCHMARK_DESC_GET_ID(SUITE_ID, ID)                                \
+    rxp_benchmark_desc_##SUITE_ID##_##ID
+#define RXP_BENCHMARK_DESC_PTR_GET_ID(SUITE_ID, ID)                            \
+    rxp_benchmark_desc_ptr_##SUITE_ID##_##ID
+
+#define RXP_BENCHMARK_CONFIG_DESC_GET_ID(ID) rxp_benchmark_config_desc_##ID
+#define RXP_BENCHMARK_CONFIG_BLUEPRINT_GET_UPDATE_FN_ID(ID)                    \
+    rxp_benchmark_config_blueprint_update_fn_##ID
+
 typedef intmax_t rxp_int;
 typedef uintmax_t rxp_uint;
 typedef long double rxp_real;
 
+struct rxp_timer;
+
+/*
+   Timing state of the batch of benchmark iterations being measured. The time
+   elapsed is accumulated each time that the timing is paused, the timer being
+   `NULL` outside of any measure. The CPU time of the thread is accumulated
+   alongside, for as long as it can be read.
+*/
+struct rxp_benchmark_timing {
+    const struct rxp_timer *timer;
+    uint64_t begin;
+    double elapsed;
+    uint64_t cpu_begin;
+    double cpu_elapsed;
+    int cpu_valid;
+    int paused;
+    enum rx_status status;
+};
+
+/*
+   Allocation counters of a test case. The blocks allocated while the counters
+   are current are kept in an open-addressing set, so that the blocks freed
+   without having been allocated under the tracking are left out.
+*/
+struct rxp_alloc_counters {
+    rx_uint64 allocation_count;
+    rx_uint64 free_count;
+    rx_uint64 allocated_bytes;
+    rx_uint64 live_count;
+    rx_uint64 live_bytes;
+    rx_uint64 peak_bytes;
+    void **blocks;
+    size_t block_capacity;
+    size_t block_count;
+    size_t block_tombstone_count;
+    int overflowed;
+};
+
+/*
+   Allocation counters of the running test case, as they were when the current
+   allocation scope began.
+*/
+struct rxp_alloc_scope {
+    int active;
+    struct rxp_alloc_counters begin;
+};
+
 struct rx_context {
     jmp_buf env;
     struct rx_summary *summary;
+    const void *suite_data;
+    rx_uint64 benchmark_arg;
+    struct rxp_benchmark_timing benchmark_timing;
+    struct rxp_alloc_scope alloc_scope;
 };
 
+#if !defined(__GNUC__)
+static void
+rxp_escape_impl(const volatile void *p)
+{
+    (void)p;
+}
+
+static void (*volatile rxp_escape)(const volatile void *) = rxp_escape_impl;
+#endif
+
 /* Implementation: Logger                                          O-(''Q)
    -------------------------------------------------------------------------- */
 
@@ -637,6 +1087,9 @@ struct rx_context {
 #define RXP_LOG_INFO_2(FMT, _0, _1)                                            \
     RXP_LOG(RX_LOG_LEVEL_INFO,                                                 \
             (RX_LOG_LEVEL_INFO, __FILE__, __LINE__, FMT, _0, _1))
+#define RXP_LOG_INFO_3(FMT, _0, _1, _2)                                        \
+    RXP_LOG(RX_LOG_LEVEL_INFO,                                                 \
+            (RX_LOG_LEVEL_INFO, __FILE__, __LINE__, FMT, _0, _1, _2))
 
 #define RXP_LOG_WARNING(MSG)                                                   \
     RXP_LOG(RX_LOG_LEVEL_WARNING,                                              \
@@ -957,2232 +1410,11917 @@ rxp_get_real_time(uint64_t *time)
 #endif
 }
 
-/* Implementation: Test Failure Array                              O-(''Q)
-   -------------------------------------------------------------------------- */
-
 /*
-   Simple implementation for dynamic arrays that can grow and stretch at
-   runtime. The object returned to the user is a standard pointer to a C array
-   but the implementation also allocates a header to keep track of the size
-   and the capacity.
-
-   The memory layout is better represented by the diagram below.
-
-   block     user pointer
-    /        /
-   +--------+--------+
-   | header | buffer |
-   +--------+--------+
-
-   The block points to the whole memory being allocated while the buffer
-   represents the actual array exposed to the user.
+   Retrieve the period, in nanoseconds, at which the clock read by
+   `rxp_get_real_time()` ticks.
 */
+static double
+rxp_get_real_time_resolution(void)
+{
+#if defined(RXP_PLATFORM_WINDOWS)
+    LARGE_INTEGER frequency;
 
-#define RXP_DYN_ARRAY_GET_BLOCK(BUF)                                           \
-    ((void *)&((struct rxp_dyn_array_header *)(BUF))[-1])
-#define RXP_DYN_ARRAY_GET_HEADER(BLOCK) ((struct rxp_dyn_array_header *)(BLOCK))
-#define RXP_DYN_ARRAY_GET_BUFFER(BLOCK)                                        \
-    ((void *)&((struct rxp_dyn_array_header *)(BLOCK))[1])
-#define RXP_DYN_ARRAY_GET_CONST_BLOCK(BUF)                                     \
-    ((const void *)&((const struct rxp_dyn_array_header *)(BUF))[-1])
-#define RXP_DYN_ARRAY_GET_CONST_HEADER(BLOCK)                                  \
-    ((const struct rxp_dyn_array_header *)(BLOCK))
-
-struct rxp_dyn_array_header {
-    size_t size;
-    size_t capacity;
-};
+    if (!QueryPerformanceFrequency(&frequency) || frequency.QuadPart <= 0) {
+        return 1.0;
+    }
 
-static const size_t rxp_test_failure_array_max_capacity
-    = (((size_t)-1 - sizeof(struct rxp_dyn_array_header))
-       / sizeof(struct rx_failure));
+    return (double)RXP_TICKS_PER_SECOND / (double)frequency.QuadPart;
+#elif defined(RXP_PLATFORM_DARWIN)
+    mach_timebase_info_data_t info;
 
-static void
-rxp_dyn_array_get_new_capacity(size_t *capacity,
-                               size_t current,
-                               size_t requested,
-                               size_t max)
-{
-    *capacity = current + current / 2 + 1;
-    if (*capacity < current) {
-        *capacity = max;
-        return;
+    if (mach_timebase_info(&info) != KERN_SUCCESS || info.denom == 0) {
+        return 1.0;
     }
 
-    if (*capacity < requested) {
-        *capacity = requested;
+    return (double)info.numer / (double)info.denom;
+#elif defined(RXP_PLATFORM_UNIX) && defined(RXP_USE_CLOCK_GETTIME)
+    struct timespec t;
+
+    if (clock_getres(RXP_CLOCK_ID, &t) != 0
+        || (t.tv_sec == 0 && t.tv_nsec == 0)) {
+        return 1.0;
     }
+
+    return (double)t.tv_sec * (double)RXP_TICKS_PER_SECOND
+           + (double)t.tv_nsec;
+#elif defined(RXP_PLATFORM_UNIX)
+    return (double)RXP_TICKS_PER_MICROSECOND;
+#else
+    return 1.0;
+#endif
 }
 
 static enum rx_status
-rxp_dyn_array_ensure_has_enough_capacity(void **block,
-                                         size_t current_capacity,
-                                         size_t requested_capacity,
-                                         size_t max_capacity,
-                                         size_t element_size)
+rxp_get_thread_cpu_time(uint64_t *time)
 {
-    void *buf;
-    size_t new_capacity;
-
-    RX_ASSERT(block != NULL);
-    RX_ASSERT(element_size > 0);
+    RX_ASSERT(time != NULL);
 
-    if (requested_capacity > max_capacity) {
-        RXP_LOG_DEBUG("the requested capacity is too large\n");
-        return RX_ERROR_MAX_SIZE_EXCEEDED;
-    }
+#if defined(RXP_PLATFORM_WINDOWS)
+    {
+        FILETIME creation_time;
+        FILETIME exit_time;
+        FILETIME kernel_time;
+        FILETIME user_time;
+
+        if (!GetThreadTimes(GetCurrentThread(),
+                            &creation_time,
+                            &exit_time,
+                            &kernel_time,
+                            &user_time)) {
+            RXP_LOG_DEBUG("failed to retrieve the thread's CPU time\n");
+            return RX_ERROR;
+        }
 
-    if (*block != NULL && current_capacity >= requested_capacity) {
+        /* The file times are expressed in units of 100 nanoseconds. */
+        *time = ((((uint64_t)kernel_time.dwHighDateTime << 32)
+                  | kernel_time.dwLowDateTime)
+                 + (((uint64_t)user_time.dwHighDateTime << 32)
+                    | user_time.dwLowDateTime))
+                * 100;
         return RX_SUCCESS;
     }
+#elif defined(RXP_USE_CLOCK_GETTIME) && defined(CLOCK_THREAD_CPUTIME_ID)
+    {
+        struct timespec t;
 
-    rxp_dyn_array_get_new_capacity(
-        &new_capacity, current_capacity, requested_capacity, max_capacity);
-    RX_ASSERT(new_capacity >= requested_capacity);
-    RX_ASSERT(new_capacity <= max_capacity);
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t) != 0) {
+            RXP_LOG_DEBUG("failed to retrieve the thread's CPU time\n");
+            return RX_ERROR;
+        }
 
-    buf = RX_REALLOC(
-        *block,
-        sizeof(struct rxp_dyn_array_header) + element_size * new_capacity);
-    if (buf == NULL) {
-        RXP_LOG_DEBUG("failed to reallocate the block\n");
-        return RX_ERROR_ALLOCATION;
+        *time = (uint64_t)t.tv_sec * RXP_TICKS_PER_SECOND + (uint64_t)t.tv_nsec;
+        return RX_SUCCESS;
     }
-
-    RXP_DYN_ARRAY_GET_HEADER(buf)->capacity = new_capacity;
-    *block = buf;
-    return RX_SUCCESS;
+#else
+    RXP_LOG_DEBUG("thread CPU time not supported\n");
+    return RX_ERROR;
+#endif
 }
 
-static enum rx_status
-rxp_test_failure_array_create(struct rx_failure **array, size_t size)
-{
-    void *block;
-    size_t capacity;
+/*
+   Benchmarks read the time-stamp counter of x86 CPUs advertising it as
+   invariant, that is ticking at a constant rate regardless of the frequency
+   scaling and of the sleep states, since it is cheaper to read than going
+   through the operating system. Its frequency is calibrated against the real
+   time, with the timer falling back to the real time when the counter isn't
+   usable.
+*/
 
-    RX_ASSERT(array != NULL);
+#if !defined(RX_DISABLE_TSC_TIMER)                                             \
+    && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64)          \
+        || defined(_M_IX86))
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define RXP_TSC_TIMER 1
+#elif defined(__GNUC__)
+#include <cpuid.h>
+#define RXP_TSC_TIMER 1
+#endif
+#endif
 
-    rxp_dyn_array_get_new_capacity(
-        &capacity, 0, size, rxp_test_failure_array_max_capacity);
-    RX_ASSERT(capacity >= size);
-    RX_ASSERT(capacity <= rxp_test_failure_array_max_capacity);
+#if !defined(RXP_TSC_TIMER)
+#define RXP_TSC_TIMER 0
+#endif
 
-    block = RX_MALLOC(sizeof(struct rxp_dyn_array_header)
-                      + sizeof(struct rx_failure) * capacity);
-    if (block == NULL) {
-        RXP_LOG_DEBUG_1("failed to reserve a large enough capacity for "
-                        "the test failure array (requested capacity: %lu)\n",
-                        (unsigned long)size);
-        return RX_ERROR_ALLOCATION;
+#define RXP_TIMER_CALIBRATION_TIME 10000000ul
+#define RXP_TIMER_SAMPLE_COUNT 1000
+
+#if RXP_TSC_TIMER
+static int
+rxp_tsc_is_invariant(void)
+{
+#if defined(_MSC_VER)
+    int registers[4];
+
+    __cpuid(registers, (int)0x80000000u);
+    if ((unsigned int)registers[0] < 0x80000007u) {
+        return 0;
     }
 
-    RXP_DYN_ARRAY_GET_HEADER(block)->size = size;
-    RXP_DYN_ARRAY_GET_HEADER(block)->capacity = capacity;
-    *array = (struct rx_failure *)RXP_DYN_ARRAY_GET_BUFFER(block);
-    return RX_SUCCESS;
+    __cpuid(registers, (int)0x80000007u);
+    return (registers[3] & (1 << 8)) != 0;
+#else
+    unsigned int eax;
+    unsigned int ebx;
+    unsigned int ecx;
+    unsigned int edx;
+
+    if (__get_cpuid_max(0x80000000u, NULL) < 0x80000007u
+        || !__get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx)) {
+        return 0;
+    }
+
+    return (edx & (1u << 8)) != 0;
+#endif
 }
 
-static void
-rxp_test_failure_array_destroy(struct rx_failure *array)
+/* Some hypervisors hide the `rdtscp` instruction, which then faults. */
+static int
+rxp_tsc_has_rdtscp(void)
 {
-    RX_FREE(RXP_DYN_ARRAY_GET_BLOCK(array));
+#if defined(_MSC_VER)
+    int registers[4];
+
+    __cpuid(registers, (int)0x80000000u);
+    if ((unsigned int)registers[0] < 0x80000001u) {
+        return 0;
+    }
+
+    __cpuid(registers, (int)0x80000001u);
+    return (registers[3] & (1 << 27)) != 0;
+#else
+    unsigned int eax;
+    unsigned int ebx;
+    unsigned int ecx;
+    unsigned int edx;
+
+    if (__get_cpuid_max(0x80000000u, NULL) < 0x80000001u
+        || !__get_cpuid(0x80000001u, &eax, &ebx, &ecx, &edx)) {
+        return 0;
+    }
+
+    return (edx & (1u << 27)) != 0;
+#endif
 }
 
-static void
-rxp_test_failure_array_get_size(size_t *size, const struct rx_failure *array)
+/*
+   The fences prevent the reads of the counter from being reordered with
+   the instructions being measured. Without `rdtscp`, the end of a span is
+   read in the same way as its beginning.
+*/
+static uint64_t
+rxp_tsc_read_begin(void)
 {
-    RX_ASSERT(array != NULL);
-
-    *size = RXP_DYN_ARRAY_GET_CONST_HEADER(RXP_DYN_ARRAY_GET_CONST_BLOCK(array))
-                ->size;
+#if defined(_MSC_VER)
+    _mm_lfence();
+    return (uint64_t)__rdtsc();
+#else
+    rx_uint32 low;
+    rx_uint32 high;
+
+    __asm__ __volatile__("lfence\n\trdtsc"
+                         : "=a"(low), "=d"(high)
+                         :
+                         : "memory");
+    return ((uint64_t)high << 32) | low;
+#endif
 }
 
-static enum rx_status
-rxp_test_failure_array_extend_back(struct rx_failure **slice,
-                                   struct rx_failure **array,
-                                   size_t size)
+static uint64_t
+rxp_tsc_read_end(int rdtscp)
 {
-    enum rx_status status;
-    void *block;
-    size_t pos;
+#if defined(_MSC_VER)
+    unsigned int aux;
+    uint64_t out;
 
-    RX_ASSERT(array != NULL);
-    RX_ASSERT(*array != NULL);
+    if (!rdtscp) {
+        return rxp_tsc_read_begin();
+    }
 
-    block = RXP_DYN_ARRAY_GET_BLOCK(*array);
-    status = rxp_dyn_array_ensure_has_enough_capacity(
-        &block,
-        RXP_DYN_ARRAY_GET_HEADER(block)->capacity,
-        RXP_DYN_ARRAY_GET_HEADER(block)->size + size,
-        rxp_test_failure_array_max_capacity,
-        sizeof(struct rx_failure));
-    if (status != RX_SUCCESS) {
-        RXP_LOG_DEBUG_1(
-            "failed to reserve a large enough capacity for "
-            "the test failure array (requested capacity: %lu)\n",
-            (unsigned long)RXP_DYN_ARRAY_GET_HEADER(block)->size + size);
-        return status;
+    out = (uint64_t)__rdtscp(&aux);
+    _mm_lfence();
+    return out;
+#else
+    rx_uint32 low;
+    rx_uint32 high;
+    rx_uint32 aux;
+
+    if (!rdtscp) {
+        return rxp_tsc_read_begin();
     }
 
-    RX_ASSERT(block != NULL);
+    __asm__ __volatile__("rdtscp\n\tlfence"
+                         : "=a"(low), "=d"(high), "=c"(aux)
+                         :
+                         : "memory");
+    return ((uint64_t)high << 32) | low;
+#endif
+}
+#endif
 
-    *array = (struct rx_failure *)RXP_DYN_ARRAY_GET_BUFFER(block);
+struct rxp_timer {
+    int tsc;
+    int rdtscp;
+    double ns_per_tick;
+    double overhead;
+    double resolution;
+    double cpu_overhead;
+};
 
-    pos = RXP_DYN_ARRAY_GET_HEADER(block)->size;
-    memmove(&(*array)[pos + size],
-            &(*array)[pos],
-            sizeof(struct rx_failure)
-                * (RXP_DYN_ARRAY_GET_HEADER(block)->size - pos));
+static enum rx_status
+rxp_timer_read_begin(uint64_t *ticks, const struct rxp_timer *timer)
+{
+    RX_ASSERT(ticks != NULL);
+    RX_ASSERT(timer != NULL);
 
-    if (slice != NULL) {
-        *slice = &(*array)[pos];
+#if RXP_TSC_TIMER
+    if (timer->tsc) {
+        *ticks = rxp_tsc_read_begin();
+        return RX_SUCCESS;
     }
+#endif
 
-    RXP_DYN_ARRAY_GET_HEADER(block)->size += size;
-    return RX_SUCCESS;
+    return rxp_get_real_time(ticks);
 }
 
-/* Implementation: Memory Sections                                 O-(''Q)
-   -------------------------------------------------------------------------- */
+static enum rx_status
+rxp_timer_read_end(uint64_t *ticks, const struct rxp_timer *timer)
+{
+    RX_ASSERT(ticks != NULL);
+    RX_ASSERT(timer != NULL);
 
-/*
-   Compiler-specific code that allows grouping objects into specific
-   data sections, thus enabling automatic discovery by iterating over
-   anything registered in these sections.
-*/
+#if RXP_TSC_TIMER
+    if (timer->tsc) {
+        *ticks = rxp_tsc_read_end(timer->rdtscp);
+        return RX_SUCCESS;
+    }
+#endif
+
+    return rxp_get_real_time(ticks);
+}
 
-#if defined(__clang__)
 /*
-   Older versions of Clang's address sanitizer incorrectly report
-   a global buffer overflow in custom data sections.
+   Convert the ticks elapsed between two reads into nanoseconds, after taking
+   out the time spent reading the timer itself.
 */
-#define RXP_SECTION_SUPPRESS_ADDRESS_SANITIZER                                 \
-    __attribute__((no_sanitize_address))
-#else
-#define RXP_SECTION_SUPPRESS_ADDRESS_SANITIZER
-#endif
+static double
+rxp_timer_get_elapsed(const struct rxp_timer *timer,
+                      uint64_t begin,
+                      uint64_t end)
+{
+    double elapsed;
 
-#if !defined(RX_DISABLE_TEST_DISCOVERY)                                        \
-    && (defined(_MSC_VER) || defined(__GNUC__) || defined(__MINGW64__))
-#define RXP_TEST_DISCOVERY 1
-#else
-#define RXP_TEST_DISCOVERY 0
-#endif
+    RX_ASSERT(timer != NULL);
 
-#if !RXP_TEST_DISCOVERY
-#define RXP_TEST_SUITE_REGISTER(NAME) RXP_REQUIRE_SEMICOLON
-#elif defined(_MSC_VER)
-__pragma(section("rxsuite$a", read)) __pragma(section("rxsuite$b", read))
-    __pragma(section("rxsuite$c", read))
+    if (end <= begin) {
+        return 0.0;
+    }
 
-        __declspec(allocate("rxsuite$a")) RXP_STORAGE const
-    struct rxp_test_suite_desc *const rxp_test_suite_section_begin
-    = NULL;
+    elapsed = (double)(end - begin) * timer->ns_per_tick - timer->overhead;
+    return elapsed > 0.0 ? elapsed : 0.0;
+}
 
-__declspec(allocate("rxsuite$c")) RXP_STORAGE const struct rxp_test_suite_desc
-    *const rxp_test_suite_section_end
-    = NULL;
+#if RXP_TSC_TIMER
+static enum rx_status
+rxp_timer_calibrate_tsc(double *ns_per_tick, int rdtscp)
+{
+    uint64_t time_begin;
+    uint64_t time_end;
+    uint64_t ticks_begin;
+    uint64_t ticks_end;
 
-#define RXP_TEST_SUITE_REGISTER(NAME)                                          \
-    __declspec(allocate(                                                       \
-        "rxsuite$b")) RXP_STORAGE const struct rxp_test_suite_desc *const      \
-    RXP_TEST_SUITE_DESC_PTR_GET_ID(NAME)                                       \
-        = &RXP_TEST_SUITE_DESC_GET_ID(NAME)
+    RX_ASSERT(ns_per_tick != NULL);
 
-#define RXP_TEST_SUITE_SECTION_BEGIN (&rxp_test_suite_section_begin + 1)
-#define RXP_TEST_SUITE_SECTION_END (&rxp_test_suite_section_end)
-#elif defined(__GNUC__) || defined(__MINGW64__)
-#if defined(RXP_PLATFORM_DARWIN)
-extern const struct rxp_test_suite_desc *const
-    __start_rxsuite __asm("section$start$__DATA$rxsuite");
-extern const struct rxp_test_suite_desc *const
-    __stop_rxsuite __asm("section$end$__DATA$rxsuite");
+    if (rxp_get_real_time(&time_begin) != RX_SUCCESS) {
+        return RX_ERROR;
+    }
 
-#define RXP_TEST_SUITE_SECTION                                                 \
-    RXP_SECTION_SUPPRESS_ADDRESS_SANITIZER                                     \
-    __attribute__((used, section("__DATA,rxsuite")))
-#else
-extern const struct rxp_test_suite_desc *const __start_rxsuite;
-extern const struct rxp_test_suite_desc *const __stop_rxsuite;
+    ticks_begin = rxp_tsc_read_begin();
 
-#define RXP_TEST_SUITE_SECTION                                                 \
-    RXP_SECTION_SUPPRESS_ADDRESS_SANITIZER                                     \
-    __attribute__((used, section("rxsuite")))
-#endif
+    do {
+        if (rxp_get_real_time(&time_end) != RX_SUCCESS) {
+            return RX_ERROR;
+        }
+    } while (time_end - time_begin < RXP_TIMER_CALIBRATION_TIME);
 
-RXP_TEST_SUITE_SECTION
-static const struct rxp_test_suite_desc *const rxp_dummy_suite = NULL;
+    ticks_end = rxp_tsc_read_end(rdtscp);
 
-#define RXP_TEST_SUITE_REGISTER(NAME)                                          \
-    RXP_TEST_SUITE_SECTION                                                     \
-    const struct rxp_test_suite_desc *const RXP_TEST_SUITE_DESC_PTR_GET_ID(    \
-        NAME)                                                                  \
-        = &RXP_TEST_SUITE_DESC_GET_ID(NAME)
+    if (ticks_end <= ticks_begin) {
+        RXP_LOG_DEBUG("the time-stamp counter isn't monotonic\n");
+        return RX_ERROR;
+    }
 
-#define RXP_TEST_SUITE_SECTION_BEGIN (&__start_rxsuite)
-#define RXP_TEST_SUITE_SECTION_END (&__stop_rxsuite)
+    *ns_per_tick = (double)(time_end - time_begin)
+                   / (double)(ticks_end - ticks_begin);
+
+    /* Reject the frequencies that can't be right, outside 10 MHz-100 GHz. */
+    if (*ns_per_tick < 0.01 || *ns_per_tick > 100.0) {
+        RXP_LOG_DEBUG("implausible time-stamp counter frequency\n");
+        return RX_ERROR;
+    }
+
+    return RX_SUCCESS;
+}
 #endif
 
-#if !RXP_TEST_DISCOVERY
-#define RXP_TEST_CASE_REGISTER(SUITE_NAME, NAME) RXP_REQUIRE_SEMICOLON
-#elif defined(_MSC_VER)
-__pragma(section("rxcase$a", read)) __pragma(section("rxcase$b", read))
-    __pragma(section("rxcase$c", read))
+static enum rx_status
+rxp_timer_initialize(struct rxp_timer *timer)
+{
+    size_t i;
+    double elapsed;
+
+    RX_ASSERT(timer != NULL);
+
+    timer->tsc = 0;
+    timer->rdtscp = 0;
+    timer->ns_per_tick = 1.0;
+    timer->overhead = 0.0;
+    timer->resolution = 0.0;
+    timer->cpu_overhead = 0.0;
+
+#if RXP_TSC_TIMER
+    if (rxp_tsc_is_invariant()) {
+        timer->rdtscp = rxp_tsc_has_rdtscp();
+        if (rxp_timer_calibrate_tsc(&timer->ns_per_tick, timer->rdtscp)
+            == RX_SUCCESS) {
+            timer->tsc = 1;
+        }
+    }
 
-        __declspec(allocate("rxcase$a")) RXP_STORAGE const
-    struct rxp_test_case_desc *const rxp_test_case_section_begin
-    = NULL;
+    if (!timer->tsc) {
+        RXP_LOG_DEBUG("falling back to the real time for the benchmarks\n");
+        timer->ns_per_tick = 1.0;
+    }
+#endif
 
-__declspec(allocate("rxcase$c")) RXP_STORAGE const struct rxp_test_case_desc
-    *const rxp_test_case_section_end
-    = NULL;
+    /* The resolution is the period at which the timer ticks, while
+       the overhead is the shortest duration measured between two reads. */
+    timer->resolution = timer->tsc ? timer->ns_per_tick
+                                   : rxp_get_real_time_resolution();
+    timer->overhead = -1.0;
+    for (i = 0; i < RXP_TIMER_SAMPLE_COUNT; ++i) {
+        uint64_t begin;
+        uint64_t end;
+
+        if (rxp_timer_read_begin(&begin, timer) != RX_SUCCESS
+            || rxp_timer_read_end(&end, timer) != RX_SUCCESS) {
+            return RX_ERROR;
+        }
 
-#define RXP_TEST_CASE_REGISTER(SUITE_NAME, NAME)                               \
-    __declspec(allocate(                                                       \
-        "rxcase$b")) RXP_STORAGE const struct rxp_test_case_desc *const        \
-    RXP_TEST_CASE_DESC_PTR_GET_ID(SUITE_NAME, NAME)                            \
-        = &RXP_TEST_CASE_DESC_GET_ID(SUITE_NAME, NAME)
+        elapsed = end > begin ? (double)(end - begin) * timer->ns_per_tick
+                              : 0.0;
+        if (timer->overhead < 0.0 || elapsed < timer->overhead) {
+            timer->overhead = elapsed;
+        }
+    }
 
-#define RXP_TEST_CASE_SECTION_BEGIN (&rxp_test_case_section_begin + 1)
-#define RXP_TEST_CASE_SECTION_END (&rxp_test_case_section_end)
-#elif defined(__GNUC__) || defined(__MINGW64__)
-#if defined(RXP_PLATFORM_DARWIN)
-extern const struct rxp_test_case_desc *const
-    __start_rxcase __asm("section$start$__DATA$rxcase");
-extern const struct rxp_test_case_desc *const
-    __stop_rxcase __asm("section$end$__DATA$rxcase");
+    /* Same for the thread's CPU time, which is left without any overhead
+       if it can't be read. */
+    timer->cpu_overhead = -1.0;
+    for (i = 0; i < RXP_TIMER_SAMPLE_COUNT; ++i) {
+        uint64_t begin;
+        uint64_t end;
 
-#define RXP_TEST_CASE_SECTION                                                  \
-    RXP_SECTION_SUPPRESS_ADDRESS_SANITIZER                                     \
-    __attribute__((used, section("__DATA,rxcase")))
-#else
-extern const struct rxp_test_case_desc *const __start_rxcase;
-extern const struct rxp_test_case_desc *const __stop_rxcase;
+        if (rxp_get_thread_cpu_time(&begin) != RX_SUCCESS
+            || rxp_get_thread_cpu_time(&end) != RX_SUCCESS) {
+            timer->cpu_overhead = 0.0;
+            break;
+        }
 
-#define RXP_TEST_CASE_SECTION                                                  \
-    RXP_SECTION_SUPPRESS_ADDRESS_SANITIZER                                     \
-    __attribute__((used, section("rxcase")))
-#endif
+        elapsed = end > begin ? (double)(end - begin) : 0.0;
+        if (timer->cpu_overhead < 0.0 || elapsed < timer->cpu_overhead) {
+            timer->cpu_overhead = elapsed;
+        }
+    }
 
-RXP_TEST_CASE_SECTION
-static const struct rxp_test_case_desc *const rxp_dummy_case = NULL;
+    return RX_SUCCESS;
+}
 
-#define RXP_TEST_CASE_REGISTER(SUITE_NAME, NAME)                               \
-    RXP_TEST_CASE_SECTION                                                      \
-    const struct rxp_test_case_desc *const RXP_TEST_CASE_DESC_PTR_GET_ID(      \
-        SUITE_NAME, NAME)                                                      \
-        = &RXP_TEST_CASE_DESC_GET_ID(SUITE_NAME, NAME)
+/*
+   Each phase of a test case is timed both with the wall clock and with
+   the CPU time of the running thread, the difference between the two being
+   the time spent blocked or preempted.
+*/
 
-#define RXP_TEST_CASE_SECTION_BEGIN (&__start_rxcase)
-#define RXP_TEST_CASE_SECTION_END (&__stop_rxcase)
-#endif
+struct rxp_phase_clock {
+    int wall_valid;
+    int cpu_valid;
+    uint64_t wall;
+    uint64_t cpu;
+};
 
-/* Implementation: Fixture                                         O-(''Q)
+/*
+   The CPU time is read within the wall-clock span so that the cost of reading
+   it only counts towards the wall-clock time, which lets a CPU time lower than
+   the wall-clock time reveal the time spent blocked.
+*/
+static void
+rxp_phase_clock_begin(struct rxp_phase_clock *clock)
+{
+    RX_ASSERT(clock != NULL);
+
+    clock->wall_valid = rxp_get_real_time(&clock->wall) == RX_SUCCESS;
+    clock->cpu_valid = rxp_get_thread_cpu_time(&clock->cpu) == RX_SUCCESS;
+}
+
+static void
+rxp_phase_clock_end(rx_uint64 *wall,
+                    rx_uint64 *cpu,
+                    int *wall_valid,
+                    int *cpu_valid,
+                    const struct rxp_phase_clock *clock)
+{
+    uint64_t cpu_time;
+    uint64_t wall_time;
+
+    RX_ASSERT(wall != NULL);
+    RX_ASSERT(cpu != NULL);
+    RX_ASSERT(wall_valid != NULL);
+    RX_ASSERT(cpu_valid != NULL);
+    RX_ASSERT(clock != NULL);
+
+    *cpu_valid = clock->cpu_valid
+                 && rxp_get_thread_cpu_time(&cpu_time) == RX_SUCCESS
+                 && cpu_time >= clock->cpu;
+    *wall_valid = clock->wall_valid
+                  && rxp_get_real_time(&wall_time) == RX_SUCCESS
+                  && wall_time >= clock->wall;
+
+    *cpu = *cpu_valid ? (rx_uint64)(cpu_time - clock->cpu) : 0;
+    *wall = *wall_valid ? (rx_uint64)(wall_time - clock->wall) : 0;
+}
+
+/* Implementation: Performance Counters                           O-(''Q)
    -------------------------------------------------------------------------- */
 
-typedef void (*rxp_fixture_config_update_fn)(struct rx_fixture_config *);
+/*
+   Hardware counters are read through a Linux perf event group, so that all
+   the events are enabled, disabled, and read at once. Each group only counts
+   the user-space events of the thread that opened it.
+*/
 
-struct rxp_fixture_desc {
-    rx_size size;
-    const rxp_fixture_config_update_fn update;
+#if !defined(RX_DISABLE_PERF_COUNTERS) && defined(RXP_PLATFORM_LINUX)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#if defined(__NR_perf_event_open)
+#define RXP_PERF_COUNTERS 1
+#endif
+#endif
+
+#if !defined(RXP_PERF_COUNTERS)
+#define RXP_PERF_COUNTERS 0
+#endif
+
+#define RXP_PERF_EVENT_COUNT 4
+
+#if RXP_PERF_COUNTERS
+struct rxp_perf_group {
+    int fds[RXP_PERF_EVENT_COUNT];
 };
 
-#define RXP_FIXTURE_(ID, SIZE, UPDATE_FN)                                      \
-    static const struct rxp_fixture_desc RXP_FIXTURE_DESC_GET_ID(ID)           \
-        = {SIZE, UPDATE_FN};                                                   \
-                                                                               \
-    static const struct rxp_fixture_desc *ID = &RXP_FIXTURE_DESC_GET_ID(ID);
+static enum rx_status
+rxp_perf_group_open(struct rxp_perf_group *group)
+{
+    static const rx_uint64 configs[RXP_PERF_EVENT_COUNT]
+        = {PERF_COUNT_HW_CPU_CYCLES,
+           PERF_COUNT_HW_INSTRUCTIONS,
+           PERF_COUNT_HW_CACHE_MISSES,
+           PERF_COUNT_HW_BRANCH_MISSES};
+    size_t i;
 
-#define RXP_FIXTURE_0(ID, SIZE) RXP_FIXTURE_(ID, SIZE, NULL)
+    RX_ASSERT(group != NULL);
+
+    for (i = 0; i < RXP_PERF_EVENT_COUNT; ++i) {
+        struct perf_event_attr attr;
+
+        memset(&attr, 0, sizeof attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof attr;
+        attr.config = configs[i];
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+                           | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.disabled = i == 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        group->fds[i] = (int)syscall(
+            __NR_perf_event_open, &attr, 0, -1, i == 0 ? -1 : group->fds[0], 0);
+        if (group->fds[i] < 0) {
+            RXP_LOG_DEBUG("failed to open a performance counter\n");
+            while (i-- > 0) {
+                close(group->fds[i]);
+            }
 
-#define RXP_FIXTURE_1(ID, SIZE, ARG_COUNT, ARGS)                               \
-    RXP_STRUCT_DEFINE_UPDATE_FN(RXP_FIXTURE_GET_UPDATE_FN_ID(ID),              \
-                                struct rx_fixture_config,                      \
-                                ARG_COUNT,                                     \
-                                ARGS)                                          \
-                                                                               \
-    RXP_FIXTURE_(ID, SIZE, &RXP_FIXTURE_GET_UPDATE_FN_ID(ID))
+            return RX_ERROR;
+        }
+    }
 
-/* Implementation: Test Case Config                                O-(''Q)
-   -------------------------------------------------------------------------- */
+    return RX_SUCCESS;
+}
 
-struct rxp_test_case_config_blueprint {
-    int skip;
-    const struct rxp_fixture_desc *fixture;
-};
+static void
+rxp_perf_group_close(struct rxp_perf_group *group)
+{
+    size_t i;
 
-typedef void (*rxp_test_case_config_blueprint_update_fn)(
-    struct rxp_test_case_config_blueprint *);
+    RX_ASSERT(group != NULL);
 
-struct rxp_test_case_config_desc {
-    const rxp_test_case_config_blueprint_update_fn update;
-};
+    for (i = 0; i < RXP_PERF_EVENT_COUNT; ++i) {
+        close(group->fds[i]);
+    }
+}
 
-#define RXP_TEST_CASE_CONFIG(ID, ARG_COUNT, ARGS)                              \
-    RXP_STRUCT_DEFINE_UPDATE_FN(                                               \
-        RXP_TEST_CASE_CONFIG_BLUEPRINT_GET_UPDATE_FN_ID(ID),                   \
-        struct rxp_test_case_config_blueprint,                                 \
-        ARG_COUNT,                                                             \
-        ARGS)                                                                  \
-                                                                               \
-    static const struct rxp_test_case_config_desc                              \
-        RXP_TEST_CASE_CONFIG_DESC_GET_ID(ID)                                   \
-        = {RXP_TEST_CASE_CONFIG_BLUEPRINT_GET_UPDATE_FN_ID(ID)};
+static enum rx_status
+rxp_perf_group_start(struct rxp_perf_group *group)
+{
+    RX_ASSERT(group != NULL);
 
-/* Implementation: Test Suite                                      O-(''Q)
-   -------------------------------------------------------------------------- */
+    if (ioctl(group->fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP) != 0
+        || ioctl(group->fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP)
+               != 0) {
+        RXP_LOG_DEBUG("failed to start the performance counters\n");
+        return RX_ERROR;
+    }
 
-struct rxp_test_suite_desc {
-    const char *name;
-    const struct rxp_test_case_config_desc *config_desc;
-};
+    return RX_SUCCESS;
+}
 
-#define RXP_TEST_SUITE_(ID, CONFIG_DESC)                                       \
-    RXP_MAYBE_UNUSED static const struct rxp_test_suite_desc                   \
-        RXP_TEST_SUITE_DESC_GET_ID(ID)                                         \
-        = {#ID, CONFIG_DESC};                                                  \
-                                                                               \
-    RXP_TEST_SUITE_REGISTER(ID)
+static enum rx_status
+rxp_perf_group_stop(struct rx_perf_counters *counters,
+                    struct rxp_perf_group *group)
+{
+    rx_uint64 values[3 + RXP_PERF_EVENT_COUNT];
+    double scale;
 
-#define RXP_TEST_SUITE_0(ID) RXP_TEST_SUITE_(ID, NULL);
+    RX_ASSERT(counters != NULL);
+    RX_ASSERT(group != NULL);
 
-#define RXP_TEST_SUITE_1(ID, ARG_COUNT, ARGS)                                  \
-    RXP_TEST_CASE_CONFIG(ID, ARG_COUNT, ARGS)                                  \
-    RXP_TEST_SUITE_(ID, &RXP_TEST_CASE_CONFIG_DESC_GET_ID(ID));
+    if (ioctl(group->fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP) != 0
+        || read(group->fds[0], values, sizeof values)
+               != (ssize_t)sizeof values
+        || values[0] != RXP_PERF_EVENT_COUNT) {
+        RXP_LOG_DEBUG("failed to read the performance counters\n");
+        return RX_ERROR;
+    }
 
-/* Implementation: Test Case                                       O-(''Q)
-   -------------------------------------------------------------------------- */
+    /* Extrapolate the counts if the events had to be multiplexed. */
+    scale = values[2] > 0 && values[2] < values[1]
+                ? (double)values[1] / (double)values[2]
+                : 1.0;
 
-struct rxp_test_case_desc {
-    const char *suite_name;
-    const char *name;
-    rx_run_fn run;
-    const struct rxp_test_case_config_desc *config_desc;
+    counters->available = values[2] > 0;
+    counters->cycles = (rx_uint64)((double)values[3] * scale);
+    counters->instructions = (rx_uint64)((double)values[4] * scale);
+    counters->cache_misses = (rx_uint64)((double)values[5] * scale);
+    counters->branch_misses = (rx_uint64)((double)values[6] * scale);
+    return RX_SUCCESS;
+}
+#else
+struct rxp_perf_group {
+    int unused;
 };
 
-#define RXP_TEST_CASE_(SUITE_ID, ID, CONFIG_DESC)                              \
-    static void SUITE_ID##_##ID(RXP_DEFINE_PARAMS(void));                      \
-                                                                               \
-    RXP_MAYBE_UNUSED static const struct rxp_test_case_desc                    \
-        RXP_TEST_CASE_DESC_GET_ID(SUITE_ID, ID)                                \
-        = {#SUITE_ID, #ID, SUITE_ID##_##ID, CONFIG_DESC};                      \
-                                                                               \
-    RXP_TEST_CASE_REGISTER(SUITE_ID, ID);                                      \
-                                                                               \
-    static void SUITE_ID##_##ID(RXP_DEFINE_PARAMS(void))
+static enum rx_status
+rxp_perf_group_open(struct rxp_perf_group *group)
+{
+    RX_ASSERT(group != NULL);
 
-#define RXP_TEST_CASE_0(SUITE_ID, ID) RXP_TEST_CASE_(SUITE_ID, ID, NULL)
+    RXP_UNUSED(group);
+    RXP_LOG_DEBUG("performance counters not supported\n");
+    return RX_ERROR;
+}
 
-#define RXP_TEST_CASE_1(SUITE_ID, ID, ARG_COUNT, ARGS)                         \
-    RXP_TEST_CASE_CONFIG(SUITE_ID##_##ID, ARG_COUNT, ARGS)                     \
-    RXP_TEST_CASE_(                                                            \
-        SUITE_ID, ID, &RXP_TEST_CASE_CONFIG_DESC_GET_ID(SUITE_ID##_##ID))
+static void
+rxp_perf_group_close(struct rxp_perf_group *group)
+{
+    RX_ASSERT(group != NULL);
 
-/* Implementation: Operators                                       O-(''Q)
+    RXP_UNUSED(group);
+}
+
+static enum rx_status
+rxp_perf_group_start(struct rxp_perf_group *group)
+{
+    RX_ASSERT(group != NULL);
+
+    RXP_UNUSED(group);
+    return RX_ERROR;
+}
+
+static enum rx_status
+rxp_perf_group_stop(struct rx_perf_counters *counters,
+                    struct rxp_perf_group *group)
+{
+    RX_ASSERT(counters != NULL);
+    RX_ASSERT(group != NULL);
+
+    RXP_UNUSED(counters);
+    RXP_UNUSED(group);
+    return RX_ERROR;
+}
+#endif
+
+/*
+   Check whether the performance counters can be used at all, since they might
+   be restricted by the `perf_event_paranoid` setting or unsupported by
+   the hypervisor.
+*/
+static int
+rxp_perf_counters_are_available(void)
+{
+    struct rxp_perf_group group;
+
+    if (rxp_perf_group_open(&group) != RX_SUCCESS) {
+        return 0;
+    }
+
+    rxp_perf_group_close(&group);
+    return 1;
+}
+
+/* Implementation: Resource Usage                                 O-(''Q)
    -------------------------------------------------------------------------- */
 
-enum rxp_op {
-    RXP_OP_EQUAL = 0,
-    RXP_OP_NOT_EQUAL = 1,
-    RXP_OP_GREATER = 2,
-    RXP_OP_LESSER = 3,
-    RXP_OP_GREATER_OR_EQUAL = 4,
-    RXP_OP_LESSER_OR_EQUAL = 5
+/*
+   The resource usage is sampled with `getrusage()` before and after running
+   a test case. Linux can restrict the measures to the calling thread, which
+   keeps them accurate when running test cases concurrently, but the other
+   platforms measure the whole process.
+*/
+
+#if defined(RXP_PLATFORM_UNIX)
+#if defined(RUSAGE_THREAD)
+#define RXP_RUSAGE_WHO RUSAGE_THREAD
+#elif defined(RXP_PLATFORM_LINUX)
+/* Only defined with the GNU extensions but part of the kernel's ABI. */
+#define RXP_RUSAGE_WHO 1
+#else
+#define RXP_RUSAGE_WHO RUSAGE_SELF
+#endif
+
+#if defined(RXP_PLATFORM_DARWIN)
+#define RXP_RUSAGE_MAX_RSS_UNIT 1
+#else
+#define RXP_RUSAGE_MAX_RSS_UNIT 1024
+#endif
+
+struct rxp_resource_snapshot {
+    struct rusage usage;
 };
 
-static void
-rxp_op_get_symbol(const char **symbol, enum rxp_op op)
+static enum rx_status
+rxp_resource_snapshot_take(struct rxp_resource_snapshot *snapshot)
 {
-    RX_ASSERT(symbol != NULL);
+    RX_ASSERT(snapshot != NULL);
 
-    switch (op) {
-        case RXP_OP_EQUAL:
-            *symbol = "==";
-            return;
-        case RXP_OP_NOT_EQUAL:
-            *symbol = "!=";
-            return;
-        case RXP_OP_GREATER:
-            *symbol = ">";
-            return;
-        case RXP_OP_LESSER:
-            *symbol = "<";
-            return;
-        case RXP_OP_GREATER_OR_EQUAL:
-            *symbol = ">=";
-            return;
-        case RXP_OP_LESSER_OR_EQUAL:
-            *symbol = "<=";
-            return;
-        default:
-            RX_ASSERT(0);
+    if (getrusage(RXP_RUSAGE_WHO, &snapshot->usage) != 0) {
+        RXP_LOG_DEBUG("failed to retrieve the resource usage\n");
+        return RX_ERROR;
     }
+
+    return RX_SUCCESS;
+}
+
+static rx_uint64
+rxp_timeval_get_delta(const struct timeval *begin, const struct timeval *end)
+{
+    rx_uint64 begin_time;
+    rx_uint64 end_time;
+
+    RX_ASSERT(begin != NULL);
+    RX_ASSERT(end != NULL);
+
+    begin_time = (rx_uint64)begin->tv_sec * RXP_TICKS_PER_SECOND
+                 + (rx_uint64)begin->tv_usec * RXP_TICKS_PER_MICROSECOND;
+    end_time = (rx_uint64)end->tv_sec * RXP_TICKS_PER_SECOND
+               + (rx_uint64)end->tv_usec * RXP_TICKS_PER_MICROSECOND;
+    return end_time > begin_time ? end_time - begin_time : 0;
+}
+
+static rx_uint64
+rxp_long_get_delta(long begin, long end)
+{
+    return end > begin ? (rx_uint64)(end - begin) : 0;
 }
 
 static void
-rxp_op_get_name(const char **name, enum rxp_op op)
+rxp_resource_usage_compute(struct rx_resource_usage *usage,
+                           const struct rxp_resource_snapshot *begin,
+                           const struct rxp_resource_snapshot *end)
 {
-    RX_ASSERT(name != NULL);
+    RX_ASSERT(usage != NULL);
+    RX_ASSERT(begin != NULL);
+    RX_ASSERT(end != NULL);
+
+    usage->available = 1;
+    usage->user_time = rxp_timeval_get_delta(&begin->usage.ru_utime,
+                                             &end->usage.ru_utime);
+    usage->system_time = rxp_timeval_get_delta(&begin->usage.ru_stime,
+                                               &end->usage.ru_stime);
+    usage->max_rss_growth
+        = rxp_long_get_delta(begin->usage.ru_maxrss, end->usage.ru_maxrss)
+          * RXP_RUSAGE_MAX_RSS_UNIT;
+    usage->minor_faults
+        = rxp_long_get_delta(begin->usage.ru_minflt, end->usage.ru_minflt);
+    usage->major_faults
+        = rxp_long_get_delta(begin->usage.ru_majflt, end->usage.ru_majflt);
+    usage->voluntary_context_switches
+        = rxp_long_get_delta(begin->usage.ru_nvcsw, end->usage.ru_nvcsw);
+    usage->involuntary_context_switches
+        = rxp_long_get_delta(begin->usage.ru_nivcsw, end->usage.ru_nivcsw);
+}
+#else
+struct rxp_resource_snapshot {
+    int unused;
+};
 
-    switch (op) {
-        case RXP_OP_EQUAL:
-            *name = "equal to";
-            return;
-        case RXP_OP_NOT_EQUAL:
-            *name = "not equal to";
-            return;
-        case RXP_OP_GREATER:
-            *name = "greater than";
-            return;
-        case RXP_OP_LESSER:
-            *name = "less than";
-            return;
-        case RXP_OP_GREATER_OR_EQUAL:
-            *name = "greater than or equal to";
-            return;
-        case RXP_OP_LESSER_OR_EQUAL:
-            *name = "less than or equal to";
-            return;
-        default:
-            RX_ASSERT(0);
-    }
+static enum rx_status
+rxp_resource_snapshot_take(struct rxp_resource_snapshot *snapshot)
+{
+    RX_ASSERT(snapshot != NULL);
+
+    RXP_UNUSED(snapshot);
+    return RX_ERROR;
 }
 
-/* Implementation: String                                          O-(''Q)
-   -------------------------------------------------------------------------- */
+static void
+rxp_resource_usage_compute(struct rx_resource_usage *usage,
+                           const struct rxp_resource_snapshot *begin,
+                           const struct rxp_resource_snapshot *end)
+{
+    RX_ASSERT(usage != NULL);
+    RX_ASSERT(begin != NULL);
+    RX_ASSERT(end != NULL);
 
-#define RXP_STR_LENGTH_ID rxp_length
+    RXP_UNUSED(begin);
+    RXP_UNUSED(end);
+    usage->available = 0;
+}
+#endif
 
-#define RXP_STR_CREATE_VA_LIST(STATUS, S, FMT)                                 \
-    do {                                                                       \
-        va_list args;                                                          \
-        size_t RXP_STR_LENGTH_ID;                                              \
-                                                                               \
-        (S) = NULL;                                                            \
-                                                                               \
-        va_start(args, FMT);                                                   \
-        (STATUS)                                                               \
-            = rxp_str_initialize_va_list(&RXP_STR_LENGTH_ID, S, FMT, args);    \
-        va_end(args);                                                          \
-                                                                               \
-        if ((STATUS) == RX_SUCCESS) {                                          \
-            (S) = (char *)RX_MALLOC(sizeof *(S) * RXP_STR_LENGTH_ID);          \
-            if ((S) == NULL) {                                                 \
-                RXP_LOG_DEBUG_1(                                               \
-                    "failed to allocate the string (%lu bytes)\n",             \
-                    (unsigned long)sizeof *(S) * RXP_STR_LENGTH_ID);           \
-                (STATUS) = RX_ERROR_ALLOCATION;                                \
-            } else {                                                           \
-                va_start(args, FMT);                                           \
-                (STATUS) = rxp_str_initialize_va_list(                         \
-                    &RXP_STR_LENGTH_ID, S, FMT, args);                         \
-                va_end(args);                                                  \
-                if ((STATUS) != RX_SUCCESS) {                                  \
-                    RX_FREE(S);                                                \
-                }                                                              \
-            }                                                                  \
-        }                                                                      \
-    } while (0)
-
-#define RXP_STR_CREATE_(STATUS, S, ARGS)                                       \
-    do {                                                                       \
-        size_t RXP_STR_LENGTH_ID;                                              \
-                                                                               \
-        (S) = NULL;                                                            \
-        (STATUS) = rxp_str_initialize ARGS;                                    \
-        if ((STATUS) == RX_SUCCESS) {                                          \
-            (S) = (char *)RX_MALLOC(sizeof *(S) * RXP_STR_LENGTH_ID);          \
-            if ((S) == NULL) {                                                 \
-                RXP_LOG_DEBUG_1(                                               \
-                    "failed to allocate the string (%lu bytes)\n",             \
-                    (unsigned long)sizeof *(S) * RXP_STR_LENGTH_ID);           \
-                (STATUS) = RX_ERROR_ALLOCATION;                                \
-            } else {                                                           \
-                (STATUS) = rxp_str_initialize ARGS;                            \
-                if ((STATUS) != RX_SUCCESS) {                                  \
-                    RX_FREE(S);                                                \
-                }                                                              \
-            }                                                                  \
-        }                                                                      \
-    } while (0)
-
-#define RXP_STR_CREATE(STATUS, S, MSG)                                         \
-    RXP_STR_CREATE_(STATUS, S, (&RXP_STR_LENGTH_ID, S, MSG))
+struct rxp_usage_metric_desc {
+    const char *name;
+    const char *label;
+};
 
-#define RXP_STR_CREATE_1(STATUS, S, FMT, _0)                                   \
-    RXP_STR_CREATE_(STATUS, S, (&RXP_STR_LENGTH_ID, S, FMT, _0))
+static const struct rxp_usage_metric_desc rxp_usage_metric_descs[] = {
+    {"cpu-time", "CPU time"},
+    {"user-time", "user CPU time"},
+    {"system-time", "system CPU time"},
+    {"max-rss", "max RSS growth"},
+    {"minor-faults", "minor page faults"},
+    {"major-faults", "major page faults"},
+    {"voluntary-switches", "voluntary context switches"},
+    {"involuntary-switches", "involuntary context switches"},
+};
 
-#define RXP_STR_CREATE_2(STATUS, S, FMT, _0, _1)                               \
-    RXP_STR_CREATE_(STATUS, S, (&RXP_STR_LENGTH_ID, S, FMT, _0, _1))
+static enum rx_status
+rxp_usage_metric_parse(enum rx_usage_metric *metric, const char *name)
+{
+    size_t i;
 
-#define RXP_STR_CREATE_3(STATUS, S, FMT, _0, _1, _2)                           \
-    RXP_STR_CREATE_(STATUS, S, (&RXP_STR_LENGTH_ID, S, FMT, _0, _1, _2))
+    RX_ASSERT(metric != NULL);
+    RX_ASSERT(name != NULL);
 
-#define RXP_STR_CREATE_4(STATUS, S, FMT, _0, _1, _2, _3)                       \
-    RXP_STR_CREATE_(STATUS, S, (&RXP_STR_LENGTH_ID, S, FMT, _0, _1, _2, _3))
+    for (i = 0;
+         i < sizeof rxp_usage_metric_descs / sizeof *rxp_usage_metric_descs;
+         ++i) {
+        if (strcmp(rxp_usage_metric_descs[i].name, name) == 0) {
+            *metric = (enum rx_usage_metric)i;
+            return RX_SUCCESS;
+        }
+    }
 
-enum rxp_str_case { RXP_STR_CASE_OBEY = 0, RXP_STR_CASE_IGNORE = 1 };
+    return RX_ERROR;
+}
 
-static void
-rxp_str_case_get_type(const char **type, enum rxp_str_case str_case)
+static rx_uint64
+rxp_resource_usage_get(const struct rx_resource_usage *usage,
+                       enum rx_usage_metric metric)
 {
-    RX_ASSERT(type != NULL);
-
-    switch (str_case) {
-        case RXP_STR_CASE_OBEY:
-            *type = "obey";
-            return;
-        case RXP_STR_CASE_IGNORE:
-            *type = "ignore";
-            return;
+    RX_ASSERT(usage != NULL);
+
+    switch (metric) {
+        case RX_USAGE_CPU_TIME:
+            return usage->user_time + usage->system_time;
+        case RX_USAGE_USER_TIME:
+            return usage->user_time;
+        case RX_USAGE_SYSTEM_TIME:
+            return usage->system_time;
+        case RX_USAGE_MAX_RSS_GROWTH:
+            return usage->max_rss_growth;
+        case RX_USAGE_MINOR_FAULTS:
+            return usage->minor_faults;
+        case RX_USAGE_MAJOR_FAULTS:
+            return usage->major_faults;
+        case RX_USAGE_VOLUNTARY_CONTEXT_SWITCHES:
+            return usage->voluntary_context_switches;
+        case RX_USAGE_INVOLUNTARY_CONTEXT_SWITCHES:
+            return usage->involuntary_context_switches;
         default:
             RX_ASSERT(0);
+            return 0;
     }
 }
 
-RXP_PRINTF_CHECK(3, 0)
-static enum rx_status
-rxp_str_initialize_va_list(size_t *count,
-                           char *s,
-                           const char *fmt,
-                           va_list args)
-{
-    int size;
+/* Implementation: Allocation Tracking                             O-(''Q)
+   -------------------------------------------------------------------------- */
 
-    RX_ASSERT(count != NULL);
+/*
+   When enabled, the allocation functions of the program are replaced with ones
+   forwarding to glibc's internal functions, and recording each call into
+   the counters of the calling thread, if any. The sizes of the blocks are
+   retrieved with `malloc_usable_size()` rather than being stored alongside
+   them, and only the blocks found in the set of the counters count towards
+   the frees, which leaves out the blocks allocated before the tracking
+   started. A block freed by another thread than the one that allocated it
+   remains live.
+*/
 
-    if (s == NULL) {
-#if defined(RXP_PLATFORM_WINDOWS)
-        size = _vscprintf(fmt, args);
-#elif RXP_HAS_NPRINTF
-        size = vsnprintf(NULL, 0, fmt, args);
+#if RXP_ALLOC_TRACKING
+#include <errno.h>
+#include <malloc.h>
+
+#if defined(__cplusplus)
+#define RXP_ALLOC_THROW __THROW
 #else
-        {
-            FILE *file;
+#define RXP_ALLOC_THROW
+#endif
 
-            file = fopen("/dev/null", "w");
-            if (file == NULL) {
-                RXP_LOG_DEBUG("could not open `/dev/null`\n");
-                return RX_ERROR;
-            }
+#define RXP_ALLOC_BLOCK_INITIAL_CAPACITY 256
 
-            size = vfprintf(file, fmt, args);
-            fclose(file);
-        }
-#endif
+static __thread struct rxp_alloc_counters *rxp_alloc_counters_current;
 
-        if (size < 0) {
-            RXP_LOG_DEBUG("invalid string formatting\n");
-            return RX_ERROR;
+/* Marks the slots of the blocks removed from the set. */
+static char rxp_alloc_block_tombstone;
+
+static size_t
+rxp_alloc_block_hash(const void *ptr)
+{
+    rx_uint64 x;
+
+    x = (rx_uint64)(size_t)ptr;
+    x = (x ^ (x >> 30))
+        * ((rx_uint64)0xbf58476du << 32 | (rx_uint64)0x1ce4e5b9u);
+    return (size_t)(x ^ (x >> 31));
+}
+
+/*
+   Find the slot of a block, or else the slot where to insert it. The capacity
+   being a power of two, and the set never being full, the probing ends.
+*/
+static void **
+rxp_alloc_blocks_find(void **blocks, size_t capacity, const void *ptr)
+{
+    void **tombstone;
+    size_t i;
+
+    RX_ASSERT(blocks != NULL);
+    RX_ASSERT(capacity > 0);
+
+    tombstone = NULL;
+    i = rxp_alloc_block_hash(ptr) & (capacity - 1);
+    while (blocks[i] != NULL) {
+        if (blocks[i] == ptr) {
+            return &blocks[i];
         }
 
-        *count = (size_t)size + 1;
-        return RX_SUCCESS;
-    }
+        if (blocks[i] == (void *)&rxp_alloc_block_tombstone
+            && tombstone == NULL) {
+            tombstone = &blocks[i];
+        }
 
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 4996)
-#endif
-    size = vsprintf(s, fmt, args);
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
-    if (size < 0) {
-        RXP_LOG_DEBUG("unexpected string formatting error\n");
-        return RX_ERROR;
+        i = (i + 1) & (capacity - 1);
     }
 
-    *count = (size_t)size + 1;
-    return RX_SUCCESS;
+    return tombstone != NULL ? tombstone : &blocks[i];
 }
 
-RXP_PRINTF_CHECK(3, 4)
-static enum rx_status
-rxp_str_initialize(size_t *count, char *s, const char *fmt, ...)
+static int
+rxp_alloc_blocks_grow(struct rxp_alloc_counters *counters)
 {
-    enum rx_status out;
-    va_list args;
+    void **blocks;
+    size_t capacity;
+    size_t i;
 
-    RX_ASSERT(count != NULL);
+    RX_ASSERT(counters != NULL);
 
-    va_start(args, fmt);
-    out = rxp_str_initialize_va_list(count, s, fmt, args);
-    va_end(args);
+    /* Rehashing at the same capacity is enough to clear the tombstones. */
+    if (counters->block_capacity == 0) {
+        capacity = RXP_ALLOC_BLOCK_INITIAL_CAPACITY;
+    } else if (counters->block_count >= counters->block_capacity / 4) {
+        capacity = counters->block_capacity * 2;
+    } else {
+        capacity = counters->block_capacity;
+    }
 
-    return out;
+    blocks = (void **)__libc_calloc(capacity, sizeof *blocks);
+    if (blocks == NULL) {
+        return 0;
+    }
+
+    for (i = 0; i < counters->block_capacity; ++i) {
+        void *ptr;
+
+        ptr = counters->blocks[i];
+        if (ptr != NULL && ptr != (void *)&rxp_alloc_block_tombstone) {
+            *rxp_alloc_blocks_find(blocks, capacity, ptr) = ptr;
+        }
+    }
+
+    __libc_free(counters->blocks);
+    counters->blocks = blocks;
+    counters->block_capacity = capacity;
+    counters->block_tombstone_count = 0;
+    return 1;
 }
 
-static enum rx_status
-rxp_str_copy(char **s, const char *original)
+static int
+rxp_alloc_blocks_insert(struct rxp_alloc_counters *counters, void *ptr)
 {
-    size_t size;
+    void **slot;
 
-    size = strlen(original) + 1;
+    RX_ASSERT(counters != NULL);
+    RX_ASSERT(ptr != NULL);
 
-    *s = (char *)RX_MALLOC(sizeof **s * size);
-    if (*s == NULL) {
-        RXP_LOG_DEBUG_1("failed to allocate the string (%lu bytes)\n",
-                        (unsigned long)sizeof **s * size);
-        return RX_ERROR_ALLOCATION;
+    if ((counters->block_count + counters->block_tombstone_count + 1) * 4
+            > counters->block_capacity * 3
+        && !rxp_alloc_blocks_grow(counters)) {
+        return 0;
     }
 
-    memcpy(*s, original, size);
-    return RX_SUCCESS;
-}
+    slot = rxp_alloc_blocks_find(
+        counters->blocks, counters->block_capacity, ptr);
+    if (*slot == ptr) {
+        /* Freed by another thread, and then allocated again. */
+        return 1;
+    }
 
-/* Implementation: Helpers                                         O-(''Q)
-   -------------------------------------------------------------------------- */
+    if (*slot == (void *)&rxp_alloc_block_tombstone) {
+        --counters->block_tombstone_count;
+    }
 
-RXP_MAYBE_UNUSED static int
-rxp_compare_test_cases(const void *a, const void *b)
+    *slot = ptr;
+    ++counters->block_count;
+    return 1;
+}
+
+static int
+rxp_alloc_blocks_remove(struct rxp_alloc_counters *counters, const void *ptr)
 {
-    int out;
-    const struct rx_test_case *aa;
-    const struct rx_test_case *bb;
+    void **slot;
 
-    aa = (const struct rx_test_case *)a;
-    bb = (const struct rx_test_case *)b;
+    RX_ASSERT(counters != NULL);
+    RX_ASSERT(ptr != NULL);
 
-    out = strcmp(aa->suite_name, bb->suite_name);
-    if (out != 0) {
-        return out;
+    if (counters->block_count == 0) {
+        return 0;
     }
 
-    return strcmp(aa->name, bb->name);
+    slot = rxp_alloc_blocks_find(
+        counters->blocks, counters->block_capacity, ptr);
+    if (*slot != ptr) {
+        return 0;
+    }
+
+    *slot = (void *)&rxp_alloc_block_tombstone;
+    --counters->block_count;
+    ++counters->block_tombstone_count;
+    return 1;
 }
 
-static int
-rxp_compare_summaries_by_test_suite(const void *a, const void *b)
+static void
+rxp_alloc_record_allocation(struct rxp_alloc_counters *counters,
+                            void *ptr,
+                            size_t size)
 {
-    const struct rx_summary *aa;
-    const struct rx_summary *bb;
+    RX_ASSERT(counters != NULL);
+    RX_ASSERT(ptr != NULL);
 
-    aa = (const struct rx_summary *)a;
-    bb = (const struct rx_summary *)b;
-    return strcmp(aa->test_case->suite_name, bb->test_case->suite_name);
+    ++counters->allocation_count;
+    counters->allocated_bytes += (rx_uint64)size;
+
+    if (!rxp_alloc_blocks_insert(counters, ptr)) {
+        counters->overflowed = 1;
+        return;
+    }
+
+    ++counters->live_count;
+    counters->live_bytes += (rx_uint64)malloc_usable_size(ptr);
+    if (counters->live_bytes > counters->peak_bytes) {
+        counters->peak_bytes = counters->live_bytes;
+    }
 }
 
+/*
+   The block is possibly already released by the time that it is recorded, in
+   which case only its address is looked up.
+*/
 static void
-rxp_real_are_equal_fuzzy(int *result, rxp_real a, rxp_real b, rxp_real tol)
+rxp_alloc_record_free(struct rxp_alloc_counters *counters,
+                      const void *ptr,
+                      size_t usable_size)
 {
-    rxp_real diff;
-    rxp_real abs_a;
-    rxp_real abs_b;
+    RX_ASSERT(counters != NULL);
+    RX_ASSERT(ptr != NULL);
 
-    diff = a > b ? a - b : b - a;
-    if (diff <= tol) {
-        *result = 1;
+    if (!rxp_alloc_blocks_remove(counters, ptr)) {
         return;
     }
 
-    abs_a = a < 0 ? -a : a;
-    abs_b = b < 0 ? -b : b;
-    *result = diff <= (abs_a > abs_b ? abs_a : abs_b) * tol;
+    ++counters->free_count;
+    --counters->live_count;
+    counters->live_bytes -= (rx_uint64)usable_size;
 }
 
-static void
-rxp_str_are_equal(int *result, const char *a, const char *b)
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+void *
+malloc(size_t size) RXP_ALLOC_THROW
 {
-    while (*a != '\0') {
-        if (*a != *b) {
-            *result = 0;
-            return;
-        }
+    void *ptr;
 
-        ++a;
-        ++b;
+    ptr = __libc_malloc(size);
+    if (ptr != NULL && rxp_alloc_counters_current != NULL) {
+        rxp_alloc_record_allocation(rxp_alloc_counters_current, ptr, size);
     }
 
-    *result = *a == *b;
+    return ptr;
 }
 
-static void
-rxp_str_are_equal_no_case(int *result, const char *a, const char *b)
+void *
+calloc(size_t count, size_t size) RXP_ALLOC_THROW
 {
-    while (*a != '\0') {
-        if (tolower(*a) != tolower(*b)) {
-            *result = 0;
-            return;
-        }
+    void *ptr;
 
-        ++a;
-        ++b;
+    ptr = __libc_calloc(count, size);
+    if (ptr != NULL && rxp_alloc_counters_current != NULL) {
+        rxp_alloc_record_allocation(
+            rxp_alloc_counters_current, ptr, count * size);
     }
 
-    *result = tolower(*a) == tolower(*b);
+    return ptr;
 }
 
-RXP_MAYBE_UNUSED static enum rx_status
-rxp_run_test_cases(size_t test_case_count,
-                   const struct rx_test_case *test_cases)
+/*
+   Reallocating a block that isn't tracked counts as a new allocation, without
+   the matching free.
+*/
+void *
+realloc(void *ptr, size_t size) RXP_ALLOC_THROW
 {
-    size_t i;
-    enum rx_status status;
-    struct rx_summary *summaries;
+    struct rxp_alloc_counters *counters;
+    size_t released;
+    void *out;
 
-#ifdef RXP_DEBUG_TESTS
+    counters = rxp_alloc_counters_current;
+    if (counters == NULL) {
+        return __libc_realloc(ptr, size);
+    }
 
-    const char *style_begin;
-    const char *style_end;
+    released = ptr != NULL ? malloc_usable_size(ptr) : 0;
 
-#if RXP_LOG_STYLING
-    if (RXP_ISATTY(RXP_FILENO(stderr))) {
-        rxp_log_style_get_ansi_code(&style_begin, RXP_LOG_STYLE_YELLOW);
-        rxp_log_style_get_ansi_code(&style_end, RXP_LOG_STYLE_RESET);
-    } else {
-        style_begin = style_end = "";
+    out = __libc_realloc(ptr, size);
+    if (out == NULL && size > 0) {
+        /* The original block is left untouched. */
+        return NULL;
     }
-#else
-    style_begin = style_end = "";
-#endif
 
-#endif
+    if (ptr != NULL) {
+        rxp_alloc_record_free(counters, ptr, released);
+    }
 
-    if (test_case_count == 0) {
-        RXP_LOG_INFO("nothing to run\n");
-        return RX_SUCCESS;
+    if (out != NULL) {
+        rxp_alloc_record_allocation(counters, out, size);
     }
 
-    RX_ASSERT(test_cases != NULL);
+    return out;
+}
 
-    summaries
-        = (struct rx_summary *)RX_MALLOC(sizeof *summaries * test_case_count);
-    if (summaries == NULL) {
-        RXP_LOG_DEBUG("failed to allocate the summaries\n");
-        return RX_ERROR_ALLOCATION;
+void
+free(void *ptr) RXP_ALLOC_THROW
+{
+    if (ptr != NULL && rxp_alloc_counters_current != NULL) {
+        rxp_alloc_record_free(
+            rxp_alloc_counters_current, ptr, malloc_usable_size(ptr));
     }
 
-    status = RX_SUCCESS;
-
-    for (i = 0; i < test_case_count;) {
-        const struct rx_test_case *test_case;
-        struct rx_summary *summary;
+    __libc_free(ptr);
+}
 
-        test_case = &test_cases[i];
-        summary = &summaries[i];
+int
+posix_memalign(void **ptr, size_t alignment, size_t size) RXP_ALLOC_THROW
+{
+    void *out;
 
-        RX_ASSERT(test_case->suite_name != NULL);
-        RX_ASSERT(test_case->name != NULL);
+    if (alignment % sizeof(void *) != 0
+        || (alignment & (alignment - 1)) != 0 || alignment == 0) {
+        return EINVAL;
+    }
 
-        status = rx_summary_initialize(summary, test_case);
-        if (status != RX_SUCCESS) {
-            RXP_LOG_ERROR_2("failed to initialize the summary "
-                            "(suite: \"%s\", case: \"%s\")\n",
-                            test_case->suite_name,
-                            test_case->name);
-            goto summaries_cleanup;
-        }
+    out = __libc_memalign(alignment, size);
+    if (out == NULL) {
+        return ENOMEM;
+    }
 
-        ++i;
+    if (rxp_alloc_counters_current != NULL) {
+        rxp_alloc_record_allocation(rxp_alloc_counters_current, out, size);
+    }
 
-#ifdef RXP_DEBUG_TESTS
-        fprintf(stderr,
-                "[%s%s%s] (test \"%zd\" of \"%zd\", suite: \"%s\", case: "
-                "\"%s\")\n",
-                style_begin,
-                "EXECUTING",
-                style_end,
-                i,
-                test_case_count,
-                test_case->suite_name,
-                test_case->name);
-#endif
+    *ptr = out;
+    return 0;
+}
 
-        status = rx_test_case_run(summary, test_case);
-        if (status != RX_SUCCESS) {
-            RXP_LOG_ERROR_2("failed to run a test case "
-                            "(suite: \"%s\", case: \"%s\")\n",
-                            test_case->suite_name,
-                            test_case->name);
-            goto summaries_cleanup;
-        }
+void *
+aligned_alloc(size_t alignment, size_t size) RXP_ALLOC_THROW
+{
+    void *ptr;
 
-        rx_summary_print(summary);
+    ptr = __libc_memalign(alignment, size);
+    if (ptr != NULL && rxp_alloc_counters_current != NULL) {
+        rxp_alloc_record_allocation(rxp_alloc_counters_current, ptr, size);
     }
 
-    if (status == RX_SUCCESS) {
-        size_t j;
+    return ptr;
+}
 
-        for (j = 0; j < test_case_count; ++j) {
-            size_t k;
-            struct rx_summary *summary;
+void *
+memalign(size_t alignment, size_t size) RXP_ALLOC_THROW
+{
+    void *ptr;
 
-            summary = &summaries[j];
+    ptr = __libc_memalign(alignment, size);
+    if (ptr != NULL && rxp_alloc_counters_current != NULL) {
+        rxp_alloc_record_allocation(rxp_alloc_counters_current, ptr, size);
+    }
 
-            for (k = 0; k < summary->failure_count; ++k) {
-                const struct rx_failure *failure;
+    return ptr;
+}
 
-                failure = &summary->failures[k];
-                if (failure->severity == RX_FATAL) {
-                    status = RX_ERROR_ABORTED;
-                    goto summaries_cleanup;
-                }
-            }
-        }
-    }
+void *
+valloc(size_t size) RXP_ALLOC_THROW
+{
+    void *ptr;
 
-summaries_cleanup:
-    while (i-- > 0) {
-        rx_summary_terminate(&summaries[i]);
+    ptr = __libc_valloc(size);
+    if (ptr != NULL && rxp_alloc_counters_current != NULL) {
+        rxp_alloc_record_allocation(rxp_alloc_counters_current, ptr, size);
     }
 
-    RX_FREE(summaries);
-
-    return status;
+    return ptr;
 }
 
-RXP_MAYBE_UNUSED static enum rx_status
-rxp_run_registered_test_cases(void)
+void *
+pvalloc(size_t size) RXP_ALLOC_THROW
 {
-    enum rx_status out;
-    rx_size test_case_count;
-    struct rx_test_case *test_cases;
+    void *ptr;
 
-    rx_enumerate_test_cases(&test_case_count, NULL);
-    if (test_case_count == 0) {
-        return rxp_run_test_cases(0, NULL);
-    }
-
-    test_cases = (struct rx_test_case *)RX_MALLOC(sizeof *test_cases
-                                                  * test_case_count);
-    if (test_cases == NULL) {
-        RXP_LOG_ERROR("failed to allocate the test cases\n");
-        return RX_ERROR_ALLOCATION;
+    ptr = __libc_pvalloc(size);
+    if (ptr != NULL && rxp_alloc_counters_current != NULL) {
+        rxp_alloc_record_allocation(rxp_alloc_counters_current, ptr, size);
     }
 
-    rx_enumerate_test_cases(&test_case_count, test_cases);
-    out = rxp_run_test_cases(test_case_count, test_cases);
-    RX_FREE(test_cases);
-    return out;
+    return ptr;
 }
 
-/* Implementation: Test Assessments                                O-(''Q)
-   -------------------------------------------------------------------------- */
+#if defined(__cplusplus)
+}
+#endif
 
-RXP_PRINTF_CHECK(8, 0)
-RXP_MAYBE_UNUSED static void
-rxp_assess_value(struct rx_context *context,
-                 int x,
-                 int expected,
-                 const char *expr,
-                 const char *file,
-                 int line,
-                 enum rx_severity severity,
-                 const char *failure_fmt,
-                 ...)
+static void
+rxp_alloc_tracking_begin(struct rxp_alloc_counters *counters)
 {
-    int result;
-    char *failure_msg;
-    char *diagnostic_msg;
+    RX_ASSERT(counters != NULL);
 
-    RX_ASSERT(context != NULL);
-    RX_ASSERT(file != NULL);
-
-    result = ((x && expected) || (!x && !expected));
+    memset(counters, 0, sizeof *counters);
+    rxp_alloc_counters_current = counters;
+}
 
-    if (result) {
-        failure_msg = NULL;
-        diagnostic_msg = NULL;
-    } else {
-        enum rx_status status;
+static void
+rxp_alloc_tracking_end(struct rx_alloc_stats *stats,
+                       struct rxp_alloc_counters *counters)
+{
+    RX_ASSERT(stats != NULL);
+    RX_ASSERT(counters != NULL);
 
-        if (failure_fmt == NULL) {
-            RXP_STR_CREATE_1(status,
-                             failure_msg,
-                             "`%s` is expected to evaluate to true",
-                             expr);
-        } else {
-            RXP_STR_CREATE_VA_LIST(status, failure_msg, failure_fmt);
-        }
+    rxp_alloc_counters_current = NULL;
 
-        if (status != RX_SUCCESS) {
-            RXP_LOG_DEBUG_2("failed to create the failure message for "
-                            "the test located at %s:%d\n",
-                            file,
-                            line);
-            failure_msg = NULL;
-        }
+    __libc_free(counters->blocks);
+    counters->blocks = NULL;
+    counters->block_capacity = 0;
+    counters->block_count = 0;
 
-        RXP_STR_CREATE_1(status, diagnostic_msg, "%d", x);
-        if (status != RX_SUCCESS) {
-            RXP_LOG_DEBUG_2("failed to create the diagnostic message for "
-                            "the test located at %s:%d\n",
-                            file,
-                            line);
-            diagnostic_msg = NULL;
-        }
+    if (counters->overflowed) {
+        RXP_LOG_DEBUG("failed to keep track of the allocated blocks\n");
+        stats->available = 0;
+        return;
     }
 
-    if (rx_handle_test_result(
-            context, result, file, line, severity, failure_msg, diagnostic_msg)
-        != RX_SUCCESS) {
-        RXP_LOG_DEBUG_2("failed to handle the test result for the test "
-                        "located at %s:%d\n",
-                        file,
-                        line);
-    }
+    stats->available = 1;
+    stats->allocation_count = counters->allocation_count;
+    stats->free_count = counters->free_count;
+    stats->allocated_bytes = counters->allocated_bytes;
+    stats->peak_bytes = counters->peak_bytes;
+    stats->live_count = counters->live_count;
+    stats->live_bytes = counters->live_bytes;
+}
 
-    RX_FREE(failure_msg);
-    RX_FREE(diagnostic_msg);
+RXP_MAYBE_UNUSED static const struct rxp_alloc_counters *
+rxp_alloc_tracking_get_counters(void)
+{
+    return rxp_alloc_counters_current;
+}
 
-    if (!result && severity == RX_FATAL) {
-        rx_abort(context);
-    }
+/*
+   Leave out the allocations made by the C library on behalf of Rexo while
+   a test case is running, such as when formatting a failure message.
+*/
+RXP_MAYBE_UNUSED static struct rxp_alloc_counters *
+rxp_alloc_tracking_suspend(void)
+{
+    struct rxp_alloc_counters *counters;
+
+    counters = rxp_alloc_counters_current;
+    rxp_alloc_counters_current = NULL;
+    return counters;
 }
 
-RXP_PRINTF_CHECK(8, 0)
 RXP_MAYBE_UNUSED static void
-rxp_bool_assess_value(struct rx_context *context,
-                      int x,
-                      int expected,
-                      const char *expr,
-                      const char *file,
-                      int line,
-                      enum rx_severity severity,
-                      const char *failure_fmt,
-                      ...)
+rxp_alloc_tracking_resume(struct rxp_alloc_counters *counters)
 {
-    int result;
-    char *failure_msg;
-    char *diagnostic_msg;
+    rxp_alloc_counters_current = counters;
+}
+#else
+static void
+rxp_alloc_tracking_begin(struct rxp_alloc_counters *counters)
+{
+    RX_ASSERT(counters != NULL);
 
-    RX_ASSERT(context != NULL);
-    RX_ASSERT(expr != NULL);
-    RX_ASSERT(file != NULL);
+    RXP_UNUSED(counters);
+}
 
-    result = ((x && expected) || (!x && !expected));
+static void
+rxp_alloc_tracking_end(struct rx_alloc_stats *stats,
+                       struct rxp_alloc_counters *counters)
+{
+    RX_ASSERT(stats != NULL);
+    RX_ASSERT(counters != NULL);
 
-    if (result) {
-        failure_msg = NULL;
-        diagnostic_msg = NULL;
-    } else {
-        enum rx_status status;
+    RXP_UNUSED(counters);
+    stats->available = 0;
+}
 
-        if (failure_fmt == NULL) {
-            RXP_STR_CREATE_2(status,
-                             failure_msg,
-                             "`%s` is expected to be %s",
-                             expr,
-                             expected ? "true" : "false");
-        } else {
-            RXP_STR_CREATE_VA_LIST(status, failure_msg, failure_fmt);
-        }
+RXP_MAYBE_UNUSED static const struct rxp_alloc_counters *
+rxp_alloc_tracking_get_counters(void)
+{
+    return NULL;
+}
 
-        if (status != RX_SUCCESS) {
-            RXP_LOG_DEBUG_2("failed to create the failure message for "
-                            "the boolean test located at %s:%d\n",
-                            file,
-                            line);
-            failure_msg = NULL;
-        }
+RXP_MAYBE_UNUSED static struct rxp_alloc_counters *
+rxp_alloc_tracking_suspend(void)
+{
+    return NULL;
+}
 
-        RXP_STR_CREATE_2(status, diagnostic_msg, "%d == %d", x, expected);
-        if (status != RX_SUCCESS) {
-            RXP_LOG_DEBUG_2("failed to create the diagnostic message for "
-                            "the boolean test located at %s:%d\n",
-                            file,
-                            line);
-            diagnostic_msg = NULL;
-        }
+RXP_MAYBE_UNUSED static void
+rxp_alloc_tracking_resume(struct rxp_alloc_counters *counters)
+{
+    RXP_UNUSED(counters);
+}
+#endif
+
+/* Implementation: Latency Histograms                              O-(''Q)
+   -------------------------------------------------------------------------- */
+
+#define RXP_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT                                 \
+    ((rx_uint64)1 << RXP_LATENCY_HISTOGRAM_SUB_BUCKET_BITS)
+#define RXP_LATENCY_HISTOGRAM_HALF_BUCKET_COUNT                                \
+    (RXP_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT >> 1)
+#define RXP_LATENCY_HISTOGRAM_VALUE_MAX                                        \
+    (((rx_uint64)1 << RXP_LATENCY_HISTOGRAM_VALUE_BITS) - 1)
+
+/*
+   The values below the sub-bucket count map to themselves. The others are
+   shifted right until they fit in the upper half of the sub-buckets, and
+   the shift picks which power of two they belong to.
+*/
+static size_t
+rxp_latency_histogram_get_bucket_index(rx_uint64 value)
+{
+    size_t shift;
+
+    if (value > RXP_LATENCY_HISTOGRAM_VALUE_MAX) {
+        value = RXP_LATENCY_HISTOGRAM_VALUE_MAX;
     }
 
-    if (rx_handle_test_result(
-            context, result, file, line, severity, failure_msg, diagnostic_msg)
-        != RX_SUCCESS) {
-        RXP_LOG_DEBUG_2("failed to handle the test result for the boolean test "
-                        "located at %s:%d\n",
-                        file,
-                        line);
+    shift = 0;
+    while ((value >> shift) >= RXP_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT) {
+        ++shift;
     }
 
-    RX_FREE(failure_msg);
-    RX_FREE(diagnostic_msg);
+    return (size_t)(shift * RXP_LATENCY_HISTOGRAM_HALF_BUCKET_COUNT
+                    + (value >> shift));
+}
 
-    if (!result && severity == RX_FATAL) {
-        rx_abort(context);
+static rx_uint64
+rxp_latency_histogram_get_bucket_max(size_t index)
+{
+    size_t shift;
+    rx_uint64 sub_bucket;
+
+    if (index < RXP_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT) {
+        return (rx_uint64)index;
     }
+
+    shift = (size_t)(index / RXP_LATENCY_HISTOGRAM_HALF_BUCKET_COUNT) - 1;
+    sub_bucket = (rx_uint64)index
+                 - shift * RXP_LATENCY_HISTOGRAM_HALF_BUCKET_COUNT;
+    return ((sub_bucket + 1) << shift) - 1;
 }
 
-RXP_PRINTF_CHECK(10, 0)
-RXP_MAYBE_UNUSED static void
-rxp_int_assess_comparison(struct rx_context *context,
-                          rxp_int x1,
-                          rxp_int x2,
-                          enum rxp_op op,
-                          const char *expr1,
-                          const char *expr2,
-                          const char *file,
-                          int line,
-                          enum rx_severity severity,
-                          const char *failure_fmt,
-                          ...)
+static void
+rxp_latency_histogram_record(struct rx_latency_histogram *histogram,
+                             rx_uint64 value)
 {
-    int result;
-    char *failure_msg;
-    char *diagnostic_msg;
+    size_t index;
 
-    RX_ASSERT(context != NULL);
-    RX_ASSERT(expr1 != NULL);
-    RX_ASSERT(expr2 != NULL);
-    RX_ASSERT(file != NULL);
+    RX_ASSERT(histogram != NULL);
 
-    switch (op) {
-        case RXP_OP_EQUAL:
-            result = x1 == x2;
-            break;
-        case RXP_OP_NOT_EQUAL:
-            result = x1 != x2;
-            break;
-        case RXP_OP_GREATER:
-            result = x1 > x2;
-            break;
-        case RXP_OP_LESSER:
-            result = x1 < x2;
-            break;
-        case RXP_OP_GREATER_OR_EQUAL:
-            result = x1 >= x2;
-            break;
-        case RXP_OP_LESSER_OR_EQUAL:
-            result = x1 <= x2;
-            break;
-        default:
-            RX_ASSERT(0);
-            result = 0;
-            break;
+    index = rxp_latency_histogram_get_bucket_index(value);
+    RX_ASSERT(index < RXP_LATENCY_HISTOGRAM_BUCKET_COUNT);
+
+    if (histogram->count == 0 || value < histogram->min) {
+        histogram->min = value;
     }
 
-    if (result) {
-        failure_msg = NULL;
-        diagnostic_msg = NULL;
-    } else {
-        enum rx_status status;
-        const char *op_symbol;
+    if (histogram->count == 0 || value > histogram->max) {
+        histogram->max = value;
+    }
 
-        if (failure_fmt == NULL) {
-            const char *op_name;
+    ++histogram->count;
+    ++histogram->buckets[index];
+}
 
-            rxp_op_get_name(&op_name, op);
-            RXP_STR_CREATE_3(status,
-                             failure_msg,
-                             "`%s` is expected to be %s `%s`",
-                             expr1,
-                             op_name,
-                             expr2);
-        } else {
-            RXP_STR_CREATE_VA_LIST(status, failure_msg, failure_fmt);
-        }
+/* Implementation: Threads                                         O-(''Q)
+   -------------------------------------------------------------------------- */
 
-        if (status != RX_SUCCESS) {
-            RXP_LOG_DEBUG_2("failed to create the failure message for "
-                            "the integer comparison test located at %s:%d\n",
-                            file,
-                            line);
-            failure_msg = NULL;
-        }
+/*
+   Minimal abstraction over the native threading primitives, only covering
+   what the runner needs to execute test cases concurrently.
+*/
 
-        rxp_op_get_symbol(&op_symbol, op);
-        RXP_STR_CREATE_3(status,
-                         diagnostic_msg,
-                         "%ld %s %ld",
-                         (long)x1,
-                         op_symbol,
-                         (long)x2);
-        if (status != RX_SUCCESS) {
-            RXP_LOG_DEBUG_2("failed to create the diagnostic message for "
-                            "the integer comparison test located at %s:%d\n",
-                            file,
-                            line);
-            diagnostic_msg = NULL;
-        }
-    }
+#if !defined(RX_DISABLE_THREADS)                                               \
+    && (defined(RXP_PLATFORM_WINDOWS) || defined(RXP_PLATFORM_UNIX))
+#define RXP_THREADS 1
+#else
+#define RXP_THREADS 0
+#endif
 
-    if (rx_handle_test_result(
-            context, result, file, line, severity, failure_msg, diagnostic_msg)
-        != RX_SUCCESS) {
-        RXP_LOG_DEBUG_2("failed to handle the test result for the integer "
-                        "comparison test located at %s:%d\n",
-                        file,
-                        line);
-    }
+#if RXP_THREADS
+#if defined(RXP_PLATFORM_WINDOWS)
+typedef HANDLE rxp_thread;
+typedef CRITICAL_SECTION rxp_mutex;
+typedef DWORD rxp_thread_result;
+#define RXP_THREAD_CALL WINAPI
+#else
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+typedef pthread_t rxp_thread;
+typedef pthread_mutex_t rxp_mutex;
+typedef void *rxp_thread_result;
+#define RXP_THREAD_CALL
+#endif
 
-    RX_FREE(failure_msg);
-    RX_FREE(diagnostic_msg);
+typedef rxp_thread_result(RXP_THREAD_CALL *rxp_thread_fn)(void *);
 
-    if (!result && severity == RX_FATAL) {
-        rx_abort(context);
+static enum rx_status
+rxp_thread_create(rxp_thread *thread, rxp_thread_fn fn, void *arg)
+{
+    RX_ASSERT(thread != NULL);
+    RX_ASSERT(fn != NULL);
+
+#if defined(RXP_PLATFORM_WINDOWS)
+    *thread = CreateThread(NULL, 0, fn, arg, 0, NULL);
+    if (*thread == NULL) {
+        RXP_LOG_DEBUG("failed to create a thread\n");
+        return RX_ERROR;
+    }
+#else
+    if (pthread_create(thread, NULL, fn, arg) != 0) {
+        RXP_LOG_DEBUG("failed to create a thread\n");
+        return RX_ERROR;
     }
+#endif
+
+    return RX_SUCCESS;
 }
 
-RXP_PRINTF_CHECK(10, 0)
-RXP_MAYBE_UNUSED static void
-rxp_uint_assess_comparison(struct rx_context *context,
-                           rxp_uint x1,
-                           rxp_uint x2,
-                           enum rxp_op op,
-                           const char *expr1,
-                           const char *expr2,
-                           const char *file,
-                           int line,
-                           enum rx_severity severity,
-                           const char *failure_fmt,
-                           ...)
+static void
+rxp_thread_join(rxp_thread thread)
 {
-    int result;
-    char *failure_msg;
-    char *diagnostic_msg;
+#if defined(RXP_PLATFORM_WINDOWS)
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+}
 
-    RX_ASSERT(context != NULL);
-    RX_ASSERT(expr1 != NULL);
-    RX_ASSERT(expr2 != NULL);
-    RX_ASSERT(file != NULL);
+static enum rx_status
+rxp_mutex_initialize(rxp_mutex *mutex)
+{
+    RX_ASSERT(mutex != NULL);
 
-    switch (op) {
-        case RXP_OP_EQUAL:
-            result = x1 == x2;
-            break;
-        case RXP_OP_NOT_EQUAL:
-            result = x1 != x2;
-            break;
-        case RXP_OP_GREATER:
-            result = x1 > x2;
-            break;
-        case RXP_OP_LESSER:
-            result = x1 < x2;
-            break;
-        case RXP_OP_GREATER_OR_EQUAL:
-            result = x1 >= x2;
-            break;
-        case RXP_OP_LESSER_OR_EQUAL:
-            result = x1 <= x2;
-            break;
-        default:
-            RX_ASSERT(0);
-            result = 0;
-            break;
+#if defined(RXP_PLATFORM_WINDOWS)
+    InitializeCriticalSection(mutex);
+#else
+    if (pthread_mutex_init(mutex, NULL) != 0) {
+        RXP_LOG_DEBUG("failed to initialize a mutex\n");
+        return RX_ERROR;
     }
+#endif
 
-    if (result) {
-        failure_msg = NULL;
-        diagnostic_msg = NULL;
-    } else {
-        enum rx_status status;
-        const char *op_symbol;
+    return RX_SUCCESS;
+}
 
-        if (failure_fmt == NULL) {
-            const char *op_name;
+static void
+rxp_mutex_terminate(rxp_mutex *mutex)
+{
+    RX_ASSERT(mutex != NULL);
 
-            rxp_op_get_name(&op_name, op);
-            RXP_STR_CREATE_3(status,
-                             failure_msg,
-                             "`%s` is expected to be %s `%s`",
-                             expr1,
-                             op_name,
-                             expr2);
-        } else {
-            RXP_STR_CREATE_VA_LIST(status, failure_msg, failure_fmt);
-        }
+#if defined(RXP_PLATFORM_WINDOWS)
+    DeleteCriticalSection(mutex);
+#else
+    pthread_mutex_destroy(mutex);
+#endif
+}
 
-        if (status != RX_SUCCESS) {
-            RXP_LOG_DEBUG_2("failed to create the failure message for "
-                            "the unsigned integer comparison test located at "
-                            "%s:%d\n",
-                            file,
-                            line);
-            failure_msg = NULL;
-        }
+static void
+rxp_mutex_lock(rxp_mutex *mutex)
+{
+    RX_ASSERT(mutex != NULL);
 
-        rxp_op_get_symbol(&op_symbol, op);
-        RXP_STR_CREATE_3(status,
-                         diagnostic_msg,
-                         "%lu %s %lu",
-                         (unsigned long)x1,
-                         op_symbol,
-                         (unsigned long)x2);
-        if (status != RX_SUCCESS) {
-            RXP_LOG_DEBUG_2("failed to create the diagnostic message for "
-                            "the unsigned integer comparison test located at "
-                            "%s:%d\n",
-                            file,
-                            line);
-            diagnostic_msg = NULL;
-        }
-    }
+#if defined(RXP_PLATFORM_WINDOWS)
+    EnterCriticalSection(mutex);
+#else
+    pthread_mutex_lock(mutex);
+#endif
+}
 
-    if (rx_handle_test_result(
-            context, result, file, line, severity, failure_msg, diagnostic_msg)
-        != RX_SUCCESS) {
-        RXP_LOG_DEBUG_2("failed to handle the test result for the unsigned "
-                        "integer comparison test located at %s:%d\n",
-                        file,
-                        line);
-    }
+static void
+rxp_mutex_unlock(rxp_mutex *mutex)
+{
+    RX_ASSERT(mutex != NULL);
 
-    RX_FREE(failure_msg);
-    RX_FREE(diagnostic_msg);
+#if defined(RXP_PLATFORM_WINDOWS)
+    LeaveCriticalSection(mutex);
+#else
+    pthread_mutex_unlock(mutex);
+#endif
+}
 
-    if (!result && severity == RX_FATAL) {
-        rx_abort(context);
+static void
+rxp_thread_sleep(unsigned long milliseconds)
+{
+#if defined(RXP_PLATFORM_WINDOWS)
+    Sleep((DWORD)milliseconds);
+#else
+    struct timespec duration;
+
+    duration.tv_sec = (time_t)(milliseconds / 1000);
+    duration.tv_nsec = (long)(milliseconds % 1000) * 1000000L;
+    while (nanosleep(&duration, &duration) != 0 && errno == EINTR) {
+        continue;
     }
+#endif
 }
+#endif /* RXP_THREADS */
 
-RXP_PRINTF_CHECK(10, 0)
-RXP_MAYBE_UNUSED static void
-rxp_real_assess_comparison(struct rx_context *context,
-                           rxp_real x1,
-                           rxp_real x2,
-                           enum rxp_op op,
-                           const char *expr1,
-                           const char *expr2,
-                           const char *file,
-                           int line,
-                           enum rx_severity severity,
-                           const char *failure_fmt,
-                           ...)
+static void
+rxp_get_cpu_count(size_t *count)
 {
-    int result;
-    char *failure_msg;
-    char *diagnostic_msg;
+    RX_ASSERT(count != NULL);
 
-    RX_ASSERT(context != NULL);
-    RX_ASSERT(expr1 != NULL);
-    RX_ASSERT(expr2 != NULL);
-    RX_ASSERT(file != NULL);
+#if defined(RXP_PLATFORM_WINDOWS)
+    {
+        SYSTEM_INFO info;
 
-    switch (op) {
-#if defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wfloat-equal"
-#endif
-        case RXP_OP_EQUAL:
-            result = x1 == x2;
-            break;
-        case RXP_OP_NOT_EQUAL:
-            result = x1 != x2;
-            break;
-#if defined(__GNUC__)
-#pragma GCC diagnostic pop
+        GetSystemInfo(&info);
+        *count = (size_t)info.dwNumberOfProcessors;
+    }
+#elif defined(RXP_PLATFORM_UNIX) && defined(_SC_NPROCESSORS_ONLN)
+    {
+        long value;
+
+        value = sysconf(_SC_NPROCESSORS_ONLN);
+        *count = value > 0 ? (size_t)value : 1;
+    }
+#else
+    *count = 1;
 #endif
-        case RXP_OP_GREATER:
-            result = x1 > x2;
-            break;
-        case RXP_OP_LESSER:
-            result = x1 < x2;
-            break;
-        case RXP_OP_GREATER_OR_EQUAL:
-            result = x1 >= x2;
-            break;
-        case RXP_OP_LESSER_OR_EQUAL:
-            result = x1 <= x2;
-            break;
-        default:
-            RX_ASSERT(0);
-            result = 0;
-            break;
+
+    if (*count == 0) {
+        *count = 1;
     }
+}
 
-    if (result) {
-        failure_msg = NULL;
-        diagnostic_msg = NULL;
-    } else {
-        enum rx_status status;
-        const char *op_symbol;
+/* Implementation: Processes                                       O-(''Q)
+   -------------------------------------------------------------------------- */
 
-        if (failure_fmt == NULL) {
-            const char *op_name;
+/*
+   Helpers to communicate with worker processes through pipes, used when
+   isolating test cases from each other.
+*/
 
-            rxp_op_get_name(&op_name, op);
-            RXP_STR_CREATE_3(status,
-                             failure_msg,
-                             "`%s` is expected to be %s `%s`",
-                             expr1,
-                             op_name,
-                             expr2);
-        } else {
-            RXP_STR_CREATE_VA_LIST(status, failure_msg, failure_fmt);
-        }
+#if !defined(RX_DISABLE_PROCESSES) && defined(RXP_PLATFORM_UNIX)
+#define RXP_PROCESSES 1
+#else
+#define RXP_PROCESSES 0
+#endif
 
-        if (status != RX_SUCCESS) {
-            RXP_LOG_DEBUG_2("failed to create the failure message for "
-                            "the real comparison test located at %s:%d\n",
-                            file,
-                            line);
-            failure_msg = NULL;
-        }
+#if RXP_PROCESSES
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
 
-        rxp_op_get_symbol(&op_symbol, op);
-        RXP_STR_CREATE_3(
-            status, diagnostic_msg, "%Lf %s %Lf", x1, op_symbol, x2);
-        if (status != RX_SUCCESS) {
-            RXP_LOG_DEBUG_2("failed to create the diagnostic message for "
-                            "the real comparison test located at %s:%d\n",
-                            file,
-                            line);
-            diagnostic_msg = NULL;
+static enum rx_status
+rxp_fd_write(int fd, const void *buf, size_t size)
+{
+    const char *it;
+
+    RX_ASSERT(buf != NULL || size == 0);
+
+    it = (const char *)buf;
+    while (size > 0) {
+        ssize_t count;
+
+        count = write(fd, it, size);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            RXP_LOG_DEBUG("failed to write to a file descriptor\n");
+            return RX_ERROR;
         }
-    }
 
-    if (rx_handle_test_result(
-            context, result, file, line, severity, failure_msg, diagnostic_msg)
-        != RX_SUCCESS) {
-        RXP_LOG_DEBUG_2("failed to handle the test result for the real "
-                        "comparison test located at %s:%d\n",
-                        file,
-                        line);
+        it += count;
+        size -= (size_t)count;
     }
 
-    RX_FREE(failure_msg);
-    RX_FREE(diagnostic_msg);
+    return RX_SUCCESS;
+}
 
-    if (!result && severity == RX_FATAL) {
-        rx_abort(context);
+static enum rx_status
+rxp_fd_read(int fd, void *buf, size_t size)
+{
+    char *it;
+
+    RX_ASSERT(buf != NULL || size == 0);
+
+    it = (char *)buf;
+    while (size > 0) {
+        ssize_t count;
+
+        count = read(fd, it, size);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            RXP_LOG_DEBUG("failed to read from a file descriptor\n");
+            return RX_ERROR;
+        }
+
+        if (count == 0) {
+            /* The other end of the pipe has been closed. */
+            return RX_ERROR;
+        }
+
+        it += count;
+        size -= (size_t)count;
     }
+
+    return RX_SUCCESS;
 }
 
-RXP_PRINTF_CHECK(11, 0)
-RXP_MAYBE_UNUSED static void
-rxp_real_assess_fuzzy_comparison(struct rx_context *context,
-                                 rxp_real x1,
-                                 rxp_real x2,
-                                 rxp_real tol,
-                                 enum rxp_op op,
-                                 const char *expr1,
-                                 const char *expr2,
-                                 const char *file,
-                                 int line,
-                                 enum rx_severity severity,
-                                 const char *failure_fmt,
-                                 ...)
+static enum rx_status
+rxp_fd_write_str(int fd, const char *s)
 {
-    int result;
-    char *failure_msg;
-    char *diagnostic_msg;
+    enum rx_status status;
+    size_t size;
 
-    RX_ASSERT(context != NULL);
-    RX_ASSERT(expr1 != NULL);
-    RX_ASSERT(expr2 != NULL);
-    RX_ASSERT(file != NULL);
+    size = s == NULL ? 0 : strlen(s) + 1;
 
-    switch (op) {
-        case RXP_OP_EQUAL:
-            rxp_real_are_equal_fuzzy(&result, x1, x2, tol);
-            break;
-        case RXP_OP_NOT_EQUAL:
-            rxp_real_are_equal_fuzzy(&result, x1, x2, tol);
-            result = !result;
-            break;
-        default:
-            RX_ASSERT(0);
-            result = 0;
-            break;
+    status = rxp_fd_write(fd, &size, sizeof size);
+    if (status != RX_SUCCESS) {
+        return status;
     }
 
-    if (result) {
-        failure_msg = NULL;
-        diagnostic_msg = NULL;
-    } else {
-        enum rx_status status;
-        const char *op_symbol;
+    return rxp_fd_write(fd, s, size);
+}
 
-        if (failure_fmt == NULL) {
-            const char *op_name;
+static enum rx_status
+rxp_fd_read_str(char **s, int fd)
+{
+    enum rx_status status;
+    size_t size;
 
-            rxp_op_get_name(&op_name, op);
-            RXP_STR_CREATE_4(status,
-                             failure_msg,
-                             "`%s` is expected to be almost %s `%s` "
-                             "(tolerance: %Lf)",
-                             expr1,
-                             op_name,
-                             expr2,
-                             tol);
-        } else {
-            RXP_STR_CREATE_VA_LIST(status, failure_msg, failure_fmt);
-        }
+    RX_ASSERT(s != NULL);
 
-        if (status != RX_SUCCESS) {
-            RXP_LOG_DEBUG_2("failed to create the failure message for "
-                            "the real almost equal test located at %s:%d\n",
-                            file,
-                            line);
-            failure_msg = NULL;
-        }
+    *s = NULL;
 
-        rxp_op_get_symbol(&op_symbol, op);
-        RXP_STR_CREATE_3(
-            status, diagnostic_msg, "%Lf %s %Lf", x1, op_symbol, x2);
-        if (status != RX_SUCCESS) {
-            RXP_LOG_DEBUG_2("failed to create the diagnostic message for "
-                            "the real almost equal test located at %s:%d\n",
-                            file,
-                            line);
-            diagnostic_msg = NULL;
-        }
+    status = rxp_fd_read(fd, &size, sizeof size);
+    if (status != RX_SUCCESS) {
+        return status;
     }
 
-    if (rx_handle_test_result(
-            context, result, file, line, severity, failure_msg, diagnostic_msg)
-        != RX_SUCCESS) {
-        RXP_LOG_DEBUG_2("failed to handle the test result for the real "
-                        "almost equal test located at %s:%d\n",
-                        file,
-                        line);
+    if (size == 0) {
+        return RX_SUCCESS;
     }
 
-    RX_FREE(failure_msg);
-    RX_FREE(diagnostic_msg);
+    *s = (char *)RX_MALLOC(sizeof **s * size);
+    if (*s == NULL) {
+        RXP_LOG_DEBUG_1("failed to allocate the string (%lu bytes)\n",
+                        (unsigned long)sizeof **s * size);
+        return RX_ERROR_ALLOCATION;
+    }
 
-    if (!result && severity == RX_FATAL) {
-        rx_abort(context);
+    status = rxp_fd_read(fd, *s, size);
+    if (status != RX_SUCCESS) {
+        RX_FREE(*s);
+        *s = NULL;
+        return status;
     }
+
+    (*s)[size - 1] = '\0';
+    return RX_SUCCESS;
 }
 
-RXP_PRINTF_CHECK(11, 0)
-RXP_MAYBE_UNUSED static void
-rxp_str_assess_comparison(struct rx_context *context,
-                          const char *s1,
-                          const char *s2,
-                          enum rxp_str_case str_case,
-                          enum rxp_op op,
-                          const char *expr1,
-                          const char *expr2,
-                          const char *file,
-                          int line,
-                          enum rx_severity severity,
-                          const char *failure_fmt,
-                          ...)
+static void
+rxp_signal_get_name(const char **name, int sig)
 {
-    int result;
-    char *failure_msg;
-    char *diagnostic_msg;
+    RX_ASSERT(name != NULL);
 
-    RX_ASSERT(context != NULL);
+    switch (sig) {
+        case SIGABRT:
+            *name = "SIGABRT";
+            return;
+        case SIGFPE:
+            *name = "SIGFPE";
+            return;
+        case SIGILL:
+            *name = "SIGILL";
+            return;
+        case SIGINT:
+            *name = "SIGINT";
+            return;
+        case SIGKILL:
+            *name = "SIGKILL";
+            return;
+        case SIGSEGV:
+            *name = "SIGSEGV";
+            return;
+        case SIGTERM:
+            *name = "SIGTERM";
+            return;
+#if defined(SIGBUS)
+        case SIGBUS:
+            *name = "SIGBUS";
+            return;
+#endif
+#if defined(SIGSYS)
+        case SIGSYS:
+            *name = "SIGSYS";
+            return;
+#endif
+#if defined(SIGTRAP)
+        case SIGTRAP:
+            *name = "SIGTRAP";
+            return;
+#endif
+        default:
+            *name = "unknown signal";
+            return;
+    }
+}
+#endif /* RXP_PROCESSES */
+
+/* Implementation: Test Failure Array                              O-(''Q)
+   -------------------------------------------------------------------------- */
+
+/*
+   Simple implementation for dynamic arrays that can grow and stretch at
+   runtime. The object returned to the user is a standard pointer to a C array
+   but the implementation also allocates a header to keep track of the size
+   and the capacity.
+
+   The memory layout is better represented by the diagram below.
+
+   block     user pointer
+    /        /
+   +--------+--------+
+   | header | buffer |
+   +--------+--------+
+
+   The block points to the whole memory being allocated while the buffer
+   represents the actual array exposed to the user.
+*/
+
+#define RXP_DYN_ARRAY_GET_BLOCK(BUF)                                           \
+    ((void *)&((struct rxp_dyn_array_header *)(BUF))[-1])
+#define RXP_DYN_ARRAY_GET_HEADER(BLOCK) ((struct rxp_dyn_array_header *)(BLOCK))
+#define RXP_DYN_ARRAY_GET_BUFFER(BLOCK)                                        \
+    ((void *)&((struct rxp_dyn_array_header *)(BLOCK))[1])
+#define RXP_DYN_ARRAY_GET_CONST_BLOCK(BUF)                                     \
+    ((const void *)&((const struct rxp_dyn_array_header *)(BUF))[-1])
+#define RXP_DYN_ARRAY_GET_CONST_HEADER(BLOCK)                                  \
+    ((const struct rxp_dyn_array_header *)(BLOCK))
+
+struct rxp_dyn_array_header {
+    size_t size;
+    size_t capacity;
+};
+
+static const size_t rxp_test_failure_array_max_capacity
+    = (((size_t)-1 - sizeof(struct rxp_dyn_array_header))
+       / sizeof(struct rx_failure));
+
+static void
+rxp_dyn_array_get_new_capacity(size_t *capacity,
+                               size_t current,
+                               size_t requested,
+                               size_t max)
+{
+    *capacity = current + current / 2 + 1;
+    if (*capacity < current) {
+        *capacity = max;
+        return;
+    }
+
+    if (*capacity < requested) {
+        *capacity = requested;
+    }
+}
+
+static enum rx_status
+rxp_dyn_array_ensure_has_enough_capacity(void **block,
+                                         size_t current_capacity,
+                                         size_t requested_capacity,
+                                         size_t max_capacity,
+                                         size_t element_size)
+{
+    void *buf;
+    size_t new_capacity;
+
+    RX_ASSERT(block != NULL);
+    RX_ASSERT(element_size > 0);
+
+    if (requested_capacity > max_capacity) {
+        RXP_LOG_DEBUG("the requested capacity is too large\n");
+        return RX_ERROR_MAX_SIZE_EXCEEDED;
+    }
+
+    if (*block != NULL && current_capacity >= requested_capacity) {
+        return RX_SUCCESS;
+    }
+
+    rxp_dyn_array_get_new_capacity(
+        &new_capacity, current_capacity, requested_capacity, max_capacity);
+    RX_ASSERT(new_capacity >= requested_capacity);
+    RX_ASSERT(new_capacity <= max_capacity);
+
+    buf = RX_REALLOC(
+        *block,
+        sizeof(struct rxp_dyn_array_header) + element_size * new_capacity);
+    if (buf == NULL) {
+        RXP_LOG_DEBUG("failed to reallocate the block\n");
+        return RX_ERROR_ALLOCATION;
+    }
+
+    RXP_DYN_ARRAY_GET_HEADER(buf)->capacity = new_capacity;
+    *block = buf;
+    return RX_SUCCESS;
+}
+
+static enum rx_status
+rxp_test_failure_array_create(struct rx_failure **array, size_t size)
+{
+    void *block;
+    size_t capacity;
+
+    RX_ASSERT(array != NULL);
+
+    rxp_dyn_array_get_new_capacity(
+        &capacity, 0, size, rxp_test_failure_array_max_capacity);
+    RX_ASSERT(capacity >= size);
+    RX_ASSERT(capacity <= rxp_test_failure_array_max_capacity);
+
+    block = RX_MALLOC(sizeof(struct rxp_dyn_array_header)
+                      + sizeof(struct rx_failure) * capacity);
+    if (block == NULL) {
+        RXP_LOG_DEBUG_1("failed to reserve a large enough capacity for "
+                        "the test failure array (requested capacity: %lu)\n",
+                        (unsigned long)size);
+        return RX_ERROR_ALLOCATION;
+    }
+
+    RXP_DYN_ARRAY_GET_HEADER(block)->size = size;
+    RXP_DYN_ARRAY_GET_HEADER(block)->capacity = capacity;
+    *array = (struct rx_failure *)RXP_DYN_ARRAY_GET_BUFFER(block);
+    return RX_SUCCESS;
+}
+
+static void
+rxp_test_failure_array_destroy(struct rx_failure *array)
+{
+    RX_FREE(RXP_DYN_ARRAY_GET_BLOCK(array));
+}
+
+static void
+rxp_test_failure_array_get_size(size_t *size, const struct rx_failure *array)
+{
+    RX_ASSERT(array != NULL);
+
+    *size = RXP_DYN_ARRAY_GET_CONST_HEADER(RXP_DYN_ARRAY_GET_CONST_BLOCK(array))
+                ->size;
+}
+
+static enum rx_status
+rxp_test_failure_array_extend_back(struct rx_failure **slice,
+                                   struct rx_failure **array,
+                                   size_t size)
+{
+    enum rx_status status;
+    void *block;
+    size_t pos;
+
+    RX_ASSERT(array != NULL);
+    RX_ASSERT(*array != NULL);
+
+    block = RXP_DYN_ARRAY_GET_BLOCK(*array);
+    status = rxp_dyn_array_ensure_has_enough_capacity(
+        &block,
+        RXP_DYN_ARRAY_GET_HEADER(block)->capacity,
+        RXP_DYN_ARRAY_GET_HEADER(block)->size + size,
+        rxp_test_failure_array_max_capacity,
+        sizeof(struct rx_failure));
+    if (status != RX_SUCCESS) {
+        RXP_LOG_DEBUG_1(
+            "failed to reserve a large enough capacity for "
+            "the test failure array (requested capacity: %lu)\n",
+            (unsigned long)RXP_DYN_ARRAY_GET_HEADER(block)->size + size);
+        return status;
+    }
+
+    RX_ASSERT(block != NULL);
+
+    *array = (struct rx_failure *)RXP_DYN_ARRAY_GET_BUFFER(block);
+
+    pos = RXP_DYN_ARRAY_GET_HEADER(block)->size;
+    memmove(&(*array)[pos + size],
+            &(*array)[pos],
+            sizeof(struct rx_failure)
+                * (RXP_DYN_ARRAY_GET_HEADER(block)->size - pos));
+
+    if (slice != NULL) {
+        *slice = &(*array)[pos];
+    }
+
+    RXP_DYN_ARRAY_GET_HEADER(block)->size += size;
+    return RX_SUCCESS;
+}
+
+/* Implementation: Memory Sections                                 O-(''Q)
+   -------------------------------------------------------------------------- */
+
+/*
+   Compiler-specific code that allows grouping objects into specific
+   data sections, thus enabling automatic discovery by iterating over
+   anything registered in these sections.
+*/
+
+#if defined(__clang__)
+/*
+   Older versions of Clang's address sanitizer incorrectly report
+   a global buffer overflow in custom data sections.
+*/
+#define RXP_SECTION_SUPPRESS_ADDRESS_SANITIZER                                 \
+    __attribute__((no_sanitize_address))
+#else
+#define RXP_SECTION_SUPPRESS_ADDRESS_SANITIZER
+#endif
+
+#if !defined(RX_DISABLE_TEST_DISCOVERY)                                        \
+    && (defined(_MSC_VER) || defined(__GNUC__) || defined(__MINGW64__))
+#define RXP_TEST_DISCOVERY 1
+#else
+#define RXP_TEST_DISCOVERY 0
+#endif
+
+#if !RXP_TEST_DISCOVERY
+#define RXP_TEST_SUITE_REGISTER(NAME) RXP_REQUIRE_SEMICOLON
+#elif defined(_MSC_VER)
+__pragma(section("rxsuite$a", read)) __pragma(section("rxsuite$b", read))
+    __pragma(section("rxsuite$c", read))
+
+        __declspec(allocate("rxsuite$a")) RXP_STORAGE const
+    struct rxp_test_suite_desc *const rxp_test_suite_section_begin
+    = NULL;
+
+__declspec(allocate("rxsuite$c")) RXP_STORAGE const struct rxp_test_suite_desc
+    *const rxp_test_suite_section_end
+    = NULL;
+
+#define RXP_TEST_SUITE_REGISTER(NAME)                                          \
+    __declspec(allocate(                                                       \
+        "rxsuite$b")) RXP_STORAGE const struct rxp_test_suite_desc *const      \
+    RXP_TEST_SUITE_DESC_PTR_GET_ID(NAME)                                       \
+        = &RXP_TEST_SUITE_DESC_GET_ID(NAME)
+
+#define RXP_TEST_SUITE_SECTION_BEGIN (&rxp_test_suite_section_begin + 1)
+#define RXP_TEST_SUITE_SECTION_END (&rxp_test_suite_section_end)
+#elif defined(__GNUC__) || defined(__MINGW64__)
+#if defined(RXP_PLATFORM_DARWIN)
+extern const struct rxp_test_suite_desc *const
+    __start_rxsuite __asm("section$start$__DATA$rxsuite");
+extern const struct rxp_test_suite_desc *const
+    __stop_rxsuite __asm("section$end$__DATA$rxsuite");
+
+#define RXP_TEST_SUITE_SECTION                                                 \
+    RXP_SECTION_SUPPRESS_ADDRESS_SANITIZER                                     \
+    __attribute__((used, section("__DATA,rxsuite")))
+#else
+extern const struct rxp_test_suite_desc *const __start_rxsuite;
+extern const struct rxp_test_suite_desc *const __stop_rxsuite;
+
+#define RXP_TEST_SUITE_SECTION                                                 \
+    RXP_SECTION_SUPPRESS_ADDRESS_SANITIZER                                     \
+    __attribute__((used, section("rxsuite")))
+#endif
+
+RXP_TEST_SUITE_SECTION
+static const struct rxp_test_suite_desc *const rxp_dummy_suite = NULL;
+
+#define RXP_TEST_SUITE_REGISTER(NAME)                                          \
+    RXP_TEST_SUITE_SECTION                                                     \
+    const struct rxp_test_suite_desc *const RXP_TEST_SUITE_DESC_PTR_GET_ID(    \
+        NAME)                                                                  \
+        = &RXP_TEST_SUITE_DESC_GET_ID(NAME)
+
+#define RXP_TEST_SUITE_SECTION_BEGIN (&__start_rxsuite)
+#define RXP_TEST_SUITE_SECTION_END (&__stop_rxsuite)
+#endif
+
+#if !RXP_TEST_DISCOVERY
+#define RXP_TEST_CASE_REGISTER(SUITE_NAME, NAME) RXP_REQUIRE_SEMICOLON
+#elif defined(_MSC_VER)
+__pragma(section("rxcase$a", read)) __pragma(section("rxcase$b", read))
+    __pragma(section("rxcase$c", read))
+
+        __declspec(allocate("rxcase$a")) RXP_STORAGE const
+    struct rxp_test_case_desc *const rxp_test_case_section_begin
+    = NULL;
+
+__declspec(allocate("rxcase$c")) RXP_STORAGE const struct rxp_test_case_desc
+    *const rxp_test_case_section_end
+    = NULL;
+
+#define RXP_TEST_CASE_REGISTER(SUITE_NAME, NAME)                               \
+    __declspec(allocate(                                                       \
+        "rxcase$b")) RXP_STORAGE const struct rxp_test_case_desc *const        \
+    RXP_TEST_CASE_DESC_PTR_GET_ID(SUITE_NAME, NAME)                            \
+        = &RXP_TEST_CASE_DESC_GET_ID(SUITE_NAME, NAME)
+
+#define RXP_TEST_CASE_SECTION_BEGIN (&rxp_test_case_section_begin + 1)
+#define RXP_TEST_CASE_SECTION_END (&rxp_test_case_section_end)
+#elif defined(__GNUC__) || defined(__MINGW64__)
+#if defined(RXP_PLATFORM_DARWIN)
+extern const struct rxp_test_case_desc *const
+    __start_rxcase __asm("section$start$__DATA$rxcase");
+extern const struct rxp_test_case_desc *const
+    __stop_rxcase __asm("section$end$__DATA$rxcase");
+
+#define RXP_TEST_CASE_SECTION                                                  \
+    RXP_SECTION_SUPPRESS_ADDRESS_SANITIZER                                     \
+    __attribute__((used, section("__DATA,rxcase")))
+#else
+extern const struct rxp_test_case_desc *const __start_rxcase;
+extern const struct rxp_test_case_desc *const __stop_rxcase;
+
+#define RXP_TEST_CASE_SECTION                                                  \
+    RXP_SECTION_SUPPRESS_ADDRESS_SANITIZER                                     \
+    __attribute__((used, section("rxcase")))
+#endif
+
+RXP_TEST_CASE_SECTION
+static const struct rxp_test_case_desc *const rxp_dummy_case = NULL;
+
+#define RXP_TEST_CASE_REGISTER(SUITE_NAME, NAME)                               \
+    RXP_TEST_CASE_SECTION                                                      \
+    const struct rxp_test_case_desc *const RXP_TEST_CASE_DESC_PTR_GET_ID(      \
+        SUITE_NAME, NAME)                                                      \
+        = &RXP_TEST_CASE_DESC_GET_ID(SUITE_NAME, NAME)
+
+#define RXP_TEST_CASE_SECTION_BEGIN (&__start_rxcase)
+#define RXP_TEST_CASE_SECTION_END (&__stop_rxcase)
+#endif
+
+#if !RXP_TEST_DISCOVERY
+#define RXP_BENCHMARK_REGISTER(SUITE_NAME, NAME) RXP_REQUIRE_SEMICOLON
+#elif defined(_MSC_VER)
+__pragma(section("rxbench$a", read)) __pragma(section("rxbench$b", read))
+    __pragma(section("rxbench$c", read))
+
+        __declspec(allocate("rxbench$a")) RXP_STORAGE const
+    struct rxp_benchmark_desc *const rxp_benchmark_section_begin
+    = NULL;
+
+__declspec(allocate("rxbench$c")) RXP_STORAGE const struct rxp_benchmark_desc
+    *const rxp_benchmark_section_end
+    = NULL;
+
+#define RXP_BENCHMARK_REGISTER(SUITE_NAME, NAME)                               \
+    __declspec(allocate(                                                       \
+        "rxbench$b")) RXP_STORAGE const struct rxp_benchmark_desc *const       \
+    RXP_BENCHMARK_DESC_PTR_GET_ID(SUITE_NAME, NAME)                            \
+        = &RXP_BENCHMARK_DESC_GET_ID(SUITE_NAME, NAME)
+
+#define RXP_BENCHMARK_SECTION_BEGIN (&rxp_benchmark_section_begin + 1)
+#define RXP_BENCHMARK_SECTION_END (&rxp_benchmark_section_end)
+#elif defined(__GNUC__) || defined(__MINGW64__)
+#if defined(RXP_PLATFORM_DARWIN)
+extern const struct rxp_benchmark_desc *const
+    __start_rxbench __asm("section$start$__DATA$rxbench");
+extern const struct rxp_benchmark_desc *const
+    __stop_rxbench __asm("section$end$__DATA$rxbench");
+
+#define RXP_BENCHMARK_SECTION                                                  \
+    RXP_SECTION_SUPPRESS_ADDRESS_SANITIZER                                     \
+    __attribute__((used, section("__DATA,rxbench")))
+#else
+extern const struct rxp_benchmark_desc *const __start_rxbench;
+extern const struct rxp_benchmark_desc *const __stop_rxbench;
+
+#define RXP_BENCHMARK_SECTION                                                  \
+    RXP_SECTION_SUPPRESS_ADDRESS_SANITIZER                                     \
+    __attribute__((used, section("rxbench")))
+#endif
+
+RXP_BENCHMARK_SECTION
+static const struct rxp_benchmark_desc *const rxp_dummy_benchmark = NULL;
+
+#define RXP_BENCHMARK_REGISTER(SUITE_NAME, NAME)                               \
+    RXP_BENCHMARK_SECTION                                                      \
+    const struct rxp_benchmark_desc *const RXP_BENCHMARK_DESC_PTR_GET_ID(      \
+        SUITE_NAME, NAME)                                                      \
+        = &RXP_BENCHMARK_DESC_GET_ID(SUITE_NAME, NAME)
+
+#define RXP_BENCHMARK_SECTION_BEGIN (&__start_rxbench)
+#define RXP_BENCHMARK_SECTION_END (&__stop_rxbench)
+#endif
+
+/* Implementation: Fixture                                         O-(''Q)
+   -------------------------------------------------------------------------- */
+
+typedef void (*rxp_fixture_config_update_fn)(struct rx_fixture_config *);
+
+struct rxp_fixture_desc {
+    rx_size size;
+    const rxp_fixture_config_update_fn update;
+};
+
+#define RXP_FIXTURE_(ID, SIZE, UPDATE_FN)                                      \
+    static const struct rxp_fixture_desc RXP_FIXTURE_DESC_GET_ID(ID)           \
+        = {SIZE, UPDATE_FN};                                                   \
+                                                                               \
+    static const struct rxp_fixture_desc *ID = &RXP_FIXTURE_DESC_GET_ID(ID);
+
+#define RXP_FIXTURE_0(ID, SIZE) RXP_FIXTURE_(ID, SIZE, NULL)
+
+#define RXP_FIXTURE_1(ID, SIZE, ARG_COUNT, ARGS)                               \
+    RXP_STRUCT_DEFINE_UPDATE_FN(RXP_FIXTURE_GET_UPDATE_FN_ID(ID),              \
+                                struct rx_fixture_config,                      \
+                                ARG_COUNT,                                     \
+                                ARGS)                                          \
+                                                                               \
+    RXP_FIXTURE_(ID, SIZE, &RXP_FIXTURE_GET_UPDATE_FN_ID(ID))
+
+/* Implementation: Test Case Config                                O-(''Q)
+   -------------------------------------------------------------------------- */
+
+struct rxp_test_case_config_blueprint {
+    int skip;
+    const struct rxp_fixture_desc *fixture;
+    double timeout;
+    const struct rxp_fixture_desc *suite_fixture;
+};
+
+typedef void (*rxp_test_case_config_blueprint_update_fn)(
+    struct rxp_test_case_config_blueprint *);
+
+struct rxp_test_case_config_desc {
+    const rxp_test_case_config_blueprint_update_fn update;
+};
+
+#define RXP_TEST_CASE_CONFIG(ID, ARG_COUNT, ARGS)                              \
+    RXP_STRUCT_DEFINE_UPDATE_FN(                                               \
+        RXP_TEST_CASE_CONFIG_BLUEPRINT_GET_UPDATE_FN_ID(ID),                   \
+        struct rxp_test_case_config_blueprint,                                 \
+        ARG_COUNT,                                                             \
+        ARGS)                                                                  \
+                                                                               \
+    static const struct rxp_test_case_config_desc                              \
+        RXP_TEST_CASE_CONFIG_DESC_GET_ID(ID)                                   \
+        = {RXP_TEST_CASE_CONFIG_BLUEPRINT_GET_UPDATE_FN_ID(ID)};
+
+/* Implementation: Test Suite                                      O-(''Q)
+   -------------------------------------------------------------------------- */
+
+struct rxp_test_suite_desc {
+    const char *name;
+    const struct rxp_test_case_config_desc *config_desc;
+};
+
+#define RXP_TEST_SUITE_(ID, CONFIG_DESC)                                       \
+    RXP_MAYBE_UNUSED static const struct rxp_test_suite_desc                   \
+        RXP_TEST_SUITE_DESC_GET_ID(ID)                                         \
+        = {#ID, CONFIG_DESC};                                                  \
+                                                                               \
+    RXP_TEST_SUITE_REGISTER(ID)
+
+#define RXP_TEST_SUITE_0(ID) RXP_TEST_SUITE_(ID, NULL);
+
+#define RXP_TEST_SUITE_1(ID, ARG_COUNT, ARGS)                                  \
+    RXP_TEST_CASE_CONFIG(ID, ARG_COUNT, ARGS)                                  \
+    RXP_TEST_SUITE_(ID, &RXP_TEST_CASE_CONFIG_DESC_GET_ID(ID));
+
+/* Implementation: Test Case                                       O-(''Q)
+   -------------------------------------------------------------------------- */
+
+struct rxp_test_case_desc {
+    const char *suite_name;
+    const char *name;
+    rx_run_fn run;
+    const struct rxp_test_case_config_desc *config_desc;
+};
+
+#define RXP_TEST_CASE_(SUITE_ID, ID, CONFIG_DESC)                              \
+    static void SUITE_ID##_##ID(RXP_DEFINE_PARAMS(void));                      \
+                                                                               \
+    RXP_MAYBE_UNUSED static const struct rxp_test_case_desc                    \
+        RXP_TEST_CASE_DESC_GET_ID(SUITE_ID, ID)                                \
+        = {#SUITE_ID, #ID, SUITE_ID##_##ID, CONFIG_DESC};                      \
+                                                                               \
+    RXP_TEST_CASE_REGISTER(SUITE_ID, ID);                                      \
+                                                                               \
+    static void SUITE_ID##_##ID(RXP_DEFINE_PARAMS(void))
+
+#define RXP_TEST_CASE_0(SUITE_ID, ID) RXP_TEST_CASE_(SUITE_ID, ID, NULL)
+
+#define RXP_TEST_CASE_1(SUITE_ID, ID, ARG_COUNT, ARGS)                         \
+    RXP_TEST_CASE_CONFIG(SUITE_ID##_##ID, ARG_COUNT, ARGS)                     \
+    RXP_TEST_CASE_(                                                            \
+        SUITE_ID, ID, &RXP_TEST_CASE_CONFIG_DESC_GET_ID(SUITE_ID##_##ID))
+
+/* Implementation: Benchmark                                       O-(''Q)
+   -------------------------------------------------------------------------- */
+
+struct rxp_benchmark_config_blueprint {
+    int skip;
+    const struct rxp_fixture_desc *fixture;
+    double min_time;
+    rx_size repetition_count;
+    rx_uint64 range_min;
+    rx_uint64 range_max;
+    rx_uint64 range_multiplier;
+    enum rx_complexity complexity_bound;
+};
+
+typedef void (*rxp_benchmark_config_blueprint_update_fn)(
+    struct rxp_benchmark_config_blueprint *);
+
+struct rxp_benchmark_config_desc {
+    const rxp_benchmark_config_blueprint_update_fn update;
+};
+
+#define RXP_BENCHMARK_CONFIG(ID, ARG_COUNT, ARGS)                              \
+    RXP_STRUCT_DEFINE_UPDATE_FN(                                               \
+        RXP_BENCHMARK_CONFIG_BLUEPRINT_GET_UPDATE_FN_ID(ID),                   \
+        struct rxp_benchmark_config_blueprint,                                 \
+        ARG_COUNT,                                                             \
+        ARGS)                                                                  \
+                                                                               \
+    static const struct rxp_benchmark_config_desc                              \
+        RXP_BENCHMARK_CONFIG_DESC_GET_ID(ID)                                   \
+        = {RXP_BENCHMARK_CONFIG_BLUEPRINT_GET_UPDATE_FN_ID(ID)};
+
+struct rxp_benchmark_desc {
+    const char *suite_name;
+    const char *name;
+    rx_run_fn run;
+    const struct rxp_benchmark_config_desc *config_desc;
+};
+
+#define RXP_BENCHMARK_(SUITE_ID, ID, CONFIG_DESC)                              \
+    static void SUITE_ID##_##ID##_benchmark(RXP_DEFINE_PARAMS(void));          \
+                                                                               \
+    RXP_MAYBE_UNUSED static const struct rxp_benchmark_desc                    \
+        RXP_BENCHMARK_DESC_GET_ID(SUITE_ID, ID)                                \
+        = {#SUITE_ID, #ID, SUITE_ID##_##ID##_benchmark, CONFIG_DESC};          \
+                                                                               \
+    RXP_BENCHMARK_REGISTER(SUITE_ID, ID);                                      \
+                                                                               \
+    static void SUITE_ID##_##ID##_benchmark(RXP_DEFINE_PARAMS(void))
+
+#define RXP_BENCHMARK_0(SUITE_ID, ID) RXP_BENCHMARK_(SUITE_ID, ID, NULL)
+
+#define RXP_BENCHMARK_1(SUITE_ID, ID, ARG_COUNT, ARGS)                         \
+    RXP_BENCHMARK_CONFIG(SUITE_ID##_##ID, ARG_COUNT, ARGS)                     \
+    RXP_BENCHMARK_(                                                            \
+        SUITE_ID, ID, &RXP_BENCHMARK_CONFIG_DESC_GET_ID(SUITE_ID##_##ID))
+
+/* Implementation: Operators                                       O-(''Q)
+   -------------------------------------------------------------------------- */
+
+enum rxp_op {
+    RXP_OP_EQUAL = 0,
+    RXP_OP_NOT_EQUAL = 1,
+    RXP_OP_GREATER = 2,
+    RXP_OP_LESSER = 3,
+    RXP_OP_GREATER_OR_EQUAL = 4,
+    RXP_OP_LESSER_OR_EQUAL = 5
+};
+
+static void
+rxp_op_get_symbol(const char **symbol, enum rxp_op op)
+{
+    RX_ASSERT(symbol != NULL);
+
+    switch (op) {
+        case RXP_OP_EQUAL:
+            *symbol = "==";
+            return;
+        case RXP_OP_NOT_EQUAL:
+            *symbol = "!=";
+            return;
+        case RXP_OP_GREATER:
+            *symbol = ">";
+            return;
+        case RXP_OP_LESSER:
+            *symbol = "<";
+            return;
+        case RXP_OP_GREATER_OR_EQUAL:
+            *symbol = ">=";
+            return;
+        case RXP_OP_LESSER_OR_EQUAL:
+            *symbol = "<=";
+            return;
+        default:
+            RX_ASSERT(0);
+    }
+}
+
+static void
+rxp_op_get_name(const char **name, enum rxp_op op)
+{
+    RX_ASSERT(name != NULL);
+
+    switch (op) {
+        case RXP_OP_EQUAL:
+            *name = "equal to";
+            return;
+        case RXP_OP_NOT_EQUAL:
+            *name = "not equal to";
+            return;
+        case RXP_OP_GREATER:
+            *name = "greater than";
+            return;
+        case RXP_OP_LESSER:
+            *name = "less than";
+            return;
+        case RXP_OP_GREATER_OR_EQUAL:
+            *name = "greater than or equal to";
+            return;
+        case RXP_OP_LESSER_OR_EQUAL:
+            *name = "less than or equal to";
+            return;
+        default:
+            RX_ASSERT(0);
+    }
+}
+
+/* Implementation: String                                          O-(''Q)
+   -------------------------------------------------------------------------- */
+
+#define RXP_STR_LENGTH_ID rxp_length
+
+#define RXP_STR_CREATE_VA_LIST(STATUS, S, FMT)                                 \
+    do {                                                                       \
+        va_list args;                                                          \
+        size_t RXP_STR_LENGTH_ID;                                              \
+                                                                               \
+        (S) = NULL;                                                            \
+                                                                               \
+        va_start(args, FMT);                                                   \
+        (STATUS)                                                               \
+            = rxp_str_initialize_va_list(&RXP_STR_LENGTH_ID, S, FMT, args);    \
+        va_end(args);                                                          \
+                                                                               \
+        if ((STATUS) == RX_SUCCESS) {                                          \
+            (S) = (char *)RX_MALLOC(sizeof *(S) * RXP_STR_LENGTH_ID);          \
+            if ((S) == NULL) {                                                 \
+                RXP_LOG_DEBUG_1(                                               \
+                    "failed to allocate the string (%lu bytes)\n",             \
+                    (unsigned long)sizeof *(S) * RXP_STR_LENGTH_ID);           \
+                (STATUS) = RX_ERROR_ALLOCATION;                                \
+            } else {                                                           \
+                va_start(args, FMT);                                           \
+                (STATUS) = rxp_str_initialize_va_list(                         \
+                    &RXP_STR_LENGTH_ID, S, FMT, args);                         \
+                va_end(args);                                                  \
+                if ((STATUS) != RX_SUCCESS) {                                  \
+                    RX_FREE(S);                                                \
+                }                                                              \
+            }                                                                  \
+        }                                                                      \
+    } while (0)
+
+#define RXP_STR_CREATE_(STATUS, S, ARGS)                                       \
+    do {                                                                       \
+        size_t RXP_STR_LENGTH_ID;                                              \
+                                                                               \
+        (S) = NULL;                                                            \
+        (STATUS) = rxp_str_initialize ARGS;                                    \
+        if ((STATUS) == RX_SUCCESS) {                                          \
+            (S) = (char *)RX_MALLOC(sizeof *(S) * RXP_STR_LENGTH_ID);          \
+            if ((S) == NULL) {                                                 \
+                RXP_LOG_DEBUG_1(                                               \
+                    "failed to allocate the string (%lu bytes)\n",             \
+                    (unsigned long)sizeof *(S) * RXP_STR_LENGTH_ID);           \
+                (STATUS) = RX_ERROR_ALLOCATION;                                \
+            } else {                                                           \
+                (STATUS) = rxp_str_initialize ARGS;                            \
+                if ((STATUS) != RX_SUCCESS) {                                  \
+                    RX_FREE(S);                                                \
+                }                                                              \
+            }                                                                  \
+        }                                                                      \
+    } while (0)
+
+#define RXP_STR_CREATE(STATUS, S, MSG)                                         \
+    RXP_STR_CREATE_(STATUS, S, (&RXP_STR_LENGTH_ID, S, MSG))
+
+#define RXP_STR_CREATE_1(STATUS, S, FMT, _0)                                   \
+    RXP_STR_CREATE_(STATUS, S, (&RXP_STR_LENGTH_ID, S, FMT, _0))
+
+#define RXP_STR_CREATE_2(STATUS, S, FMT, _0, _1)                               \
+    RXP_STR_CREATE_(STATUS, S, (&RXP_STR_LENGTH_ID, S, FMT, _0, _1))
+
+#define RXP_STR_CREATE_3(STATUS, S, FMT, _0, _1, _2)                           \
+    RXP_STR_CREATE_(STATUS, S, (&RXP_STR_LENGTH_ID, S, FMT, _0, _1, _2))
+
+#define RXP_STR_CREATE_4(STATUS, S, FMT, _0, _1, _2, _3)                       \
+    RXP_STR_CREATE_(STATUS, S, (&RXP_STR_LENGTH_ID, S, FMT, _0, _1, _2, _3))
+
+enum rxp_str_case { RXP_STR_CASE_OBEY = 0, RXP_STR_CASE_IGNORE = 1 };
+
+static void
+rxp_str_case_get_type(const char **type, enum rxp_str_case str_case)
+{
+    RX_ASSERT(type != NULL);
+
+    switch (str_case) {
+        case RXP_STR_CASE_OBEY:
+            *type = "obey";
+            return;
+        case RXP_STR_CASE_IGNORE:
+            *type = "ignore";
+            return;
+        default:
+            RX_ASSERT(0);
+    }
+}
+
+RXP_PRINTF_CHECK(3, 0)
+static enum rx_status
+rxp_str_initialize_va_list(size_t *count,
+                           char *s,
+                           const char *fmt,
+                           va_list args)
+{
+    int size;
+
+    RX_ASSERT(count != NULL);
+
+    if (s == NULL) {
+#if defined(RXP_PLATFORM_WINDOWS)
+        size = _vscprintf(fmt, args);
+#elif RXP_HAS_NPRINTF
+        size = vsnprintf(NULL, 0, fmt, args);
+#else
+        {
+            FILE *file;
+            struct rxp_alloc_counters *alloc_counters;
+
+            alloc_counters = rxp_alloc_tracking_suspend();
+            file = fopen("/dev/null", "w");
+            if (file == NULL) {
+                rxp_alloc_tracking_resume(alloc_counters);
+                RXP_LOG_DEBUG("could not open `/dev/null`\n");
+                return RX_ERROR;
+            }
+
+            size = vfprintf(file, fmt, args);
+            fclose(file);
+            rxp_alloc_tracking_resume(alloc_counters);
+        }
+#endif
+
+        if (size < 0) {
+            RXP_LOG_DEBUG("invalid string formatting\n");
+            return RX_ERROR;
+        }
+
+        *count = (size_t)size + 1;
+        return RX_SUCCESS;
+    }
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#endif
+    size = vsprintf(s, fmt, args);
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+    if (size < 0) {
+        RXP_LOG_DEBUG("unexpected string formatting error\n");
+        return RX_ERROR;
+    }
+
+    *count = (size_t)size + 1;
+    return RX_SUCCESS;
+}
+
+RXP_PRINTF_CHECK(3, 4)
+static enum rx_status
+rxp_str_initialize(size_t *count, char *s, const char *fmt, ...)
+{
+    enum rx_status out;
+    va_list args;
+
+    RX_ASSERT(count != NULL);
+
+    va_start(args, fmt);
+    out = rxp_str_initialize_va_list(count, s, fmt, args);
+    va_end(args);
+
+    return out;
+}
+
+static enum rx_status
+rxp_str_copy(char **s, const char *original)
+{
+    size_t size;
+
+    size = strlen(original) + 1;
+
+    *s = (char *)RX_MALLOC(sizeof **s * size);
+    if (*s == NULL) {
+        RXP_LOG_DEBUG_1("failed to allocate the string (%lu bytes)\n",
+                        (unsigned long)sizeof **s * size);
+        return RX_ERROR_ALLOCATION;
+    }
+
+    memcpy(*s, original, size);
+    return RX_SUCCESS;
+}
+
+static enum rx_status
+rxp_str_to_uint64(rx_uint64 *value, const char *s)
+{
+    rx_uint64 out;
+
+    RX_ASSERT(value != NULL);
+    RX_ASSERT(s != NULL);
+
+    if (*s == '\0') {
+        return RX_ERROR;
+    }
+
+    out = 0;
+    for (; *s != '\0'; ++s) {
+        rx_uint64 digit;
+
+        if (!isdigit((unsigned char)*s)) {
+            return RX_ERROR;
+        }
+
+        digit = (rx_uint64)(*s - '0');
+        if (out > ((rx_uint64)-1 - digit) / 10) {
+            return RX_ERROR;
+        }
+
+        out = out * 10 + digit;
+    }
+
+    *value = out;
+    return RX_SUCCESS;
+}
+
+#define RXP_UINT64_STR_SIZE 21
+
+static void
+rxp_str_from_uint64(char *s, rx_uint64 value)
+{
+    char buf[RXP_UINT64_STR_SIZE];
+    size_t i;
+    size_t j;
+
+    RX_ASSERT(s != NULL);
+
+    i = 0;
+    do {
+        buf[i++] = (char)('0' + (int)(value % 10));
+        value /= 10;
+    } while (value > 0);
+
+    for (j = 0; j < i; ++j) {
+        s[j] = buf[i - j - 1];
+    }
+
+    s[i] = '\0';
+}
+
+/* Implementation: Helpers                                         O-(''Q)
+   -------------------------------------------------------------------------- */
+
+RXP_MAYBE_UNUSED static int
+rxp_compare_test_cases(const void *a, const void *b)
+{
+    int out;
+    const struct rx_test_case *aa;
+    const struct rx_test_case *bb;
+
+    aa = (const struct rx_test_case *)a;
+    bb = (const struct rx_test_case *)b;
+
+    out = strcmp(aa->suite_name, bb->suite_name);
+    if (out != 0) {
+        return out;
+    }
+
+    return strcmp(aa->name, bb->name);
+}
+
+RXP_MAYBE_UNUSED static int
+rxp_compare_benchmarks(const void *a, const void *b)
+{
+    int out;
+    const struct rx_benchmark *aa;
+    const struct rx_benchmark *bb;
+
+    aa = (const struct rx_benchmark *)a;
+    bb = (const struct rx_benchmark *)b;
+
+    out = strcmp(aa->suite_name, bb->suite_name);
+    if (out != 0) {
+        return out;
+    }
+
+    return strcmp(aa->name, bb->name);
+}
+
+static int
+rxp_compare_summaries_by_test_suite(const void *a, const void *b)
+{
+    const struct rx_summary *aa;
+    const struct rx_summary *bb;
+
+    aa = (const struct rx_summary *)a;
+    bb = (const struct rx_summary *)b;
+    return strcmp(aa->test_case->suite_name, bb->test_case->suite_name);
+}
+
+static void
+rxp_real_are_equal_fuzzy(int *result, rxp_real a, rxp_real b, rxp_real tol)
+{
+    rxp_real diff;
+    rxp_real abs_a;
+    rxp_real abs_b;
+
+    diff = a > b ? a - b : b - a;
+    if (diff <= tol) {
+        *result = 1;
+        return;
+    }
+
+    abs_a = a < 0 ? -a : a;
+    abs_b = b < 0 ? -b : b;
+    *result = diff <= (abs_a > abs_b ? abs_a : abs_b) * tol;
+}
+
+static void
+rxp_str_are_equal(int *result, const char *a, const char *b)
+{
+    while (*a != '\0') {
+        if (*a != *b) {
+            *result = 0;
+            return;
+        }
+
+        ++a;
+        ++b;
+    }
+
+    *result = *a == *b;
+}
+
+static void
+rxp_str_are_equal_no_case(int *result, const char *a, const char *b)
+{
+    while (*a != '\0') {
+        if (tolower(*a) != tolower(*b)) {
+            *result = 0;
+            return;
+        }
+
+        ++a;
+        ++b;
+    }
+
+    *result = tolower(*a) == tolower(*b);
+}
+
+/*
+   Append a new failure to the summary. The file can be `NULL` for failures
+   that aren't related to any specific location in the code.
+*/
+static enum rx_status
+rxp_summary_add_failure(struct rx_summary *summary,
+                        const char *file,
+                        int line,
+                        enum rx_severity severity,
+                        const char *failure_msg,
+                        const char *diagnostic_msg)
+{
+    enum rx_status status;
+    struct rx_failure *failure;
+    size_t failure_count;
+    const char *location;
+
+    RX_ASSERT(summary != NULL);
+    RX_ASSERT(summary->failures != NULL);
+
+    location = file == NULL ? "<unknown>" : file;
+
+    status
+        = rxp_test_failure_array_extend_back(&failure, &summary->failures, 1);
+    if (status != RX_SUCCESS) {
+        summary->error = "failed to extend the test failure array\0";
+        RXP_LOG_ERROR_2("failed to extend the test failure array for the test "
+                        "located at %s:%d\n",
+                        location,
+                        line);
+        return status;
+    }
+
+    rxp_test_failure_array_get_size(&failure_count, summary->failures);
+    summary->failure_count = failure_count;
+
+    if (file == NULL) {
+        failure->file = NULL;
+    } else {
+        char *buf;
+
+        status = rxp_str_copy(&buf, file);
+        if (status != RX_SUCCESS) {
+            RXP_LOG_ERROR_2("failed to allocate the file name for the test "
+                            "located at %s:%d\n",
+                            location,
+                            line);
+            failure->file = NULL;
+        } else {
+            failure->file = buf;
+        }
+    }
+
+    failure->line = line;
+    failure->severity = severity;
+
+    if (failure_msg == NULL) {
+        failure->msg = NULL;
+    } else {
+        char *buf;
+
+        status = rxp_str_copy(&buf, failure_msg);
+        if (status != RX_SUCCESS) {
+            RXP_LOG_ERROR_2("failed to allocate the failure message for "
+                            "the test located at %s:%d\n",
+                            location,
+                            line);
+            failure->msg = NULL;
+        } else {
+            failure->msg = buf;
+        }
+    }
+
+    if (diagnostic_msg == NULL) {
+        failure->diagnostic_msg = NULL;
+    } else {
+        char *buf;
+
+        status = rxp_str_copy(&buf, diagnostic_msg);
+        if (status != RX_SUCCESS) {
+            RXP_LOG_ERROR_2("failed to allocate the diagnostic message for "
+                            "the test located at %s:%d\n",
+                            location,
+                            line);
+            failure->diagnostic_msg = NULL;
+        } else {
+            failure->diagnostic_msg = buf;
+        }
+    }
+
+    return RX_SUCCESS;
+}
+
+static void
+rxp_failures_destroy(struct rx_failure *failures, size_t failure_count)
+{
+    size_t i;
+
+    RX_ASSERT(failures != NULL);
+
+    for (i = 0; i < failure_count; ++i) {
+        const struct rx_failure *failure;
+
+        failure = &failures[i];
+
+        RX_FREE((void *)(uintptr_t)failure->file);
+        RX_FREE((void *)(uintptr_t)failure->msg);
+        RX_FREE((void *)(uintptr_t)failure->diagnostic_msg);
+    }
+
+    rxp_test_failure_array_destroy(failures);
+}
+
+static void
+rxp_failures_print(const struct rx_failure *failures, size_t failure_count)
+{
+    size_t i;
+
+    RX_ASSERT(failures != NULL || failure_count == 0);
+
+    for (i = 0; i < failure_count; ++i) {
+        const struct rx_failure *failure;
+        const char *failure_msg;
+
+        failure = &failures[i];
+        failure_msg = failure->msg == NULL ? "" : failure->msg;
+
+        if (failure->file != NULL) {
+            fprintf(stderr, "%s:%d: ", failure->file, failure->line);
+        }
+
+        if (failure->diagnostic_msg != NULL) {
+            fprintf(stderr,
+                    "%s test failure: %s\n%s\n",
+                    failure->severity == RX_FATAL ? "fatal" : "nonfatal",
+                    failure_msg,
+                    failure->diagnostic_msg);
+        } else {
+            fprintf(stderr,
+                    "%s test failure: %s\n",
+                    failure->severity == RX_FATAL ? "fatal" : "nonfatal",
+                    failure_msg);
+        }
+    }
+}
+
+/* Implementation: Command-Line Arguments                          O-(''Q)
+   -------------------------------------------------------------------------- */
+
+enum rxp_arg_type {
+    RXP_ARG_NONE = 0,
+    RXP_ARG_OPTIONAL = 1,
+    RXP_ARG_REQUIRED = 2
+};
+
+/*
+   Match the argument at the given index against an option in the form
+   `--name`, `--name=value`, or `--name value`. Optional values can only be
+   passed as a separate argument if it doesn't look like another option.
+*/
+static enum rx_status
+rxp_arg_match(int *matched,
+              const char **value,
+              int *index,
+              int argc,
+              const char *const *argv,
+              const char *name,
+              enum rxp_arg_type type)
+{
+    const char *arg;
+    size_t length;
+
+    RX_ASSERT(matched != NULL);
+    RX_ASSERT(value != NULL);
+    RX_ASSERT(index != NULL);
+    RX_ASSERT(*index < argc);
+    RX_ASSERT(argv != NULL);
+    RX_ASSERT(name != NULL);
+
+    arg = argv[*index];
+    length = strlen(name);
+
+    *matched = 0;
+    *value = NULL;
+
+    if (strncmp(arg, name, length) != 0) {
+        return RX_SUCCESS;
+    }
+
+    if (arg[length] == '=') {
+        if (type == RXP_ARG_NONE) {
+            RXP_LOG_ERROR_1("the option `%s` doesn't take any value\n", name);
+            return RX_ERROR;
+        }
+
+        *matched = 1;
+        *value = &arg[length + 1];
+        return RX_SUCCESS;
+    }
+
+    if (arg[length] != '\0') {
+        return RX_SUCCESS;
+    }
+
+    *matched = 1;
+
+    if (type == RXP_ARG_NONE) {
+        return RX_SUCCESS;
+    }
+
+    if (*index + 1 < argc
+        && (type == RXP_ARG_REQUIRED || argv[*index + 1][0] != '-')) {
+        ++*index;
+        *value = argv[*index];
+        return RX_SUCCESS;
+    }
+
+    if (type == RXP_ARG_REQUIRED) {
+        RXP_LOG_ERROR_1("the option `%s` requires a value\n", name);
+        return RX_ERROR;
+    }
+
+    return RX_SUCCESS;
+}
+
+static enum rx_status
+rxp_arg_parse_uint64(rx_uint64 *out, const char *name, const char *value)
+{
+    RX_ASSERT(out != NULL);
+    RX_ASSERT(name != NULL);
+    RX_ASSERT(value != NULL);
+
+    if (rxp_str_to_uint64(out, value) != RX_SUCCESS) {
+        RXP_LOG_ERROR_2(
+            "invalid value `%s` for the option `%s`\n", value, name);
+        return RX_ERROR;
+    }
+
+    return RX_SUCCESS;
+}
+
+static enum rx_status
+rxp_arg_parse_double(double *out, const char *name, const char *value)
+{
+    char *end;
+
+    RX_ASSERT(out != NULL);
+    RX_ASSERT(name != NULL);
+    RX_ASSERT(value != NULL);
+
+    *out = strtod(value, &end);
+    if (end == value || *end != '\0' || !(*out >= 0.0)) {
+        RXP_LOG_ERROR_2(
+            "invalid value `%s` for the option `%s`\n", value, name);
+        return RX_ERROR;
+    }
+
+    return RX_SUCCESS;
+}
+
+/* Implementation: Files                                           O-(''Q)
+   -------------------------------------------------------------------------- */
+
+/*
+   Helpers to persist data across runs, such as the durations of the test
+   cases. Files are always written to a temporary location first and then
+   moved over the destination, so that readers never observe partial
+   content.
+*/
+
+static enum rx_status
+rxp_file_read_line(int *found, char **line, size_t *capacity, FILE *file)
+{
+    size_t length;
+
+    RX_ASSERT(found != NULL);
+    RX_ASSERT(line != NULL);
+    RX_ASSERT(capacity != NULL);
+    RX_ASSERT(file != NULL);
+
+    *found = 0;
+    length = 0;
+
+    for (;;) {
+        if (*line == NULL || *capacity - length < 2) {
+            char *buf;
+            size_t new_capacity;
+
+            new_capacity = *capacity == 0 ? 256 : *capacity * 2;
+            buf = (char *)RX_REALLOC(*line, sizeof *buf * new_capacity);
+            if (buf == NULL) {
+                RXP_LOG_DEBUG_1("failed to allocate the line buffer "
+                                "(%lu bytes)\n",
+                                (unsigned long)sizeof *buf * new_capacity);
+                return RX_ERROR_ALLOCATION;
+            }
+
+            *line = buf;
+            *capacity = new_capacity;
+        }
+
+        if (fgets(&(*line)[length], (int)(*capacity - length), file)
+            == NULL) {
+            if (length > 0) {
+                *found = 1;
+            }
+
+            return ferror(file) ? RX_ERROR : RX_SUCCESS;
+        }
+
+        length += strlen(&(*line)[length]);
+        if (length > 0 && (*line)[length - 1] == '\n') {
+            (*line)[length - 1] = '\0';
+            if (length > 1 && (*line)[length - 2] == '\r') {
+                (*line)[length - 2] = '\0';
+            }
+
+            *found = 1;
+            return RX_SUCCESS;
+        }
+    }
+}
+
+static enum rx_status
+rxp_file_open_temporary(FILE **file, char **temporary_path, const char *path)
+{
+    enum rx_status status;
+    unsigned long pid;
+
+    RX_ASSERT(file != NULL);
+    RX_ASSERT(temporary_path != NULL);
+    RX_ASSERT(path != NULL);
+
+#if defined(RXP_PLATFORM_WINDOWS)
+    pid = (unsigned long)GetCurrentProcessId();
+#elif defined(RXP_PLATFORM_UNIX)
+    pid = (unsigned long)getpid();
+#else
+    pid = 0;
+#endif
+
+    RXP_STR_CREATE_2(status, *temporary_path, "%s.%lu.tmp", path, pid);
+    if (status != RX_SUCCESS) {
+        return status;
+    }
+
+    *file = fopen(*temporary_path, "w");
+    if (*file == NULL) {
+        RXP_LOG_ERROR_1("could not open the file `%s` for writing\n",
+                        *temporary_path);
+        RX_FREE(*temporary_path);
+        *temporary_path = NULL;
+        return RX_ERROR;
+    }
+
+    return RX_SUCCESS;
+}
+
+static enum rx_status
+rxp_file_commit_temporary(FILE *file, char *temporary_path, const char *path)
+{
+    int failed;
+
+    RX_ASSERT(file != NULL);
+    RX_ASSERT(temporary_path != NULL);
+    RX_ASSERT(path != NULL);
+
+    failed = ferror(file) != 0;
+    failed |= fclose(file) != 0;
+
+    if (!failed) {
+#if defined(RXP_PLATFORM_WINDOWS)
+        failed = !MoveFileExA(
+            temporary_path, path, MOVEFILE_REPLACE_EXISTING);
+#else
+        failed = rename(temporary_path, path) != 0;
+#endif
+    }
+
+    if (failed) {
+        RXP_LOG_ERROR_1("could not write the file `%s`\n", path);
+        remove(temporary_path);
+    }
+
+    RX_FREE(temporary_path);
+    return failed ? RX_ERROR : RX_SUCCESS;
+}
+
+/* Implementation: Records                                         O-(''Q)
+   -------------------------------------------------------------------------- */
+
+/*
+   Values attached to test cases and persisted across runs, keyed by the test
+   suite and test case names, such as their durations. They are stored in
+   a text file with one line per test case, each made of the test suite name,
+   the test case name, and the value, separated by tabs.
+*/
+
+struct rxp_record {
+    char *suite_name;
+    char *name;
+    rx_uint64 value;
+    size_t sequence;
+};
+
+struct rxp_records {
+    size_t count;
+    size_t sorted_count;
+    size_t capacity;
+    size_t next_sequence;
+    struct rxp_record *array;
+};
+
+static int
+rxp_compare_record_keys(const void *a, const void *b)
+{
+    int out;
+    const struct rxp_record *aa;
+    const struct rxp_record *bb;
+
+    aa = (const struct rxp_record *)a;
+    bb = (const struct rxp_record *)b;
+
+    out = strcmp(aa->suite_name, bb->suite_name);
+    if (out != 0) {
+        return out;
+    }
+
+    return strcmp(aa->name, bb->name);
+}
+
+static int
+rxp_compare_records(const void *a, const void *b)
+{
+    int out;
+    const struct rxp_record *aa;
+    const struct rxp_record *bb;
+
+    out = rxp_compare_record_keys(a, b);
+    if (out != 0) {
+        return out;
+    }
+
+    aa = (const struct rxp_record *)a;
+    bb = (const struct rxp_record *)b;
+    return (aa->sequence > bb->sequence) - (aa->sequence < bb->sequence);
+}
+
+static void
+rxp_records_initialize(struct rxp_records *records)
+{
+    RX_ASSERT(records != NULL);
+
+    memset(records, 0, sizeof *records);
+}
+
+static void
+rxp_records_terminate(struct rxp_records *records)
+{
+    size_t i;
+
+    RX_ASSERT(records != NULL);
+
+    for (i = 0; i < records->count; ++i) {
+        RX_FREE(records->array[i].suite_name);
+        RX_FREE(records->array[i].name);
+    }
+
+    RX_FREE(records->array);
+    memset(records, 0, sizeof *records);
+}
+
+/*
+   Sort the records and, if some were set more than once while not being
+   sorted, only keep the last value set.
+*/
+static void
+rxp_records_sort(struct rxp_records *records)
+{
+    size_t i;
+    size_t count;
+
+    RX_ASSERT(records != NULL);
+
+    if (records->count == 0) {
+        records->sorted_count = 0;
+        return;
+    }
+
+    qsort(records->array,
+          records->count,
+          sizeof *records->array,
+          rxp_compare_records);
+
+    count = 0;
+    for (i = 0; i < records->count; ++i) {
+        if (i + 1 < records->count
+            && rxp_compare_record_keys(&records->array[i],
+                                       &records->array[i + 1])
+                   == 0) {
+            RX_FREE(records->array[i].suite_name);
+            RX_FREE(records->array[i].name);
+            continue;
+        }
+
+        records->array[count++] = records->array[i];
+    }
+
+    records->count = count;
+    records->sorted_count = count;
+}
+
+static void
+rxp_records_find(struct rxp_record **record,
+                 const struct rxp_records *records,
+                 const char *suite_name,
+                 const char *name)
+{
+    struct rxp_record key;
+
+    RX_ASSERT(record != NULL);
+    RX_ASSERT(records != NULL);
+    RX_ASSERT(suite_name != NULL);
+    RX_ASSERT(name != NULL);
+
+    *record = NULL;
+
+    if (records->sorted_count == 0) {
+        return;
+    }
+
+    key.suite_name = (char *)(uintptr_t)suite_name;
+    key.name = (char *)(uintptr_t)name;
+    *record = (struct rxp_record *)bsearch(&key,
+                                           records->array,
+                                           records->sorted_count,
+                                           sizeof *records->array,
+                                           rxp_compare_record_keys);
+}
+
+/*
+   Set the value of a test case. New entries are appended past the sorted
+   range and can't be found until the records are sorted again.
+*/
+static enum rx_status
+rxp_records_set(struct rxp_records *records,
+                const char *suite_name,
+                const char *name,
+                rx_uint64 value)
+{
+    enum rx_status status;
+    struct rxp_record *record;
+
+    RX_ASSERT(records != NULL);
+
+    rxp_records_find(&record, records, suite_name, name);
+    if (record != NULL) {
+        record->value = value;
+        return RX_SUCCESS;
+    }
+
+    if (records->count == records->capacity) {
+        struct rxp_record *array;
+        size_t capacity;
+
+        capacity = records->capacity + records->capacity / 2 + 16;
+        array = (struct rxp_record *)RX_REALLOC(
+            records->array, sizeof *array * capacity);
+        if (array == NULL) {
+            RXP_LOG_DEBUG("failed to allocate the records\n");
+            return RX_ERROR_ALLOCATION;
+        }
+
+        records->array = array;
+        records->capacity = capacity;
+    }
+
+    record = &records->array[records->count];
+
+    status = rxp_str_copy(&record->suite_name, suite_name);
+    if (status != RX_SUCCESS) {
+        return status;
+    }
+
+    status = rxp_str_copy(&record->name, name);
+    if (status != RX_SUCCESS) {
+        RX_FREE(record->suite_name);
+        return status;
+    }
+
+    record->value = value;
+    record->sequence = records->next_sequence++;
+    ++records->count;
+    return RX_SUCCESS;
+}
+
+static void
+rxp_records_remove(struct rxp_records *records,
+                   const char *suite_name,
+                   const char *name)
+{
+    struct rxp_record *record;
+    size_t index;
+
+    RX_ASSERT(records != NULL);
+
+    rxp_records_find(&record, records, suite_name, name);
+    if (record == NULL) {
+        return;
+    }
+
+    index = (size_t)(record - records->array);
+    RX_FREE(record->suite_name);
+    RX_FREE(record->name);
+    memmove(record,
+            record + 1,
+            sizeof *record * (records->count - index - 1));
+    --records->count;
+    --records->sorted_count;
+}
+
+/*
+   Load the records stored at the given path, if any. Lines that can't be
+   parsed are ignored.
+*/
+static enum rx_status
+rxp_records_load(struct rxp_records *records, const char *path)
+{
+    enum rx_status status;
+    FILE *file;
+    char *line;
+    size_t capacity;
+
+    RX_ASSERT(records != NULL);
+    RX_ASSERT(path != NULL);
+
+    file = fopen(path, "r");
+    if (file == NULL) {
+        RXP_LOG_DEBUG_1("no records found at `%s`\n", path);
+        return RX_SUCCESS;
+    }
+
+    line = NULL;
+    capacity = 0;
+
+    for (;;) {
+        int found;
+        char *name;
+        char *value_str;
+        rx_uint64 value;
+
+        status = rxp_file_read_line(&found, &line, &capacity, file);
+        if (status != RX_SUCCESS || !found) {
+            break;
+        }
+
+        name = strchr(line, '\t');
+        if (name == NULL) {
+            continue;
+        }
+
+        *name++ = '\0';
+
+        value_str = strchr(name, '\t');
+        if (value_str == NULL) {
+            continue;
+        }
+
+        *value_str++ = '\0';
+
+        if (rxp_str_to_uint64(&value, value_str) != RX_SUCCESS) {
+            continue;
+        }
+
+        status = rxp_records_set(records, line, name, value);
+        if (status != RX_SUCCESS) {
+            break;
+        }
+    }
+
+    RX_FREE(line);
+    fclose(file);
+
+    rxp_records_sort(records);
+
+    if (status != RX_SUCCESS) {
+        RXP_LOG_ERROR_1("failed to load the records from `%s`\n", path);
+    }
+
+    return status;
+}
+
+static enum rx_status
+rxp_records_save(struct rxp_records *records, const char *path)
+{
+    enum rx_status status;
+    FILE *file;
+    char *temporary_path;
+    size_t i;
+
+    RX_ASSERT(records != NULL);
+    RX_ASSERT(path != NULL);
+
+    rxp_records_sort(records);
+
+    status = rxp_file_open_temporary(&file, &temporary_path, path);
+    if (status != RX_SUCCESS) {
+        return status;
+    }
+
+    for (i = 0; i < records->count; ++i) {
+        const struct rxp_record *record;
+        char value[RXP_UINT64_STR_SIZE];
+
+        record = &records->array[i];
+        rxp_str_from_uint64(value, record->value);
+        fprintf(file,
+                "%s\t%s\t%s\n",
+                record->suite_name,
+                record->name,
+                value);
+    }
+
+    return rxp_file_commit_temporary(file, temporary_path, path);
+}
+
+/* Implementation: Profiler                                        O-(''Q)
+   -------------------------------------------------------------------------- */
+
+/*
+   The profiler samples the call stack of the thread running a test case each
+   time that this thread consumes another millisecond of CPU time. A CPU-time
+   timer created for that thread only delivers `SIGPROF` to it, and the signal
+   handler copies the stack with `backtrace()` into a ring of samples allocated
+   beforehand, without taking any lock nor allocating. The samples are then
+   folded into one line per distinct stack, as read by the flame graph tools.
+
+   The timers are created through the raw system calls, which don't require
+   linking against the real-time library with older versions of glibc.
+*/
+
+#if !defined(RX_DISABLE_PROFILER) && defined(RXP_PLATFORM_LINUX)               \
+    && defined(__GLIBC__) && defined(__GNUC__)
+#include <errno.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__NR_timer_create) && defined(__NR_timer_settime)                 \
+    && defined(__NR_timer_delete) && defined(__NR_gettid)                      \
+    && defined(CLOCK_THREAD_CPUTIME_ID)
+#define RXP_PROFILER 1
+#endif
+#endif
+
+#if !defined(RXP_PROFILER)
+#define RXP_PROFILER 0
+#endif
+
+#define RXP_PROFILE_INTERVAL 1000000
+#define RXP_PROFILE_MAX_DEPTH 64
+#define RXP_PROFILE_MAX_SAMPLE_COUNT 4096
+
+/* The signal handler and the signal trampoline top each stack sampled. */
+#define RXP_PROFILE_SKIPPED_DEPTH 2
+
+struct rxp_profile_sample {
+    int depth;
+    void *frames[RXP_PROFILE_MAX_DEPTH];
+};
+
+struct rxp_profile {
+    struct rxp_profile_sample *samples;
+    volatile size_t count;
+    int timer;
+};
+
+#if RXP_PROFILER
+#if !defined(SIGEV_THREAD_ID)
+#define SIGEV_THREAD_ID 4
+#endif
+
+static __thread struct rxp_profile *volatile rxp_profile_current;
+static struct sigaction rxp_profiler_old_action;
+
+/*
+   Once the ring is full, the oldest samples are overwritten, which keeps
+   the last few seconds of CPU time of the longer test cases.
+*/
+static void
+rxp_profiler_handle_signal(int signal_number)
+{
+    struct rxp_profile *profile;
+    struct rxp_profile_sample *sample;
+    int saved_errno;
+
+    RXP_UNUSED(signal_number);
+
+    profile = rxp_profile_current;
+    if (profile == NULL) {
+        return;
+    }
+
+    saved_errno = errno;
+    sample = &profile->samples[profile->count % RXP_PROFILE_MAX_SAMPLE_COUNT];
+    sample->depth = backtrace(sample->frames, RXP_PROFILE_MAX_DEPTH);
+    ++profile->count;
+    errno = saved_errno;
+}
+
+static enum rx_status
+rxp_profiler_install(void)
+{
+    struct sigaction action;
+    void *frame;
+
+    /* The first call to `backtrace()` loads the unwinder, which allocates and
+       thus can't happen within the signal handler. */
+    backtrace(&frame, 1);
+
+    memset(&action, 0, sizeof action);
+    action.sa_handler = rxp_profiler_handle_signal;
+    sigemptyset(&action.sa_mask);
+#if defined(SA_RESTART)
+    action.sa_flags = SA_RESTART;
+#endif
+
+    if (sigaction(SIGPROF, &action, &rxp_profiler_old_action) != 0) {
+        RXP_LOG_DEBUG("failed to install the profiler's signal handler\n");
+        return RX_ERROR;
+    }
+
+    return RX_SUCCESS;
+}
+
+static void
+rxp_profiler_uninstall(void)
+{
+    sigaction(SIGPROF, &rxp_profiler_old_action, NULL);
+}
+
+static enum rx_status
+rxp_profile_start(struct rxp_profile *profile)
+{
+    struct sigevent event;
+    struct itimerspec spec;
+
+    RX_ASSERT(profile != NULL);
+
+    profile->samples = (struct rxp_profile_sample *)RX_MALLOC(
+        sizeof *profile->samples * RXP_PROFILE_MAX_SAMPLE_COUNT);
+    if (profile->samples == NULL) {
+        RXP_LOG_DEBUG("failed to allocate the profile samples\n");
+        return RX_ERROR_ALLOCATION;
+    }
+
+    profile->count = 0;
+
+    memset(&event, 0, sizeof event);
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = SIGPROF;
+    event._sigev_un._tid = (pid_t)syscall(__NR_gettid);
+
+    if (syscall(__NR_timer_create,
+                CLOCK_THREAD_CPUTIME_ID,
+                &event,
+                &profile->timer)
+        != 0) {
+        RXP_LOG_DEBUG("failed to create the profiler's timer\n");
+        RX_FREE(profile->samples);
+        return RX_ERROR;
+    }
+
+    rxp_profile_current = profile;
+
+    spec.it_interval.tv_sec = 0;
+    spec.it_interval.tv_nsec = RXP_PROFILE_INTERVAL;
+    spec.it_value = spec.it_interval;
+    if (syscall(__NR_timer_settime, profile->timer, 0, &spec, NULL) != 0) {
+        RXP_LOG_DEBUG("failed to start the profiler's timer\n");
+        rxp_profile_current = NULL;
+        syscall(__NR_timer_delete, profile->timer);
+        RX_FREE(profile->samples);
+        return RX_ERROR;
+    }
+
+    return RX_SUCCESS;
+}
+
+static void
+rxp_profile_stop(struct rxp_profile *profile)
+{
+    RX_ASSERT(profile != NULL);
+
+    syscall(__NR_timer_delete, profile->timer);
+    rxp_profile_current = NULL;
+}
+
+static int
+rxp_profile_sample_compare(const void *a, const void *b)
+{
+    const struct rxp_profile_sample *sample_a;
+    const struct rxp_profile_sample *sample_b;
+    int i;
+
+    sample_a = (const struct rxp_profile_sample *)a;
+    sample_b = (const struct rxp_profile_sample *)b;
+
+    if (sample_a->depth != sample_b->depth) {
+        return sample_a->depth < sample_b->depth ? -1 : 1;
+    }
+
+    for (i = 0; i < sample_a->depth; ++i) {
+        if (sample_a->frames[i] != sample_b->frames[i]) {
+            return (uintptr_t)sample_a->frames[i]
+                           < (uintptr_t)sample_b->frames[i]
+                       ? -1
+                       : 1;
+        }
+    }
+
+    return 0;
+}
+
+/*
+   The symbols returned by `backtrace_symbols()` look like
+   `module(function+0x2a) [0x401234]`, with the function being left empty
+   when it isn't exported, in which case the module's base name and
+   the offset within that module are written instead.
+*/
+static void
+rxp_profile_frame_write(FILE *file, const char *symbol)
+{
+    const char *open;
+    const char *close;
+    const char *base;
+
+    RX_ASSERT(file != NULL);
+    RX_ASSERT(symbol != NULL);
+
+    open = strchr(symbol, '(');
+    close = open != NULL ? strchr(open, ')') : NULL;
+    if (open == NULL || close == NULL) {
+        fputs(symbol, file);
+        return;
+    }
+
+    if (open[1] != '+' && open[1] != ')') {
+        const char *end;
+
+        end = strchr(open, '+');
+        if (end == NULL || end > close) {
+            end = close;
+        }
+
+        fwrite(open + 1, 1, (size_t)(end - open - 1), file);
+        return;
+    }
+
+    base = open;
+    while (base > symbol && base[-1] != '/') {
+        --base;
+    }
+
+    fwrite(base, 1, (size_t)(open - base), file);
+    fwrite(open + 1, 1, (size_t)(close - open - 1), file);
+}
+
+static void
+rxp_profile_stack_write(FILE *file, const struct rxp_profile_sample *sample)
+{
+    int depth;
+    int i;
+    char **symbols;
+
+    RX_ASSERT(file != NULL);
+    RX_ASSERT(sample != NULL);
+
+    depth = sample->depth - RXP_PROFILE_SKIPPED_DEPTH;
+    if (depth <= 0) {
+        fputs("[unknown]", file);
+        return;
+    }
+
+    symbols = backtrace_symbols(sample->frames + RXP_PROFILE_SKIPPED_DEPTH,
+                                depth);
+
+    /* The folded stacks start from the outermost frame. */
+    for (i = depth - 1; i >= 0; --i) {
+        if (symbols != NULL) {
+            rxp_profile_frame_write(file, symbols[i]);
+        } else {
+            fprintf(file,
+                    "0x%lx",
+                    (unsigned long)(uintptr_t)
+                        sample->frames[RXP_PROFILE_SKIPPED_DEPTH + i]);
+        }
+
+        if (i > 0) {
+            fputc(';', file);
+        }
+    }
+
+    free(symbols);
+}
+
+static enum rx_status
+rxp_profile_write(struct rxp_profile *profile,
+                  const char *directory,
+                  const struct rx_test_case *test_case)
+{
+    enum rx_status status;
+    char *path;
+    FILE *file;
+    size_t count;
+    size_t i;
+    size_t j;
+
+    RX_ASSERT(profile != NULL);
+    RX_ASSERT(directory != NULL);
+    RX_ASSERT(test_case != NULL);
+
+    RXP_STR_CREATE_3(status,
+                     path,
+                     "%s/%s.%s.folded",
+                     directory,
+                     test_case->suite_name,
+                     test_case->name);
+    if (status != RX_SUCCESS) {
+        RXP_LOG_DEBUG("failed to create the profile's path\n");
+        return status;
+    }
+
+    file = fopen(path, "w");
+    if (file == NULL) {
+        RXP_LOG_DEBUG_1("failed to open the file `%s`\n", path);
+        RX_FREE(path);
+        return RX_ERROR;
+    }
+
+    count = profile->count < RXP_PROFILE_MAX_SAMPLE_COUNT
+                ? profile->count
+                : RXP_PROFILE_MAX_SAMPLE_COUNT;
+
+    /* Sorting the samples brings the identical stacks next to each other. */
+    qsort(profile->samples,
+          count,
+          sizeof *profile->samples,
+          rxp_profile_sample_compare);
+
+    for (i = 0; i < count; i = j) {
+        j = i + 1;
+        while (j < count
+               && rxp_profile_sample_compare(&profile->samples[i],
+                                             &profile->samples[j])
+                      == 0) {
+            ++j;
+        }
+
+        rxp_profile_stack_write(file, &profile->samples[i]);
+        fprintf(file, " %lu\n", (unsigned long)(j - i));
+    }
+
+    status = ferror(file) ? RX_ERROR : RX_SUCCESS;
+    if (fclose(file) != 0) {
+        status = RX_ERROR;
+    }
+
+    if (status != RX_SUCCESS) {
+        RXP_LOG_DEBUG_1("failed to write the file `%s`\n", path);
+    }
+
+    RX_FREE(path);
+    return status;
+}
+
+static void
+rxp_profile_terminate(struct rxp_profile *profile)
+{
+    RX_ASSERT(profile != NULL);
+
+    RX_FREE(profile->samples);
+}
+#else
+static enum rx_status
+rxp_profiler_install(void)
+{
+    return RX_ERROR;
+}
+
+static void
+rxp_profiler_uninstall(void)
+{
+}
+
+static enum rx_status
+rxp_profile_start(struct rxp_profile *profile)
+{
+    RXP_UNUSED(profile);
+
+    return RX_ERROR;
+}
+
+static void
+rxp_profile_stop(struct rxp_profile *profile)
+{
+    RXP_UNUSED(profile);
+}
+
+static enum rx_status
+rxp_profile_write(struct rxp_profile *profile,
+                  const char *directory,
+                  const struct rx_test_case *test_case)
+{
+    RXP_UNUSED(profile);
+    RXP_UNUSED(directory);
+    RXP_UNUSED(test_case);
+
+    return RX_ERROR;
+}
+
+static void
+rxp_profile_terminate(struct rxp_profile *profile)
+{
+    RXP_UNUSED(profile);
+}
+#endif
+
+/* Implementation: Test Case Run                                   O-(''Q)
+   -------------------------------------------------------------------------- */
+
+static enum rx_status
+rxp_test_case_run(struct rx_summary *summary,
+                  const struct rx_test_case *test_case,
+                  const void *suite_data,
+                  int perf_counters,
+                  const char *profile_path)
+{
+    enum rx_status status;
+    struct rx_context context;
+    void *data;
+    struct rxp_phase_clock clock;
+    struct rxp_perf_group perf_group;
+    struct rxp_profile profile;
+    int profiling;
+    struct rxp_resource_snapshot resources_begin;
+    struct rxp_resource_snapshot resources_end;
+    int resources_measured;
+    struct rxp_alloc_counters alloc_counters;
+
+    RX_ASSERT(summary != NULL);
+    RX_ASSERT(test_case != NULL);
+    RX_ASSERT(test_case->suite_name != NULL);
+    RX_ASSERT(test_case->name != NULL);
+    RX_ASSERT(test_case->run != NULL);
+
+    if (test_case->config.skip) {
+        summary->skipped = 1;
+        return RX_SUCCESS;
+    }
+
+    status = RX_SUCCESS;
+    context.summary = summary;
+    context.suite_data = suite_data;
+    context.benchmark_arg = 0;
+    context.benchmark_timing.timer = NULL;
+    context.alloc_scope.active = 0;
+
+    if (test_case->config.fixture.size > 0) {
+        data = RX_MALLOC(test_case->config.fixture.size);
+        if (data == NULL) {
+            summary->error = "failed to allocate the data\0";
+            RXP_LOG_ERROR_2("failed to allocate the data"
+                            "(suite: \"%s\", case: \"%s\")\n",
+                            test_case->suite_name,
+                            test_case->name);
+            return RX_ERROR_ALLOCATION;
+        }
+    } else {
+        data = NULL;
+    }
+
+    if (test_case->config.fixture.config.set_up != NULL) {
+        rxp_phase_clock_begin(&clock);
+        status = test_case->config.fixture.config.set_up(&context, data);
+        rxp_phase_clock_end(&summary->wall_time.set_up,
+                            &summary->cpu_time.set_up,
+                            &summary->wall_time.set_up_available,
+                            &summary->cpu_time.set_up_available,
+                            &clock);
+        if (status != RX_SUCCESS) {
+            summary->error = "failed to set-up the fixture\0";
+            RXP_LOG_ERROR_2("failed to set-up the fixture "
+                            "(suite: \"%s\", case: \"%s\")\n",
+                            test_case->suite_name,
+                            test_case->name);
+            goto data_cleanup;
+        }
+    }
+
+    /* The profiler and the performance counters are set up before taking
+       the resource usage snapshot, and torn down after, for their own cost
+       not to be reported as the test case's. */
+    if (perf_counters && rxp_perf_group_open(&perf_group) != RX_SUCCESS) {
+        perf_counters = 0;
+    }
+
+    profiling = 0;
+    if (profile_path != NULL) {
+        profiling = rxp_profile_start(&profile) == RX_SUCCESS;
+        if (!profiling) {
+            RXP_LOG_WARNING_2("failed to start the profiler "
+                              "(suite: \"%s\", case: \"%s\")\n",
+                              test_case->suite_name,
+                              test_case->name);
+        }
+    }
+
+    resources_measured = rxp_resource_snapshot_take(&resources_begin)
+                         == RX_SUCCESS;
+
+    if (perf_counters && rxp_perf_group_start(&perf_group) != RX_SUCCESS) {
+        rxp_perf_group_close(&perf_group);
+        perf_counters = 0;
+    }
+
+    rxp_alloc_tracking_begin(&alloc_counters);
+    rxp_phase_clock_begin(&clock);
+
+    if (setjmp(context.env) == 0) {
+        test_case->run(&context, data);
+    }
+
+    rxp_phase_clock_end(&summary->wall_time.run,
+                        &summary->cpu_time.run,
+                        &summary->wall_time.run_available,
+                        &summary->cpu_time.run_available,
+                        &clock);
+    rxp_alloc_tracking_end(&summary->alloc_stats, &alloc_counters);
+
+    if (perf_counters
+        && rxp_perf_group_stop(&summary->perf_counters, &perf_group)
+               != RX_SUCCESS) {
+        RXP_LOG_WARNING_2("failed to read the performance counters "
+                          "(suite: \"%s\", case: \"%s\")\n",
+                          test_case->suite_name,
+                          test_case->name);
+    }
+
+    if (profiling) {
+        rxp_profile_stop(&profile);
+    }
+
+    if (resources_measured
+        && rxp_resource_snapshot_take(&resources_end) == RX_SUCCESS) {
+        rxp_resource_usage_compute(
+            &summary->resource_usage, &resources_begin, &resources_end);
+    }
+
+    if (profiling) {
+        if (rxp_profile_write(&profile, profile_path, test_case)
+            != RX_SUCCESS) {
+            RXP_LOG_WARNING_2("failed to write the profile "
+                              "(suite: \"%s\", case: \"%s\")\n",
+                              test_case->suite_name,
+                              test_case->name);
+        }
+
+        rxp_profile_terminate(&profile);
+    }
+
+    if (perf_counters) {
+        rxp_perf_group_close(&perf_group);
+    }
+
+    if (!summary->wall_time.run_available) {
+        RXP_LOG_ERROR_2("failed to measure the time elapsed "
+                        "(suite: \"%s\", case: \"%s\")\n",
+                        test_case->suite_name,
+                        test_case->name);
+    }
+
+    summary->elapsed = summary->wall_time.run;
+
+    if (test_case->config.fixture.config.tear_down != NULL) {
+        rxp_phase_clock_begin(&clock);
+        test_case->config.fixture.config.tear_down(&context, data);
+        rxp_phase_clock_end(&summary->wall_time.tear_down,
+                            &summary->cpu_time.tear_down,
+                            &summary->wall_time.tear_down_available,
+                            &summary->cpu_time.tear_down_available,
+                            &clock);
+    }
+
+data_cleanup:
+    RX_FREE(data);
+    return status;
+}
+
+/*
+   Suite fixtures are set up once before the first test case referencing them
+   and torn down after the last one, with their data being shared read-only
+   across all these test cases. The test cases sharing a same instance are
+   grouped beforehand, so that the runner knows when the last one completes.
+*/
+
+enum rxp_suite_fixture_state {
+    RXP_SUITE_FIXTURE_PENDING = 0,
+    RXP_SUITE_FIXTURE_SETTING_UP = 1,
+    RXP_SUITE_FIXTURE_READY = 2,
+    RXP_SUITE_FIXTURE_FAILED = 3,
+    RXP_SUITE_FIXTURE_TORN_DOWN = 4
+};
+
+struct rxp_suite_fixture {
+    const struct rx_test_case *test_case;
+    size_t remaining;
+    enum rxp_suite_fixture_state state;
+    void *data;
+#if RXP_THREADS
+    rxp_mutex mutex;
+#endif
+};
+
+struct rxp_suite_fixtures {
+    size_t count;
+    struct rxp_suite_fixture *array;
+    size_t *indices;
+};
+
+#define RXP_SUITE_FIXTURE_NONE ((size_t)-1)
+
+static int
+rxp_test_case_has_suite_fixture(const struct rx_test_case *test_case)
+{
+    RX_ASSERT(test_case != NULL);
+
+    return !test_case->config.skip
+           && (test_case->config.suite_fixture.size > 0
+               || test_case->config.suite_fixture.config.set_up != NULL
+               || test_case->config.suite_fixture.config.tear_down != NULL);
+}
+
+static int
+rxp_test_cases_share_suite_fixture(const struct rx_test_case *a,
+                                   const struct rx_test_case *b)
+{
+    const struct rx_fixture *fixture_a;
+    const struct rx_fixture *fixture_b;
+
+    RX_ASSERT(a != NULL);
+    RX_ASSERT(b != NULL);
+
+    fixture_a = &a->config.suite_fixture;
+    fixture_b = &b->config.suite_fixture;
+    return strcmp(a->suite_name, b->suite_name) == 0
+           && fixture_a->size == fixture_b->size
+           && fixture_a->config.set_up == fixture_b->config.set_up
+           && fixture_a->config.tear_down == fixture_b->config.tear_down;
+}
+
+/*
+   Call the set up or the tear down function of a suite fixture with
+   a context reporting to the given summary. Nothing that is modified past
+   the `setjmp()` call is read after a fatal failure jumps back to it.
+*/
+static enum rx_status
+rxp_suite_fixture_call(struct rx_summary *summary,
+                       const struct rx_fixture_config *config,
+                       int set_up,
+                       void *data)
+{
+    struct rx_context context;
+
+    RX_ASSERT(summary != NULL);
+    RX_ASSERT(config != NULL);
+
+    memset(&context, 0, sizeof context);
+    context.summary = summary;
+
+    if (setjmp(context.env) != 0) {
+        return RX_ERROR_ABORTED;
+    }
+
+    if (set_up) {
+        return config->set_up(&context, data);
+    }
+
+    config->tear_down(&context, data);
+    return RX_SUCCESS;
+}
+
+/*
+   Run the set up or the tear down of a suite fixture, with the assessments
+   made within it being printed since there is no test case to report them
+   to. Any failed assessment fails the set up.
+*/
+static enum rx_status
+rxp_suite_fixture_run(const struct rx_test_case *test_case,
+                      int set_up,
+                      void *data)
+{
+    enum rx_status status;
+    struct rx_summary summary;
+
+    RX_ASSERT(test_case != NULL);
+
+    status = rx_summary_initialize(&summary, test_case);
+    if (status != RX_SUCCESS) {
+        RXP_LOG_ERROR_1("failed to initialize the summary of the suite "
+                        "fixture (suite: \"%s\")\n",
+                        test_case->suite_name);
+        return status;
+    }
+
+    status = rxp_suite_fixture_call(
+        &summary, &test_case->config.suite_fixture.config, set_up, data);
+
+    if (summary.failure_count > 0) {
+        fprintf(stderr,
+                "assessments failed within the %s of the suite fixture "
+                "(suite: \"%s\")\n",
+                set_up ? "set up" : "tear down",
+                test_case->suite_name);
+        rxp_failures_print(summary.failures, summary.failure_count);
+
+        if (status == RX_SUCCESS) {
+            status = RX_ERROR_ABORTED;
+        }
+    }
+
+    rx_summary_terminate(&summary);
+    return status;
+}
+
+static enum rx_status
+rxp_suite_fixture_set_up(void **data, const struct rx_test_case *test_case)
+{
+    enum rx_status status;
+    const struct rx_fixture *fixture;
+
+    RX_ASSERT(data != NULL);
+    RX_ASSERT(test_case != NULL);
+
+    fixture = &test_case->config.suite_fixture;
+
+    if (fixture->size > 0) {
+        *data = RX_MALLOC(fixture->size);
+        if (*data == NULL) {
+            RXP_LOG_ERROR_1("failed to allocate the suite data "
+                            "(suite: \"%s\")\n",
+                            test_case->suite_name);
+            return RX_ERROR_ALLOCATION;
+        }
+    } else {
+        *data = NULL;
+    }
+
+    if (fixture->config.set_up != NULL) {
+        status = rxp_suite_fixture_run(test_case, 1, *data);
+        if (status != RX_SUCCESS) {
+            RXP_LOG_ERROR_1("failed to set-up the suite fixture "
+                            "(suite: \"%s\")\n",
+                            test_case->suite_name);
+            RX_FREE(*data);
+            return status;
+        }
+    }
+
+    return RX_SUCCESS;
+}
+
+static void
+rxp_suite_fixture_tear_down(const struct rx_test_case *test_case, void *data)
+{
+    RX_ASSERT(test_case != NULL);
+
+    if (test_case->config.suite_fixture.config.tear_down != NULL) {
+        rxp_suite_fixture_run(test_case, 0, data);
+    }
+
+    RX_FREE(data);
+}
+
+static enum rx_status
+rxp_suite_fixtures_initialize(struct rxp_suite_fixtures *fixtures,
+                              size_t test_case_count,
+                              const struct rx_test_case *test_cases)
+{
+    size_t i;
+    size_t j;
+
+    RX_ASSERT(fixtures != NULL);
+
+    memset(fixtures, 0, sizeof *fixtures);
+
+    for (i = 0; i < test_case_count; ++i) {
+        if (rxp_test_case_has_suite_fixture(&test_cases[i])) {
+            break;
+        }
+    }
+
+    if (i == test_case_count) {
+        return RX_SUCCESS;
+    }
+
+    fixtures->array = (struct rxp_suite_fixture *)RX_MALLOC(
+        sizeof *fixtures->array * test_case_count);
+    if (fixtures->array == NULL) {
+        RXP_LOG_DEBUG("failed to allocate the suite fixtures\n");
+        return RX_ERROR_ALLOCATION;
+    }
+
+    fixtures->indices
+        = (size_t *)RX_MALLOC(sizeof *fixtures->indices * test_case_count);
+    if (fixtures->indices == NULL) {
+        RXP_LOG_DEBUG("failed to allocate the suite fixture indices\n");
+        RX_FREE(fixtures->array);
+        fixtures->array = NULL;
+        return RX_ERROR_ALLOCATION;
+    }
+
+    for (i = 0; i < test_case_count; ++i) {
+        struct rxp_suite_fixture *fixture;
+
+        if (!rxp_test_case_has_suite_fixture(&test_cases[i])) {
+            fixtures->indices[i] = RXP_SUITE_FIXTURE_NONE;
+            continue;
+        }
+
+        /* The test cases are mostly grouped by suite, so the instance is
+           likely to be the last one. */
+        for (j = fixtures->count; j-- > 0;) {
+            if (rxp_test_cases_share_suite_fixture(
+                    fixtures->array[j].test_case, &test_cases[i])) {
+                break;
+            }
+        }
+
+        if (j == (size_t)-1) {
+            j = fixtures->count++;
+            fixture = &fixtures->array[j];
+            fixture->test_case = &test_cases[i];
+            fixture->remaining = 0;
+            fixture->state = RXP_SUITE_FIXTURE_PENDING;
+            fixture->data = NULL;
+        } else {
+            fixture = &fixtures->array[j];
+        }
+
+        ++fixture->remaining;
+        fixtures->indices[i] = j;
+    }
+
+    return RX_SUCCESS;
+}
+
+static void
+rxp_suite_fixtures_terminate(struct rxp_suite_fixtures *fixtures)
+{
+    size_t i;
+
+    RX_ASSERT(fixtures != NULL);
+
+    /* Tear down the instances whose test cases didn't all complete, as when
+       the run is stopped early. */
+    for (i = 0; i < fixtures->count; ++i) {
+        struct rxp_suite_fixture *fixture;
+
+        fixture = &fixtures->array[i];
+        if (fixture->state == RXP_SUITE_FIXTURE_READY) {
+            rxp_suite_fixture_tear_down(fixture->test_case, fixture->data);
+            fixture->state = RXP_SUITE_FIXTURE_TORN_DOWN;
+        }
+    }
+
+    RX_FREE(fixtures->indices);
+    RX_FREE(fixtures->array);
+}
+
+#if RXP_THREADS
+static enum rx_status
+rxp_suite_fixtures_initialize_mutexes(struct rxp_suite_fixtures *fixtures)
+{
+    size_t i;
+
+    RX_ASSERT(fixtures != NULL);
+
+    for (i = 0; i < fixtures->count; ++i) {
+        if (rxp_mutex_initialize(&fixtures->array[i].mutex) != RX_SUCCESS) {
+            while (i-- > 0) {
+                rxp_mutex_terminate(&fixtures->array[i].mutex);
+            }
+
+            return RX_ERROR;
+        }
+    }
+
+    return RX_SUCCESS;
+}
+
+static void
+rxp_suite_fixtures_terminate_mutexes(struct rxp_suite_fixtures *fixtures)
+{
+    size_t i;
+
+    RX_ASSERT(fixtures != NULL);
+
+    for (i = 0; i < fixtures->count; ++i) {
+        rxp_mutex_terminate(&fixtures->array[i].mutex);
+    }
+}
+#endif
+
+/* Implementation: Runner                                          O-(''Q)
+   -------------------------------------------------------------------------- */
+
+/*
+   The runner hands out the test cases to a pool of workers, each calling
+   `rx_test_case_run()` with its own context and writing into the summary
+   preallocated for the test case being run. The summaries are printed in
+   the registration order as soon as all the preceding ones have completed,
+   so the output doesn't depend on the number of workers nor on the order in
+   which the test cases are dispatched.
+*/
+
+struct rxp_runner {
+    size_t test_case_count;
+    const struct rx_test_case *test_cases;
+    struct rx_summary *summaries;
+    int *completed;
+    const size_t *order;
+    size_t next;
+    size_t printed;
+    enum rx_status status;
+    int threaded;
+    int quiet;
+    int fail_fast;
+    int stopped;
+    double timeout;
+    uint64_t *time_begins;
+    size_t watched;
+    int watching;
+    int perf_counters;
+    const char *profile_path;
+    struct rxp_suite_fixtures suite_fixtures;
+#if RXP_THREADS
+    rxp_mutex mutex;
+#endif
+};
+
+static void
+rxp_runner_lock(struct rxp_runner *runner)
+{
+#if RXP_THREADS
+    if (runner->threaded) {
+        rxp_mutex_lock(&runner->mutex);
+    }
+#else
+    RXP_UNUSED(runner);
+#endif
+}
+
+static void
+rxp_runner_unlock(struct rxp_runner *runner)
+{
+#if RXP_THREADS
+    if (runner->threaded) {
+        rxp_mutex_unlock(&runner->mutex);
+    }
+#else
+    RXP_UNUSED(runner);
+#endif
+}
+
+static void
+rxp_runner_get_timeout(rx_uint64 *timeout,
+                       const struct rxp_runner *runner,
+                       size_t index)
+{
+    double seconds;
+
+    RX_ASSERT(timeout != NULL);
+    RX_ASSERT(runner != NULL);
+    RX_ASSERT(index < runner->test_case_count);
+
+    /* The test case's own timeout takes precedence over the default one. */
+    seconds = runner->test_cases[index].config.timeout;
+    if (!(seconds > 0.0)) {
+        seconds = runner->timeout;
+    }
+
+    *timeout = seconds > 0.0
+                   ? (rx_uint64)(seconds * (double)RXP_TICKS_PER_SECOND)
+                   : 0;
+}
+
+static enum rx_status
+rxp_summary_add_timeout_failure(struct rx_summary *summary,
+                                rx_uint64 timeout,
+                                enum rx_severity severity)
+{
+    enum rx_status status;
+    char *msg;
+
+    RX_ASSERT(summary != NULL);
+
+    RXP_STR_CREATE_1(status,
+                     msg,
+                     "the test case timed out after %g seconds",
+                     (double)timeout / (double)RXP_TICKS_PER_SECOND);
+    if (status != RX_SUCCESS) {
+        msg = NULL;
+    }
+
+    status = rxp_summary_add_failure(
+        summary,
+        NULL,
+        0,
+        severity,
+        msg == NULL ? "the test case timed out" : msg,
+        NULL);
+    RX_FREE(msg);
+    return status;
+}
+
+/*
+   Fail a test case that completed but took longer than its timeout, which
+   can happen if no watchdog was available to interrupt it.
+*/
+static enum rx_status
+rxp_runner_check_timeout(struct rxp_runner *runner, size_t index)
+{
+    rx_uint64 timeout;
+    struct rx_summary *summary;
+
+    RX_ASSERT(runner != NULL);
+
+    rxp_runner_get_timeout(&timeout, runner, index);
+    summary = &runner->summaries[index];
+    if (timeout == 0 || summary->skipped || summary->elapsed <= timeout) {
+        return RX_SUCCESS;
+    }
+
+    return rxp_summary_add_timeout_failure(summary, timeout, RX_NONFATAL);
+}
+
+static void
+rxp_runner_acquire(int *acquired, size_t *index, struct rxp_runner *runner)
+{
+    RX_ASSERT(acquired != NULL);
+    RX_ASSERT(index != NULL);
+    RX_ASSERT(runner != NULL);
+
+    if (runner->status != RX_SUCCESS || runner->stopped
+        || runner->next == runner->test_case_count) {
+        *acquired = 0;
+        return;
+    }
+
+    *index = runner->order != NULL ? runner->order[runner->next]
+                                   : runner->next;
+    ++runner->next;
+    *acquired = 1;
+
+    if (runner->time_begins != NULL
+        && rxp_get_real_time(&runner->time_begins[*index]) != RX_SUCCESS) {
+        runner->time_begins[*index] = 0;
+    }
+
+#ifdef RXP_DEBUG_TESTS
+    {
+        const char *style_begin;
+        const char *style_end;
+
+#if RXP_LOG_STYLING
+        if (RXP_ISATTY(RXP_FILENO(stderr))) {
+            rxp_log_style_get_ansi_code(&style_begin, RXP_LOG_STYLE_YELLOW);
+            rxp_log_style_get_ansi_code(&style_end, RXP_LOG_STYLE_RESET);
+        } else {
+            style_begin = style_end = "";
+        }
+#else
+        style_begin = style_end = "";
+#endif
+
+        fprintf(stderr,
+                "[%s%s%s] (test \"%zd\" of \"%zd\", suite: \"%s\", case: "
+                "\"%s\")\n",
+                style_begin,
+                "EXECUTING",
+                style_end,
+                *index + 1,
+                runner->test_case_count,
+                runner->test_cases[*index].suite_name,
+                runner->test_cases[*index].name);
+    }
+#endif
+}
+
+static void
+rxp_runner_lock_suite_fixture(struct rxp_runner *runner,
+                              struct rxp_suite_fixture *fixture)
+{
+#if RXP_THREADS
+    if (runner->threaded) {
+        rxp_mutex_lock(&fixture->mutex);
+    }
+#else
+    RXP_UNUSED(runner);
+    RXP_UNUSED(fixture);
+#endif
+}
+
+static void
+rxp_runner_unlock_suite_fixture(struct rxp_runner *runner,
+                                struct rxp_suite_fixture *fixture)
+{
+#if RXP_THREADS
+    if (runner->threaded) {
+        rxp_mutex_unlock(&fixture->mutex);
+    }
+#else
+    RXP_UNUSED(runner);
+    RXP_UNUSED(fixture);
+#endif
+}
+
+/*
+   Retrieve the data of the suite fixture used by a test case being run
+   in-process, setting it up if this is the first test case to use it.
+
+   The set up runs without holding the runner's lock, so that the other
+   workers and the watchdog aren't held up by it. Instead, the worker setting
+   up the fixture holds the fixture's own lock, which the workers needing
+   the same fixture wait on.
+*/
+static enum rx_status
+rxp_runner_get_suite_data(const void **data,
+                          struct rxp_runner *runner,
+                          size_t index)
+{
+    struct rxp_suite_fixture *fixture;
+    enum rxp_suite_fixture_state state;
+
+    RX_ASSERT(data != NULL);
+    RX_ASSERT(runner != NULL);
+    RX_ASSERT(index < runner->test_case_count);
+
+    *data = NULL;
+
+    if (runner->suite_fixtures.count == 0
+        || runner->suite_fixtures.indices[index] == RXP_SUITE_FIXTURE_NONE) {
+        return RX_SUCCESS;
+    }
+
+    fixture
+        = &runner->suite_fixtures.array[runner->suite_fixtures.indices[index]];
+
+    rxp_runner_lock(runner);
+    state = fixture->state;
+    if (state == RXP_SUITE_FIXTURE_PENDING) {
+        /* No other worker can be holding the fixture's lock yet. */
+        fixture->state = RXP_SUITE_FIXTURE_SETTING_UP;
+        rxp_runner_lock_suite_fixture(runner, fixture);
+    }
+
+    rxp_runner_unlock(runner);
+
+    if (state == RXP_SUITE_FIXTURE_PENDING) {
+        void *suite_data;
+        enum rx_status status;
+
+        status = rxp_suite_fixture_set_up(&suite_data, fixture->test_case);
+
+        rxp_runner_lock(runner);
+        if (status == RX_SUCCESS) {
+            fixture->data = suite_data;
+            fixture->state = RXP_SUITE_FIXTURE_READY;
+        } else {
+            fixture->state = RXP_SUITE_FIXTURE_FAILED;
+        }
+
+        rxp_runner_unlock(runner);
+        rxp_runner_unlock_suite_fixture(runner, fixture);
+    } else if (state == RXP_SUITE_FIXTURE_SETTING_UP) {
+        rxp_runner_lock_suite_fixture(runner, fixture);
+        rxp_runner_unlock_suite_fixture(runner, fixture);
+    }
+
+    rxp_runner_lock(runner);
+
+    /* The set up doesn't count towards the test case's timeout. */
+    if (state != fixture->state && runner->time_begins != NULL
+        && rxp_get_real_time(&runner->time_begins[index]) != RX_SUCCESS) {
+        runner->time_begins[index] = 0;
+    }
+
+    state = fixture->state;
+    rxp_runner_unlock(runner);
+
+    RX_ASSERT(state == RXP_SUITE_FIXTURE_READY
+              || state == RXP_SUITE_FIXTURE_FAILED);
+
+    if (state == RXP_SUITE_FIXTURE_FAILED) {
+        runner->summaries[index].error = "failed to set-up the suite fixture\0";
+        return RX_ERROR;
+    }
+
+    *data = fixture->data;
+    return RX_SUCCESS;
+}
+
+/*
+   Retrieve the suite fixture that a test case run in-process was the last
+   one to use, if any, for the caller to tear it down once the runner's lock
+   is released.
+*/
+static void
+rxp_runner_expire_suite_fixture(struct rxp_suite_fixture **expired,
+                                struct rxp_runner *runner,
+                                size_t index)
+{
+    struct rxp_suite_fixture *fixture;
+
+    RX_ASSERT(expired != NULL);
+    RX_ASSERT(runner != NULL);
+    RX_ASSERT(index < runner->test_case_count);
+
+    *expired = NULL;
+
+    if (runner->suite_fixtures.count == 0
+        || runner->suite_fixtures.indices[index] == RXP_SUITE_FIXTURE_NONE) {
+        return;
+    }
+
+    fixture
+        = &runner->suite_fixtures.array[runner->suite_fixtures.indices[index]];
+    RX_ASSERT(fixture->remaining > 0);
+    if (--fixture->remaining == 0
+        && fixture->state == RXP_SUITE_FIXTURE_READY) {
+        fixture->state = RXP_SUITE_FIXTURE_TORN_DOWN;
+        *expired = fixture;
+    }
+}
+
+static void
+rxp_runner_release(struct rxp_runner *runner,
+                   size_t index,
+                   enum rx_status status)
+{
+    RX_ASSERT(runner != NULL);
+    RX_ASSERT(index < runner->test_case_count);
+
+    runner->completed[index] = 1;
+
+    if (status != RX_SUCCESS) {
+        RXP_LOG_ERROR_2("failed to run a test case "
+                        "(suite: \"%s\", case: \"%s\")\n",
+                        runner->test_cases[index].suite_name,
+                        runner->test_cases[index].name);
+        if (runner->status == RX_SUCCESS) {
+            runner->status = status;
+        }
+
+        return;
+    }
+
+    if (runner->status != RX_SUCCESS) {
+        return;
+    }
+
+    if (runner->fail_fast && !runner->stopped
+        && runner->summaries[index].failure_count > 0) {
+        RXP_LOG_INFO("stopping the run after the first failure\n");
+        runner->stopped = 1;
+    }
+
+    while (runner->printed < runner->test_case_count
+           && runner->completed[runner->printed]) {
+        if (!runner->quiet) {
+            rx_summary_print(&runner->summaries[runner->printed]);
+        }
+
+        ++runner->printed;
+    }
+}
+
+/*
+   Print the summaries that couldn't be printed in order because some of
+   the test cases preceding them never completed, as when the run is stopped
+   early.
+*/
+static void
+rxp_runner_print_remaining(struct rxp_runner *runner)
+{
+    RX_ASSERT(runner != NULL);
+
+    if (runner->status != RX_SUCCESS || runner->quiet) {
+        return;
+    }
+
+    for (; runner->printed < runner->test_case_count; ++runner->printed) {
+        if (runner->completed[runner->printed]) {
+            rx_summary_print(&runner->summaries[runner->printed]);
+        }
+    }
+}
+
+static void
+rxp_runner_work(struct rxp_runner *runner)
+{
+    RX_ASSERT(runner != NULL);
+
+    for (;;) {
+        int acquired;
+        size_t index;
+        enum rx_status status;
+        const void *suite_data;
+        struct rxp_suite_fixture *expired;
+
+        rxp_runner_lock(runner);
+        rxp_runner_acquire(&acquired, &index, runner);
+        rxp_runner_unlock(runner);
+
+        if (!acquired) {
+            return;
+        }
+
+        status = rxp_runner_get_suite_data(&suite_data, runner, index);
+        if (status == RX_SUCCESS) {
+            status = rxp_test_case_run(&runner->summaries[index],
+                                       &runner->test_cases[index],
+                                       suite_data,
+                                       runner->perf_counters,
+                                       runner->profile_path);
+        }
+
+        if (status == RX_SUCCESS) {
+            status = rxp_runner_check_timeout(runner, index);
+        }
+
+        rxp_runner_lock(runner);
+        rxp_runner_expire_suite_fixture(&expired, runner, index);
+        rxp_runner_release(runner, index, status);
+        rxp_runner_unlock(runner);
+
+        if (expired != NULL) {
+            rxp_suite_fixture_tear_down(expired->test_case, expired->data);
+        }
+    }
+}
+
+#if RXP_THREADS
+static rxp_thread_result RXP_THREAD_CALL
+rxp_runner_worker_main(void *arg)
+{
+    rxp_runner_work((struct rxp_runner *)arg);
+    return 0;
+}
+
+/*
+   Threads can't be safely interrupted so, when a test case run in-process
+   exceeds its timeout, the watchdog reports it alongside the summaries
+   completed so far, and terminates the process.
+*/
+
+#define RXP_WATCHDOG_PERIOD 10
+
+static void
+rxp_runner_abort_on_timeout(struct rxp_runner *runner,
+                            size_t index,
+                            rx_uint64 timeout,
+                            rx_uint64 elapsed)
+{
+    struct rx_summary summary;
+    int initialized;
+    size_t i;
+
+    RX_ASSERT(runner != NULL);
+
+    initialized = rx_summary_initialize(&summary, &runner->test_cases[index])
+                  == RX_SUCCESS;
+    if (initialized) {
+        summary.elapsed = elapsed;
+        rxp_summary_add_timeout_failure(&summary, timeout, RX_FATAL);
+    }
+
+    for (i = runner->printed; i < runner->test_case_count; ++i) {
+        if (i == index) {
+            if (initialized) {
+                rx_summary_print(&summary);
+            }
+        } else if (runner->completed[i]) {
+            rx_summary_print(&runner->summaries[i]);
+        }
+    }
+
+    RXP_LOG_FATAL_2("the test case timed out, aborting the run "
+                    "(suite: \"%s\", case: \"%s\")\n",
+                    runner->test_cases[index].suite_name,
+                    runner->test_cases[index].name);
+
+    fflush(NULL);
+    _exit(EXIT_FAILURE);
+}
+
+static rxp_thread_result RXP_THREAD_CALL
+rxp_runner_watchdog_main(void *arg)
+{
+    struct rxp_runner *runner;
+
+    runner = (struct rxp_runner *)arg;
+
+    for (;;) {
+        size_t i;
+        uint64_t now;
+
+        rxp_thread_sleep(RXP_WATCHDOG_PERIOD);
+
+        rxp_runner_lock(runner);
+
+        if (!runner->watching) {
+            rxp_runner_unlock(runner);
+            return 0;
+        }
+
+        if (rxp_get_real_time(&now) != RX_SUCCESS) {
+            rxp_runner_unlock(runner);
+            continue;
+        }
+
+        /* Only the test cases dispatched past the first incomplete one need
+           to be looked at. */
+        for (i = runner->watched; i < runner->next; ++i) {
+            size_t index;
+            rx_uint64 timeout;
+            uint64_t time_begin;
+
+            index = runner->order != NULL ? runner->order[i] : i;
+            if (runner->completed[index]) {
+                if (i == runner->watched) {
+                    ++runner->watched;
+                }
+
+                continue;
+            }
+
+            rxp_runner_get_timeout(&timeout, runner, index);
+            time_begin = runner->time_begins[index];
+            if (timeout > 0 && now > time_begin
+                && (rx_uint64)(now - time_begin) > timeout) {
+                rxp_runner_abort_on_timeout(
+                    runner, index, timeout, (rx_uint64)(now - time_begin));
+            }
+        }
+
+        rxp_runner_unlock(runner);
+    }
+}
+#endif
+
+static enum rx_status
+rxp_runner_execute(struct rxp_runner *runner, size_t worker_count)
+{
+    RX_ASSERT(runner != NULL);
+    RX_ASSERT(worker_count > 0);
+
+#if RXP_THREADS
+    {
+        size_t i;
+        size_t thread_count;
+        rxp_thread *threads;
+        rxp_thread watchdog;
+
+        threads = NULL;
+        thread_count = 0;
+
+        if (worker_count > 1) {
+            threads = (rxp_thread *)RX_MALLOC(sizeof *threads
+                                              * (worker_count - 1));
+            if (threads == NULL) {
+                RXP_LOG_WARNING("failed to allocate the worker threads, "
+                                "running the test cases serially\n");
+            }
+        }
+
+        if (threads != NULL || runner->time_begins != NULL) {
+            if (rxp_mutex_initialize(&runner->mutex) != RX_SUCCESS) {
+                RXP_LOG_WARNING("failed to initialize the runner's mutex, "
+                                "running the test cases serially and without "
+                                "any watchdog\n");
+            } else if (rxp_suite_fixtures_initialize_mutexes(
+                           &runner->suite_fixtures)
+                       != RX_SUCCESS) {
+                RXP_LOG_WARNING("failed to initialize the suite fixtures' "
+                                "mutexes, running the test cases serially and "
+                                "without any watchdog\n");
+                rxp_mutex_terminate(&runner->mutex);
+            } else {
+                runner->threaded = 1;
+            }
+        }
+
+        if (runner->threaded && runner->time_begins != NULL) {
+            runner->watching = 1;
+            if (rxp_thread_create(&watchdog, rxp_runner_watchdog_main, runner)
+                != RX_SUCCESS) {
+                RXP_LOG_WARNING("failed to create the watchdog thread, "
+                                "the timeouts are only checked once the test "
+                                "cases complete\n");
+                runner->watching = 0;
+            }
+        }
+
+        if (runner->threaded && threads != NULL) {
+            /* The calling thread also acts as one of the workers. */
+            for (; thread_count < worker_count - 1; ++thread_count) {
+                if (rxp_thread_create(&threads[thread_count],
+                                      rxp_runner_worker_main,
+                                      runner)
+                    != RX_SUCCESS) {
+                    RXP_LOG_WARNING_1("only %lu worker threads could be "
+                                      "created\n",
+                                      (unsigned long)thread_count + 1);
+                    break;
+                }
+            }
+        }
+
+        rxp_runner_work(runner);
+
+        for (i = 0; i < thread_count; ++i) {
+            rxp_thread_join(threads[i]);
+        }
+
+        if (runner->watching) {
+            rxp_runner_lock(runner);
+            runner->watching = 0;
+            rxp_runner_unlock(runner);
+            rxp_thread_join(watchdog);
+        }
+
+        if (runner->threaded) {
+            rxp_suite_fixtures_terminate_mutexes(&runner->suite_fixtures);
+            rxp_mutex_terminate(&runner->mutex);
+            runner->threaded = 0;
+        }
+
+        RX_FREE(threads);
+    }
+#else
+    if (worker_count > 1) {
+        RXP_LOG_WARNING("threads are not available, "
+                        "running the test cases serially\n");
+    }
+
+    rxp_runner_work(runner);
+#endif
+
+    return runner->status;
+}
+
+#if RXP_PROCESSES
+/*
+   Isolated mode: each test case is run within one of a pool of forked worker
+   processes, with the parent process sending the index of the test case to
+   run over a pipe and the worker streaming back the resulting summary.
+   A test case crashing only takes its worker down, which gets replaced.
+
+   Since the workers are forks of the parent process, the summaries can be
+   transferred mostly as raw memory. The failures are serialized after it,
+   along with their strings, and then the latency histograms. The pointers
+   sent as-is are the error messages and the names of the metrics and of
+   the latencies, which refer to string literals and hence share the same
+   address in both processes.
+*/
+
+struct rxp_worker {
+    pid_t pid;
+    int request_fd;
+    int response_fd;
+    int busy;
+    size_t index;
+    uint64_t time_begin;
+};
+
+static enum rx_status
+rxp_summary_write(int fd, const struct rx_summary *summary)
+{
+    enum rx_status status;
+    size_t i;
+
+    RX_ASSERT(summary != NULL);
+
+    status = rxp_fd_write(fd, summary, sizeof *summary);
+    if (status != RX_SUCCESS) {
+        return status;
+    }
+
+    for (i = 0; i < summary->failure_count; ++i) {
+        const struct rx_failure *failure;
+
+        failure = &summary->failures[i];
+
+        status = rxp_fd_write(fd, failure, sizeof *failure);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
+
+        status = rxp_fd_write_str(fd, failure->file);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
+
+        status = rxp_fd_write_str(fd, failure->msg);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
+
+        status = rxp_fd_write_str(fd, failure->diagnostic_msg);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
+    }
+
+    /* The names point to string literals shared with the parent process. */
+    if (summary->latencies.count > 0) {
+        status = rxp_fd_write(fd,
+                              summary->latencies.values,
+                              sizeof *summary->latencies.values
+                                  * summary->latencies.count);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
+    }
+
+    return RX_SUCCESS;
+}
+
+static enum rx_status
+rxp_summary_read(struct rx_summary *summary, int fd)
+{
+    enum rx_status status;
+    struct rx_summary record;
+    size_t record_failure_count;
+    size_t i;
+
+    RX_ASSERT(summary != NULL);
+    RX_ASSERT(summary->test_case != NULL);
+    RX_ASSERT(summary->failures != NULL);
+    RX_ASSERT(summary->failure_count == 0);
+
+    status = rxp_fd_read(fd, &record, sizeof record);
+    if (status != RX_SUCCESS) {
+        return status;
+    }
+
+    record_failure_count = (size_t)record.failure_count;
+    record.test_case = summary->test_case;
+    record.failures = summary->failures;
+    record.failure_count = 0;
+    *summary = record;
+    summary->latencies.count = 0;
+    summary->latencies.values = NULL;
+
+    for (i = 0; i < record_failure_count; ++i) {
+        struct rx_failure *failure;
+        struct rx_failure failure_record;
+        size_t failure_count;
+        char *buf;
+
+        status = rxp_fd_read(fd, &failure_record, sizeof failure_record);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
+
+        status = rxp_test_failure_array_extend_back(
+            &failure, &summary->failures, 1);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
+
+        failure->file = NULL;
+        failure->line = failure_record.line;
+        failure->severity = failure_record.severity;
+        failure->msg = NULL;
+        failure->diagnostic_msg = NULL;
+
+        rxp_test_failure_array_get_size(&failure_count, summary->failures);
+        summary->failure_count = failure_count;
+
+        status = rxp_fd_read_str(&buf, fd);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
+
+        failure->file = buf;
+
+        status = rxp_fd_read_str(&buf, fd);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
+
+        failure->msg = buf;
+
+        status = rxp_fd_read_str(&buf, fd);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
+
+        failure->diagnostic_msg = buf;
+    }
+
+    if (record.latencies.count > 0) {
+        struct rx_latency_histogram *histograms;
+
+        histograms = (struct rx_latency_histogram *)RX_MALLOC(
+            sizeof *histograms * record.latencies.count);
+        if (histograms == NULL) {
+            return RX_ERROR_ALLOCATION;
+        }
+
+        summary->latencies.values = histograms;
+
+        status = rxp_fd_read(
+            fd, histograms, sizeof *histograms * record.latencies.count);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
+
+        summary->latencies.count = record.latencies.count;
+    }
+
+    return RX_SUCCESS;
+}
+
+/*
+   Each worker process sets up its own copy of the suite fixtures, keeping
+   the last one alive for as long as the test cases handed out to it keep
+   referring to it. Since the test cases are dispatched by suite unless
+   they're reordered, this usually amounts to a single set up per suite and
+   per worker.
+*/
+static void
+rxp_worker_serve(struct rxp_runner *runner, int request_fd, int response_fd)
+{
+    size_t suite_fixture_index;
+    void *suite_data;
+
+    suite_fixture_index = RXP_SUITE_FIXTURE_NONE;
+    suite_data = NULL;
+
+    for (;;) {
+        size_t index;
+        size_t fixture_index;
+        enum rx_status status;
+        struct rx_summary summary;
+
+        if (rxp_fd_read(request_fd, &index, sizeof index) != RX_SUCCESS) {
+            break;
+        }
+
+        RX_ASSERT(index < runner->test_case_count);
+
+        status = rx_summary_initialize(&summary, &runner->test_cases[index]);
+        if (status != RX_SUCCESS) {
+            memset(&summary, 0, sizeof summary);
+            if (rxp_fd_write(response_fd, &status, sizeof status)
+                    != RX_SUCCESS
+                || rxp_fd_write(response_fd, &summary, sizeof summary)
+                       != RX_SUCCESS) {
+                break;
+            }
+
+            continue;
+        }
+
+        fixture_index = runner->suite_fixtures.count > 0
+                            ? runner->suite_fixtures.indices[index]
+                            : RXP_SUITE_FIXTURE_NONE;
+        if (fixture_index != suite_fixture_index) {
+            if (suite_fixture_index != RXP_SUITE_FIXTURE_NONE) {
+                rxp_suite_fixture_tear_down(
+                    runner->suite_fixtures.array[suite_fixture_index]
+                        .test_case,
+                    suite_data);
+                suite_fixture_index = RXP_SUITE_FIXTURE_NONE;
+                suite_data = NULL;
+            }
+
+            if (fixture_index != RXP_SUITE_FIXTURE_NONE) {
+                status = rxp_suite_fixture_set_up(
+                    &suite_data,
+                    runner->suite_fixtures.array[fixture_index].test_case);
+                if (status == RX_SUCCESS) {
+                    suite_fixture_index = fixture_index;
+                } else {
+                    summary.error = "failed to set-up the suite fixture\0";
+                }
+            }
+        }
+
+        if (status == RX_SUCCESS) {
+            status = rxp_test_case_run(&summary,
+                                       &runner->test_cases[index],
+                                       suite_data,
+                                       runner->perf_counters,
+                                       runner->profile_path);
+        }
+
+        if (rxp_fd_write(response_fd, &status, sizeof status) != RX_SUCCESS
+            || rxp_summary_write(response_fd, &summary) != RX_SUCCESS) {
+            rx_summary_terminate(&summary);
+            break;
+        }
+
+        rx_summary_terminate(&summary);
+    }
+
+    if (suite_fixture_index != RXP_SUITE_FIXTURE_NONE) {
+        rxp_suite_fixture_tear_down(
+            runner->suite_fixtures.array[suite_fixture_index].test_case,
+            suite_data);
+    }
+}
+
+static enum rx_status
+rxp_worker_spawn(struct rxp_worker *worker,
+                 struct rxp_runner *runner,
+                 const struct rxp_worker *workers,
+                 size_t worker_count)
+{
+    int request_fds[2];
+    int response_fds[2];
+    pid_t pid;
+
+    RX_ASSERT(worker != NULL);
+    RX_ASSERT(runner != NULL);
+    RX_ASSERT(workers != NULL);
+
+    if (pipe(request_fds) != 0) {
+        RXP_LOG_DEBUG("failed to create a pipe\n");
+        return RX_ERROR;
+    }
+
+    if (pipe(response_fds) != 0) {
+        RXP_LOG_DEBUG("failed to create a pipe\n");
+        close(request_fds[0]);
+        close(request_fds[1]);
+        return RX_ERROR;
+    }
+
+    /* Prevent any buffered output from being written twice. */
+    fflush(NULL);
+
+    pid = fork();
+    if (pid < 0) {
+        RXP_LOG_DEBUG("failed to fork the process\n");
+        close(request_fds[0]);
+        close(request_fds[1]);
+        close(response_fds[0]);
+        close(response_fds[1]);
+        return RX_ERROR;
+    }
+
+    if (pid == 0) {
+        size_t i;
+
+        for (i = 0; i < worker_count; ++i) {
+            if (&workers[i] != worker && workers[i].pid > 0) {
+                close(workers[i].request_fd);
+                close(workers[i].response_fd);
+            }
+        }
+
+        close(request_fds[1]);
+        close(response_fds[0]);
+        rxp_worker_serve(runner, request_fds[0], response_fds[1]);
+        _exit(0);
+    }
+
+    close(request_fds[0]);
+    close(response_fds[1]);
+
+    worker->pid = pid;
+    worker->request_fd = request_fds[1];
+    worker->response_fd = response_fds[0];
+    worker->busy = 0;
+    return RX_SUCCESS;
+}
+
+/*
+   Collect a worker process that is being terminated. If it was busy, its test
+   case is reported as having timed out if a non-zero timeout is given, or
+   as having crashed otherwise.
+*/
+static void
+rxp_worker_reap(struct rxp_worker *worker,
+                struct rxp_runner *runner,
+                rx_uint64 timeout)
+{
+    int wait_status;
+
+    RX_ASSERT(worker != NULL);
+    RX_ASSERT(worker->pid > 0);
+    RX_ASSERT(runner != NULL);
+
+    close(worker->request_fd);
+    close(worker->response_fd);
+
+    while (waitpid(worker->pid, &wait_status, 0) < 0) {
+        if (errno != EINTR) {
+            wait_status = 0;
+            break;
+        }
+    }
+
+    worker->pid = 0;
+
+    if (worker->busy) {
+        enum rx_status status;
+        struct rx_summary *summary;
+        char *msg;
+        uint64_t time_end;
+
+        summary = &runner->summaries[worker->index];
+
+        if (rxp_get_real_time(&time_end) == RX_SUCCESS
+            && time_end >= worker->time_begin) {
+            summary->elapsed = (rx_uint64)(time_end - worker->time_begin);
+        }
+
+        if (timeout > 0) {
+            status = rxp_summary_add_timeout_failure(
+                summary, timeout, RX_FATAL);
+            worker->busy = 0;
+            rxp_runner_release(runner, worker->index, status);
+            return;
+        }
+
+        if (WIFSIGNALED(wait_status)) {
+            const char *signal_name;
+
+            rxp_signal_get_name(&signal_name, WTERMSIG(wait_status));
+            RXP_STR_CREATE_2(status,
+                             msg,
+                             "the test case crashed with the signal %d (%s)",
+                             WTERMSIG(wait_status),
+                             signal_name);
+        } else {
+            RXP_STR_CREATE_1(status,
+                             msg,
+                             "the test case exited prematurely with "
+                             "the status %d",
+                             WIFEXITED(wait_status)
+                                 ? WEXITSTATUS(wait_status)
+                                 : -1);
+        }
+
+        if (status != RX_SUCCESS) {
+            msg = NULL;
+        }
+
+        status = rxp_summary_add_failure(
+            summary,
+            NULL,
+            0,
+            RX_FATAL,
+            msg == NULL ? "the test case crashed" : msg,
+            NULL);
+        RX_FREE(msg);
+
+        worker->busy = 0;
+        rxp_runner_release(runner, worker->index, status);
+    }
+}
+
+#define RXP_WORKER_MAX_POLL_TIMEOUT 60000
+
+/*
+   Retrieve the time left before a busy worker reaches its test case's
+   timeout, or the maximum value if there is no timeout.
+*/
+static void
+rxp_worker_get_remaining_time(rx_uint64 *remaining,
+                              const struct rxp_worker *worker,
+                              const struct rxp_runner *runner,
+                              uint64_t now)
+{
+    rx_uint64 timeout;
+    rx_uint64 elapsed;
+
+    RX_ASSERT(remaining != NULL);
+    RX_ASSERT(worker != NULL);
+    RX_ASSERT(worker->busy);
+    RX_ASSERT(runner != NULL);
+
+    rxp_runner_get_timeout(&timeout, runner, worker->index);
+    if (timeout == 0) {
+        *remaining = (rx_uint64)-1;
+        return;
+    }
+
+    elapsed = now > worker->time_begin ? (rx_uint64)(now - worker->time_begin)
+                                       : 0;
+    *remaining = timeout > elapsed ? timeout - elapsed : 0;
+}
+
+static enum rx_status
+rxp_runner_execute_isolated(struct rxp_runner *runner, size_t worker_count)
+{
+    size_t i;
+    struct rxp_worker *workers;
+    struct pollfd *poll_fds;
+    struct sigaction sigpipe_action;
+    struct sigaction sigpipe_old_action;
+
+    RX_ASSERT(runner != NULL);
+    RX_ASSERT(worker_count > 0);
+
+    workers = (struct rxp_worker *)RX_MALLOC(sizeof *workers * worker_count);
+    if (workers == NULL) {
+        RXP_LOG_DEBUG("failed to allocate the workers\n");
+        return RX_ERROR_ALLOCATION;
+    }
+
+    poll_fds
+        = (struct pollfd *)RX_MALLOC(sizeof *poll_fds * worker_count);
+    if (poll_fds == NULL) {
+        RXP_LOG_DEBUG("failed to allocate the poll descriptors\n");
+        RX_FREE(workers);
+        return RX_ERROR_ALLOCATION;
+    }
+
+    memset(workers, 0, sizeof *workers * worker_count);
+
+    /* Writing to a dead worker should be reported as an error rather than
+       terminating the runner. */
+    memset(&sigpipe_action, 0, sizeof sigpipe_action);
+    sigpipe_action.sa_handler = SIG_IGN;
+    sigemptyset(&sigpipe_action.sa_mask);
+    sigaction(SIGPIPE, &sigpipe_action, &sigpipe_old_action);
+
+    for (;;) {
+        size_t poll_fd_count;
+        int ready_count;
+        int poll_timeout;
+        uint64_t now;
+
+        /* Hand out a test case to each idle worker. */
+        for (i = 0; i < worker_count; ++i) {
+            struct rxp_worker *worker;
+            int acquired;
+            size_t index;
+
+            worker = &workers[i];
+            if (worker->busy) {
+                continue;
+            }
+
+            rxp_runner_acquire(&acquired, &index, runner);
+            if (!acquired) {
+                break;
+            }
+
+            if (worker->pid == 0
+                && rxp_worker_spawn(worker, runner, workers, worker_count)
+                       != RX_SUCCESS) {
+                RXP_LOG_ERROR("failed to spawn a worker process\n");
+                rxp_runner_release(runner, index, RX_ERROR);
+                break;
+            }
+
+            worker->busy = 1;
+            worker->index = index;
+            if (rxp_get_real_time(&worker->time_begin) != RX_SUCCESS) {
+                worker->time_begin = 0;
+            }
+
+            if (rxp_fd_write(worker->request_fd, &index, sizeof index)
+                != RX_SUCCESS) {
+                rxp_worker_reap(worker, runner, 0);
+            }
+        }
+
+        poll_fd_count = 0;
+        for (i = 0; i < worker_count; ++i) {
+            if (workers[i].busy) {
+                poll_fds[poll_fd_count].fd = workers[i].response_fd;
+                poll_fds[poll_fd_count].events = POLLIN;
+                poll_fds[poll_fd_count].revents = 0;
+                ++poll_fd_count;
+            }
+        }
+
+        if (poll_fd_count == 0) {
+            break;
+        }
+
+        if (runner->stopped) {
+            /* The test cases still running are cancelled below. */
+            break;
+        }
+
+        /* Wake up in time for the earliest deadline, if any. */
+        poll_timeout = -1;
+        if (rxp_get_real_time(&now) == RX_SUCCESS) {
+            for (i = 0; i < worker_count; ++i) {
+                rx_uint64 remaining;
+
+                if (!workers[i].busy) {
+                    continue;
+                }
+
+                rxp_worker_get_remaining_time(
+                    &remaining, &workers[i], runner, now);
+                if (remaining == (rx_uint64)-1) {
+                    continue;
+                }
+
+                remaining = (remaining + 999999) / 1000000;
+                if (remaining > RXP_WORKER_MAX_POLL_TIMEOUT) {
+                    remaining = RXP_WORKER_MAX_POLL_TIMEOUT;
+                }
+
+                if (poll_timeout < 0 || (int)remaining < poll_timeout) {
+                    poll_timeout = (int)remaining;
+                }
+            }
+        }
+
+        ready_count = poll(poll_fds, (nfds_t)poll_fd_count, poll_timeout);
+        if (ready_count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            RXP_LOG_ERROR("failed to poll the worker processes\n");
+            if (runner->status == RX_SUCCESS) {
+                runner->status = RX_ERROR;
+            }
+
+            break;
+        }
+
+        for (i = 0; i < worker_count; ++i) {
+            struct rxp_worker *worker;
+            size_t j;
+            enum rx_status status;
+
+            worker = &workers[i];
+            if (!worker->busy) {
+                continue;
+            }
+
+            for (j = 0; j < poll_fd_count; ++j) {
+                if (poll_fds[j].fd == worker->response_fd) {
+                    break;
+                }
+            }
+
+            if (j == poll_fd_count || poll_fds[j].revents == 0) {
+                continue;
+            }
+
+            if (rxp_fd_read(worker->response_fd, &status, sizeof status)
+                    != RX_SUCCESS
+                || rxp_summary_read(&runner->summaries[worker->index],
+                                    worker->response_fd)
+                       != RX_SUCCESS) {
+                rxp_worker_reap(worker, runner, 0);
+                continue;
+            }
+
+            if (status == RX_SUCCESS) {
+                status = rxp_runner_check_timeout(runner, worker->index);
+            }
+
+            worker->busy = 0;
+            rxp_runner_release(runner, worker->index, status);
+        }
+
+        /* Kill the workers running past their test case's timeout. */
+        if (rxp_get_real_time(&now) == RX_SUCCESS) {
+            for (i = 0; i < worker_count; ++i) {
+                rx_uint64 remaining;
+                rx_uint64 timeout;
+
+                if (!workers[i].busy) {
+                    continue;
+                }
+
+                rxp_worker_get_remaining_time(
+                    &remaining, &workers[i], runner, now);
+                if (remaining > 0) {
+                    continue;
+                }
+
+                rxp_runner_get_timeout(&timeout, runner, workers[i].index);
+                kill(workers[i].pid, SIGKILL);
+                rxp_worker_reap(&workers[i], runner, timeout);
+            }
+        }
+    }
+
+    for (i = 0; i < worker_count; ++i) {
+        if (workers[i].pid > 0) {
+            if (workers[i].busy) {
+                kill(workers[i].pid, SIGKILL);
+                workers[i].busy = 0;
+            }
+
+            rxp_worker_reap(&workers[i], runner, 0);
+        }
+    }
+
+    sigaction(SIGPIPE, &sigpipe_old_action, NULL);
+
+    RX_FREE(poll_fds);
+    RX_FREE(workers);
+    return runner->status;
+}
+#endif /* RXP_PROCESSES */
+
+/*
+   SplitMix64 generator, used to shuffle the test cases. Being fully defined
+   here rather than relying on `rand()` makes the order reproducible from
+   a seed across platforms.
+*/
+static rx_uint64
+rxp_random_next(rx_uint64 *state)
+{
+    rx_uint64 out;
+
+    RX_ASSERT(state != NULL);
+
+    *state += (rx_uint64)0x9e3779b9u << 32 | (rx_uint64)0x7f4a7c15u;
+    out = *state;
+    out = (out ^ (out >> 30))
+          * ((rx_uint64)0xbf58476du << 32 | (rx_uint64)0x1ce4e5b9u);
+    out = (out ^ (out >> 27))
+          * ((rx_uint64)0x94d049bbu << 32 | (rx_uint64)0x133111ebu);
+    return out ^ (out >> 31);
+}
+
+static void
+rxp_shuffle_test_cases(size_t *order, size_t test_case_count, rx_uint64 seed)
+{
+    size_t i;
+    rx_uint64 state;
+
+    RX_ASSERT(order != NULL);
+
+    for (i = 0; i < test_case_count; ++i) {
+        order[i] = i;
+    }
+
+    /* Fisher-Yates shuffle. */
+    state = seed;
+    for (i = test_case_count; i > 1; --i) {
+        size_t j;
+        size_t tmp;
+
+        j = (size_t)(rxp_random_next(&state) % (rx_uint64)i);
+        tmp = order[i - 1];
+        order[i - 1] = order[j];
+        order[j] = tmp;
+    }
+}
+
+struct rxp_dispatch_item {
+    size_t index;
+    int known;
+    rx_uint64 elapsed;
+};
+
+static int
+rxp_compare_dispatch_items_by_duration(const void *a, const void *b)
+{
+    const struct rxp_dispatch_item *aa;
+    const struct rxp_dispatch_item *bb;
+
+    aa = (const struct rxp_dispatch_item *)a;
+    bb = (const struct rxp_dispatch_item *)b;
+
+    /* Test cases without any recorded duration might be the slowest ones,
+       so start them first. */
+    if (aa->known != bb->known) {
+        return aa->known - bb->known;
+    }
+
+    if (aa->elapsed != bb->elapsed) {
+        return aa->elapsed < bb->elapsed ? 1 : -1;
+    }
+
+    return (aa->index > bb->index) - (aa->index < bb->index);
+}
+
+/*
+   Compute the order in which to dispatch the test cases so that the longest
+   ones, according to the recorded timings, start first. This evens out the
+   load across the workers.
+*/
+static enum rx_status
+rxp_order_test_cases_by_duration(size_t *order,
+                                 const struct rxp_records *timings,
+                                 size_t test_case_count,
+                                 const struct rx_test_case *test_cases)
+{
+    size_t i;
+    struct rxp_dispatch_item *items;
+
+    RX_ASSERT(order != NULL);
+    RX_ASSERT(timings != NULL);
+    RX_ASSERT(test_cases != NULL);
+
+    items = (struct rxp_dispatch_item *)RX_MALLOC(sizeof *items
+                                                  * test_case_count);
+    if (items == NULL) {
+        RXP_LOG_DEBUG("failed to allocate the dispatch items\n");
+        return RX_ERROR_ALLOCATION;
+    }
+
+    for (i = 0; i < test_case_count; ++i) {
+        struct rxp_record *timing;
+
+        rxp_records_find(
+            &timing, timings, test_cases[i].suite_name, test_cases[i].name);
+
+        items[i].index = i;
+        items[i].known = timing != NULL;
+        items[i].elapsed = timing != NULL ? timing->value : 0;
+    }
+
+    qsort(items,
+          test_case_count,
+          sizeof *items,
+          rxp_compare_dispatch_items_by_duration);
+
+    for (i = 0; i < test_case_count; ++i) {
+        order[i] = items[i].index;
+    }
+
+    RX_FREE(items);
+    return RX_SUCCESS;
+}
+
+#define RXP_DEFAULT_TIMINGS_PATH ".rexo-timings"
+
+/*
+   Merge the durations measured during this run into the timings file. The
+   file is loaded again right before being written to preserve the entries
+   recorded in the meantime by other runs.
+*/
+static enum rx_status
+rxp_save_timings(const char *path,
+                 size_t summary_count,
+                 const struct rx_summary *summaries,
+                 const int *completed)
+{
+    enum rx_status status;
+    struct rxp_records timings;
+    size_t i;
+
+    RX_ASSERT(path != NULL);
+    RX_ASSERT(summaries != NULL);
+    RX_ASSERT(completed != NULL);
+
+    rxp_records_initialize(&timings);
+
+    status = rxp_records_load(&timings, path);
+    if (status != RX_SUCCESS) {
+        goto exit;
+    }
+
+    for (i = 0; i < summary_count; ++i) {
+        const struct rx_summary *summary;
+
+        summary = &summaries[i];
+        if (!completed[i] || summary->skipped) {
+            continue;
+        }
+
+        status = rxp_records_set(&timings,
+                                 summary->test_case->suite_name,
+                                 summary->test_case->name,
+                                 summary->elapsed);
+        if (status != RX_SUCCESS) {
+            goto exit;
+        }
+    }
+
+    status = rxp_records_save(&timings, path);
+
+exit:
+    rxp_records_terminate(&timings);
+    return status;
+}
+
+#define RXP_DEFAULT_FAILURES_PATH ".rexo-failures"
+
+/*
+   Merge the outcome of this run into the failures file, which lists the test
+   cases that failed during their last run, alongside the number of
+   consecutive runs that failed. The test cases that passed are removed from
+   it, and the ones that didn't run are kept as-is.
+*/
+static enum rx_status
+rxp_save_failures(const char *path,
+                  size_t summary_count,
+                  const struct rx_summary *summaries,
+                  const int *completed)
+{
+    enum rx_status status;
+    struct rxp_records failures;
+    size_t i;
+
+    RX_ASSERT(path != NULL);
+    RX_ASSERT(summaries != NULL);
+    RX_ASSERT(completed != NULL);
+
+    rxp_records_initialize(&failures);
+
+    status = rxp_records_load(&failures, path);
+    if (status != RX_SUCCESS) {
+        goto exit;
+    }
+
+    for (i = 0; i < summary_count; ++i) {
+        const struct rx_summary *summary;
+        struct rxp_record *failure;
+
+        summary = &summaries[i];
+        if (!completed[i] || summary->skipped) {
+            continue;
+        }
+
+        if (summary->failure_count == 0 && summary->error == NULL) {
+            rxp_records_remove(&failures,
+                               summary->test_case->suite_name,
+                               summary->test_case->name);
+            continue;
+        }
+
+        rxp_records_find(&failure,
+                         &failures,
+                         summary->test_case->suite_name,
+                         summary->test_case->name);
+        status = rxp_records_set(&failures,
+                                 summary->test_case->suite_name,
+                                 summary->test_case->name,
+                                 failure == NULL ? 1 : failure->value + 1);
+        if (status != RX_SUCCESS) {
+            goto exit;
+        }
+    }
+
+    status = rxp_records_save(&failures, path);
+
+exit:
+    rxp_records_terminate(&failures);
+    return status;
+}
+
+/*
+   Move the test cases that failed during their last run to the front,
+   preserving their relative order, or only keep these if requested.
+*/
+static void
+rxp_select_failed_test_cases(size_t *test_case_count,
+                             struct rx_test_case *test_cases,
+                             const struct rxp_records *failures,
+                             int only_failed)
+{
+    size_t i;
+    size_t failed_count;
+    struct rx_test_case *passed;
+    size_t passed_count;
+
+    RX_ASSERT(test_case_count != NULL);
+    RX_ASSERT(test_cases != NULL);
+    RX_ASSERT(failures != NULL);
+
+    failed_count = 0;
+    for (i = 0; i < *test_case_count; ++i) {
+        struct rxp_record *failure;
+
+        rxp_records_find(&failure,
+                         failures,
+                         test_cases[i].suite_name,
+                         test_cases[i].name);
+        failed_count += failure != NULL;
+    }
+
+    if (failed_count == 0) {
+        RXP_LOG_INFO("no test case failed during the last run, running all "
+                     "of them\n");
+        return;
+    }
+
+    RXP_LOG_INFO_1("%lu test cases failed during the last run\n",
+                   (unsigned long)failed_count);
+
+    passed = NULL;
+    if (!only_failed) {
+        passed = (struct rx_test_case *)RX_MALLOC(
+            sizeof *passed * (*test_case_count - failed_count));
+        if (passed == NULL && *test_case_count > failed_count) {
+            RXP_LOG_WARNING("failed to allocate the test cases, running them "
+                            "in their original order\n");
+            return;
+        }
+    }
+
+    failed_count = 0;
+    passed_count = 0;
+    for (i = 0; i < *test_case_count; ++i) {
+        struct rxp_record *failure;
+
+        rxp_records_find(&failure,
+                         failures,
+                         test_cases[i].suite_name,
+                         test_cases[i].name);
+        if (failure != NULL) {
+            test_cases[failed_count++] = test_cases[i];
+        } else if (passed != NULL) {
+            passed[passed_count++] = test_cases[i];
+        }
+    }
+
+    if (passed != NULL) {
+        memcpy(&test_cases[failed_count],
+               passed,
+               sizeof *passed * passed_count);
+        RX_FREE(passed);
+    }
+
+    *test_case_count = failed_count + passed_count;
+}
+
+static rx_uint64
+rxp_hash_test_case(const struct rx_test_case *test_case)
+{
+    /* 64-bit FNV-1a. */
+    rx_uint64 out;
+    const char *c;
+
+    RX_ASSERT(test_case != NULL);
+
+    out = (rx_uint64)0xcbf29ce4u << 32 | (rx_uint64)0x84222325u;
+
+    for (c = test_case->suite_name; *c != '\0'; ++c) {
+        out ^= (rx_uint64)(unsigned char)*c;
+        out *= (rx_uint64)0x100u << 32 | (rx_uint64)0x1b3u;
+    }
+
+    out *= (rx_uint64)0x100u << 32 | (rx_uint64)0x1b3u;
+
+    for (c = test_case->name; *c != '\0'; ++c) {
+        out ^= (rx_uint64)(unsigned char)*c;
+        out *= (rx_uint64)0x100u << 32 | (rx_uint64)0x1b3u;
+    }
+
+    return out;
+}
+
+/*
+   Assign each test case to a shard. When durations were recorded, the test
+   cases are handed out from the longest to the shortest to the shard with
+   the lowest total duration so far, with the test cases lacking a duration
+   being assumed to take the average one. Otherwise they are spread according
+   to a hash of their names. Either way, the assignment only depends on
+   the test cases and on the timings, so all the shards agree on it.
+*/
+static enum rx_status
+rxp_assign_shards(size_t *shards,
+                  size_t shard_count,
+                  const struct rxp_records *timings,
+                  size_t test_case_count,
+                  const struct rx_test_case *test_cases)
+{
+    size_t i;
+    size_t known_count;
+    rx_uint64 total;
+    struct rxp_dispatch_item *items;
+    rx_uint64 *loads;
+
+    RX_ASSERT(shards != NULL);
+    RX_ASSERT(shard_count > 0);
+    RX_ASSERT(timings != NULL);
+    RX_ASSERT(test_cases != NULL);
+
+    items = (struct rxp_dispatch_item *)RX_MALLOC(sizeof *items
+                                                  * test_case_count);
+    if (items == NULL) {
+        RXP_LOG_DEBUG("failed to allocate the dispatch items\n");
+        return RX_ERROR_ALLOCATION;
+    }
+
+    known_count = 0;
+    total = 0;
+    for (i = 0; i < test_case_count; ++i) {
+        struct rxp_record *timing;
+
+        rxp_records_find(
+            &timing, timings, test_cases[i].suite_name, test_cases[i].name);
+
+        items[i].index = i;
+        items[i].known = timing != NULL;
+        items[i].elapsed = timing != NULL ? timing->value : 0;
+
+        if (timing != NULL) {
+            ++known_count;
+            total += timing->value;
+        }
+    }
+
+    if (known_count == 0) {
+        RXP_LOG_DEBUG("no timings available, sharding by hash\n");
+        for (i = 0; i < test_case_count; ++i) {
+            shards[i] = (size_t)(rxp_hash_test_case(&test_cases[i])
+                                 % (rx_uint64)shard_count);
+        }
+
+        RX_FREE(items);
+        return RX_SUCCESS;
+    }
+
+    loads = (rx_uint64 *)RX_MALLOC(sizeof *loads * shard_count);
+    if (loads == NULL) {
+        RXP_LOG_DEBUG("failed to allocate the shard loads\n");
+        RX_FREE(items);
+        return RX_ERROR_ALLOCATION;
+    }
+
+    memset(loads, 0, sizeof *loads * shard_count);
+
+    for (i = 0; i < test_case_count; ++i) {
+        if (!items[i].known) {
+            items[i].known = 1;
+            items[i].elapsed = total / (rx_uint64)known_count;
+        }
+    }
+
+    qsort(items,
+          test_case_count,
+          sizeof *items,
+          rxp_compare_dispatch_items_by_duration);
+
+    for (i = 0; i < test_case_count; ++i) {
+        size_t j;
+        size_t shard;
+
+        shard = 0;
+        for (j = 1; j < shard_count; ++j) {
+            if (loads[j] < loads[shard]) {
+                shard = j;
+            }
+        }
+
+        shards[items[i].index] = shard;
+        loads[shard] += items[i].elapsed;
+    }
+
+    RX_FREE(loads);
+    RX_FREE(items);
+    return RX_SUCCESS;
+}
+
+static enum rx_status
+rxp_write_shard_manifest(const char *path,
+                         const size_t *shards,
+                         size_t test_case_count,
+                         const struct rx_test_case *test_cases)
+{
+    enum rx_status status;
+    FILE *file;
+    char *temporary_path;
+    size_t i;
+
+    RX_ASSERT(path != NULL);
+    RX_ASSERT(shards != NULL);
+    RX_ASSERT(test_cases != NULL);
+
+    status = rxp_file_open_temporary(&file, &temporary_path, path);
+    if (status != RX_SUCCESS) {
+        return status;
+    }
+
+    for (i = 0; i < test_case_count; ++i) {
+        fprintf(file,
+                "%lu\t%s\t%s\n",
+                (unsigned long)shards[i],
+                test_cases[i].suite_name,
+                test_cases[i].name);
+    }
+
+    return rxp_file_commit_temporary(file, temporary_path, path);
+}
+
+/*
+   Select the test cases belonging to the shard being run, preserving their
+   relative order.
+*/
+static enum rx_status
+rxp_shard_test_cases(size_t *selection_count,
+                     struct rx_test_case *selection,
+                     const struct rx_run_config *config,
+                     const struct rxp_records *timings,
+                     size_t test_case_count,
+                     const struct rx_test_case *test_cases)
+{
+    enum rx_status status;
+    size_t i;
+    size_t *shards;
+
+    RX_ASSERT(selection_count != NULL);
+    RX_ASSERT(selection != NULL);
+    RX_ASSERT(config != NULL);
+    RX_ASSERT(config->shard_count > 0);
+
+    if (config->shard_index >= config->shard_count) {
+        RXP_LOG_ERROR_2("the shard index %lu is out of range (shard count: "
+                        "%lu)\n",
+                        (unsigned long)config->shard_index,
+                        (unsigned long)config->shard_count);
+        return RX_ERROR;
+    }
+
+    shards = (size_t *)RX_MALLOC(sizeof *shards * test_case_count);
+    if (shards == NULL) {
+        RXP_LOG_DEBUG("failed to allocate the shard assignments\n");
+        return RX_ERROR_ALLOCATION;
+    }
+
+    status = rxp_assign_shards(shards,
+                               (size_t)config->shard_count,
+                               timings,
+                               test_case_count,
+                               test_cases);
+    if (status != RX_SUCCESS) {
+        goto exit;
+    }
+
+    if (config->shard_manifest_path != NULL) {
+        status = rxp_write_shard_manifest(config->shard_manifest_path,
+                                          shards,
+                                          test_case_count,
+                                          test_cases);
+        if (status != RX_SUCCESS) {
+            goto exit;
+        }
+    }
+
+    *selection_count = 0;
+    for (i = 0; i < test_case_count; ++i) {
+        if (shards[i] == (size_t)config->shard_index) {
+            selection[(*selection_count)++] = test_cases[i];
+        }
+    }
+
+    RXP_LOG_INFO_2("running the shard %lu (%lu test cases)\n",
+                   (unsigned long)config->shard_index,
+                   (unsigned long)*selection_count);
+
+exit:
+    RX_FREE(shards);
+    return status;
+}
+
+/*
+   Repeated runs: each test case is run several times, with the repetitions
+   being expanded into as many copies of the test cases as to be spread
+   across the workers like any other test case. The results of all the runs
+   are then aggregated per test case, and only the first failing summary of
+   each test case is printed.
+*/
+
+#define RXP_REPETITION_BATCH_SIZE 256
+
+struct rxp_repetition {
+    struct rx_repetition_summary summary;
+    rx_uint64 *elapsed;
+    size_t elapsed_capacity;
+    int reported;
+};
+
+struct rxp_repetitions {
+    size_t count;
+    struct rxp_repetition *array;
+    int failed;
+};
+
+static int
+rxp_compare_uint64(const void *a, const void *b)
+{
+    rx_uint64 aa;
+    rx_uint64 bb;
+
+    aa = *(const rx_uint64 *)a;
+    bb = *(const rx_uint64 *)b;
+    return (aa > bb) - (aa < bb);
+}
+
+static enum rx_status
+rxp_repetitions_initialize(struct rxp_repetitions *repetitions,
+                           size_t test_case_count,
+                           const struct rx_test_case *test_cases)
+{
+    size_t i;
+
+    RX_ASSERT(repetitions != NULL);
+    RX_ASSERT(test_cases != NULL);
+
+    repetitions->array = (struct rxp_repetition *)RX_MALLOC(
+        sizeof *repetitions->array * test_case_count);
+    if (repetitions->array == NULL) {
+        RXP_LOG_DEBUG("failed to allocate the repetitions\n");
+        return RX_ERROR_ALLOCATION;
+    }
+
+    memset(repetitions->array, 0, sizeof *repetitions->array * test_case_count);
+    repetitions->count = test_case_count;
+    repetitions->failed = 0;
+
+    for (i = 0; i < test_case_count; ++i) {
+        repetitions->array[i].summary.test_case = &test_cases[i];
+    }
+
+    return RX_SUCCESS;
+}
+
+static void
+rxp_repetitions_terminate(struct rxp_repetitions *repetitions)
+{
+    size_t i;
+
+    RX_ASSERT(repetitions != NULL);
+
+    for (i = 0; i < repetitions->count; ++i) {
+        RX_FREE(repetitions->array[i].elapsed);
+    }
+
+    RX_FREE(repetitions->array);
+}
+
+/*
+   Aggregate the summaries of a batch of runs, where the summary at a given
+   index results from running the test case at that index modulo
+   the number of test cases.
+*/
+static enum rx_status
+rxp_repetitions_update(struct rxp_repetitions *repetitions,
+                       size_t summary_count,
+                       const struct rx_summary *summaries,
+                       const int *completed)
+{
+    size_t i;
+
+    RX_ASSERT(repetitions != NULL);
+    RX_ASSERT(summaries != NULL);
+    RX_ASSERT(completed != NULL);
+
+    for (i = 0; i < summary_count; ++i) {
+        struct rxp_repetition *repetition;
+        const struct rx_summary *summary;
+        size_t run_count;
+
+        if (!completed[i]) {
+            continue;
+        }
+
+        repetition = &repetitions->array[i % repetitions->count];
+        summary = &summaries[i];
+        run_count = (size_t)repetition->summary.run_count;
+
+        if (run_count == repetition->elapsed_capacity) {
+            rx_uint64 *elapsed;
+            size_t capacity;
+
+            capacity = run_count == 0 ? 16 : run_count * 2;
+            elapsed = (rx_uint64 *)RX_REALLOC(repetition->elapsed,
+                                              sizeof *elapsed * capacity);
+            if (elapsed == NULL) {
+                RXP_LOG_DEBUG("failed to allocate the durations\n");
+                return RX_ERROR_ALLOCATION;
+            }
+
+            repetition->elapsed = elapsed;
+            repetition->elapsed_capacity = capacity;
+        }
+
+        repetition->elapsed[run_count] = summary->elapsed;
+        ++repetition->summary.run_count;
+
+        if (summary->failure_count == 0) {
+            ++repetition->summary.pass_count;
+            continue;
+        }
+
+        ++repetition->summary.fail_count;
+        repetitions->failed = 1;
+
+        if (!repetition->reported) {
+            rx_summary_print(summary);
+            repetition->reported = 1;
+        }
+    }
+
+    return RX_SUCCESS;
+}
+
+static void
+rxp_repetitions_report(struct rxp_repetitions *repetitions)
+{
+    size_t i;
+
+    RX_ASSERT(repetitions != NULL);
+
+    for (i = 0; i < repetitions->count; ++i) {
+        struct rxp_repetition *repetition;
+        size_t run_count;
+
+        repetition = &repetitions->array[i];
+        run_count = (size_t)repetition->summary.run_count;
+
+        if (run_count > 0) {
+            qsort(repetition->elapsed,
+                  run_count,
+                  sizeof *repetition->elapsed,
+                  rxp_compare_uint64);
+
+            repetition->summary.elapsed_min = repetition->elapsed[0];
+            repetition->summary.elapsed_max
+                = repetition->elapsed[run_count - 1];
+            repetition->summary.elapsed_median
+                = run_count % 2 == 1
+                      ? repetition->elapsed[run_count / 2]
+                      : (repetition->elapsed[run_count / 2 - 1]
+                         + repetition->elapsed[run_count / 2])
+                            / 2;
+        }
+
+        rx_repetition_summary_print(&repetition->summary);
+    }
+}
+
+struct rxp_usage_entry {
+    rx_uint64 value;
+    size_t index;
+};
+
+static int
+rxp_compare_usage_entries(const void *a, const void *b)
+{
+    const struct rxp_usage_entry *aa;
+    const struct rxp_usage_entry *bb;
+
+    aa = (const struct rxp_usage_entry *)a;
+    bb = (const struct rxp_usage_entry *)b;
+
+    /* Highest values first, in the test case order for equal values. */
+    if (aa->value != bb->value) {
+        return aa->value < bb->value ? 1 : -1;
+    }
+
+    return (aa->index > bb->index) - (aa->index < bb->index);
+}
+
+static void
+rxp_usage_value_print(rx_uint64 value, enum rx_usage_metric metric)
+{
+    switch (metric) {
+        case RX_USAGE_CPU_TIME:
+        case RX_USAGE_USER_TIME:
+        case RX_USAGE_SYSTEM_TIME:
+            fprintf(stderr,
+                    "%f ms",
+                    (double)value * (1000.0 / RXP_TICKS_PER_SECOND));
+            break;
+        case RX_USAGE_MAX_RSS_GROWTH:
+            fprintf(stderr, "%.0f kB", (double)value / 1024.0);
+            break;
+        default:
+            fprintf(stderr, "%.0f", (double)value);
+            break;
+    }
+}
+
+static enum rx_status
+rxp_print_top_usage(size_t test_case_count,
+                    const struct rx_summary *summaries,
+                    const int *completed,
+                    size_t top_count,
+                    enum rx_usage_metric metric)
+{
+    struct rxp_usage_entry *entries;
+    size_t entry_count;
+    size_t i;
+
+    RX_ASSERT(summaries != NULL);
+    RX_ASSERT(completed != NULL);
+
+    entries = (struct rxp_usage_entry *)RX_MALLOC(sizeof *entries
+                                                  * test_case_count);
+    if (entries == NULL) {
+        RXP_LOG_DEBUG("failed to allocate the resource usage entries\n");
+        return RX_ERROR_ALLOCATION;
+    }
+
+    entry_count = 0;
+    for (i = 0; i < test_case_count; ++i) {
+        if (completed[i] && summaries[i].resource_usage.available) {
+            entries[entry_count].value = rxp_resource_usage_get(
+                &summaries[i].resource_usage, metric);
+            entries[entry_count].index = i;
+            ++entry_count;
+        }
+    }
+
+    qsort(entries, entry_count, sizeof *entries, rxp_compare_usage_entries);
+
+    if (top_count > entry_count) {
+        top_count = entry_count;
+    }
+
+    fprintf(stderr,
+            "top %lu test cases by %s:\n",
+            (unsigned long)top_count,
+            rxp_usage_metric_descs[metric].label);
+    for (i = 0; i < top_count; ++i) {
+        const struct rx_summary *summary;
+
+        summary = &summaries[entries[i].index];
+        fprintf(stderr,
+                "%4lu. \"%s\" / \"%s\": ",
+                (unsigned long)(i + 1),
+                summary->test_case->suite_name,
+                summary->test_case->name);
+        rxp_usage_value_print(entries[i].value, metric);
+        fputc('\n', stderr);
+    }
+
+    RX_FREE(entries);
+    return RX_SUCCESS;
+}
+
+static enum rx_status
+rxp_run_selected_test_cases(const struct rx_run_config *config,
+                            const struct rxp_records *timings,
+                            struct rxp_repetitions *repetitions,
+                            size_t test_case_count,
+                            const struct rx_test_case *test_cases)
+{
+    size_t i;
+    size_t j;
+    size_t worker_count;
+    enum rx_status status;
+    struct rxp_runner runner;
+    size_t *order;
+
+    RX_ASSERT(config != NULL);
+    RX_ASSERT(timings != NULL);
+
+    if (test_case_count == 0) {
+        RXP_LOG_INFO("nothing to run\n");
+        return RX_SUCCESS;
+    }
+
+    RX_ASSERT(test_cases != NULL);
+
+    memset(&runner, 0, sizeof runner);
+    runner.test_case_count = test_case_count;
+    runner.test_cases = test_cases;
+    runner.status = RX_SUCCESS;
+    runner.timeout = config->timeout;
+    runner.fail_fast = config->fail_fast;
+    runner.quiet = repetitions != NULL;
+    runner.perf_counters = config->perf_counters;
+    order = NULL;
+
+    if (runner.perf_counters && !rxp_perf_counters_are_available()) {
+        RXP_LOG_WARNING("performance counters are not available, "
+                        "running without them\n");
+        runner.perf_counters = 0;
+    }
+
+    runner.profile_path = config->profile_path;
+
+    runner.summaries = (struct rx_summary *)RX_MALLOC(
+        sizeof *runner.summaries * test_case_count);
+    if (runner.summaries == NULL) {
+        RXP_LOG_DEBUG("failed to allocate the summaries\n");
+        return RX_ERROR_ALLOCATION;
+    }
+
+    runner.completed
+        = (int *)RX_MALLOC(sizeof *runner.completed * test_case_count);
+    if (runner.completed == NULL) {
+        RXP_LOG_DEBUG("failed to allocate the completion flags\n");
+        status = RX_ERROR_ALLOCATION;
+        goto summaries_cleanup;
+    }
+
+    memset(runner.completed, 0, sizeof *runner.completed * test_case_count);
+
+    for (i = 0; i < test_case_count; ++i) {
+        const struct rx_test_case *test_case;
+
+        test_case = &test_cases[i];
+
+        RX_ASSERT(test_case->suite_name != NULL);
+        RX_ASSERT(test_case->name != NULL);
+
+        status = rx_summary_initialize(&runner.summaries[i], test_case);
+        if (status != RX_SUCCESS) {
+            RXP_LOG_ERROR_2("failed to initialize the summary "
+                            "(suite: \"%s\", case: \"%s\")\n",
+                            test_case->suite_name,
+                            test_case->name);
+            goto summary_items_cleanup;
+        }
+    }
+
+    status = rxp_suite_fixtures_initialize(
+        &runner.suite_fixtures, test_case_count, test_cases);
+    if (status != RX_SUCCESS) {
+        goto summary_items_cleanup;
+    }
+
+    if (config->longest_first || config->shuffle) {
+        order = (size_t *)RX_MALLOC(sizeof *order * test_case_count);
+        if (order == NULL) {
+            RXP_LOG_DEBUG("failed to allocate the dispatch order\n");
+            status = RX_ERROR_ALLOCATION;
+            goto summary_items_cleanup;
+        }
+
+        if (config->shuffle) {
+            rxp_shuffle_test_cases(
+                order, test_case_count, config->shuffle_seed);
+        } else {
+            status = rxp_order_test_cases_by_duration(
+                order, timings, test_case_count, test_cases);
+            if (status != RX_SUCCESS) {
+                goto summary_items_cleanup;
+            }
+        }
+
+        runner.order = order;
+    }
+
+    for (j = 0; j < test_case_count; ++j) {
+        if (config->timeout > 0.0 || test_cases[j].config.timeout > 0.0) {
+            runner.time_begins = (uint64_t *)RX_MALLOC(
+                sizeof *runner.time_begins * test_case_count);
+            if (runner.time_begins == NULL) {
+                RXP_LOG_DEBUG("failed to allocate the start times\n");
+                status = RX_ERROR_ALLOCATION;
+                goto summary_items_cleanup;
+            }
+
+            memset(runner.time_begins,
+                   0,
+                   sizeof *runner.time_begins * test_case_count);
+            break;
+        }
+    }
+
+    worker_count = config->job_count > 1 ? (size_t)config->job_count : 1;
+    if (worker_count > test_case_count) {
+        worker_count = test_case_count;
+    }
+
+    /* The signal handler is inherited by the isolated worker processes. */
+    if (runner.profile_path != NULL && rxp_profiler_install() != RX_SUCCESS) {
+        RXP_LOG_WARNING("the profiler is not available, "
+                        "running without it\n");
+        runner.profile_path = NULL;
+    }
+
+    if (config->isolate) {
+#if RXP_PROCESSES
+        status = rxp_runner_execute_isolated(&runner, worker_count);
+#else
+        RXP_LOG_WARNING("isolating the test cases isn't supported on this "
+                        "platform, running them in-process instead\n");
+        status = rxp_runner_execute(&runner, worker_count);
+#endif
+    } else {
+        status = rxp_runner_execute(&runner, worker_count);
+    }
+
+    if (runner.profile_path != NULL) {
+        rxp_profiler_uninstall();
+    }
+
+    rxp_runner_print_remaining(&runner);
+
+    /* Always shown since a failing order can't be replayed without it. */
+    if (config->shuffle) {
+        char seed[RXP_UINT64_STR_SIZE];
+
+        rxp_str_from_uint64(seed, config->shuffle_seed);
+        fprintf(stderr,
+                "shuffled the test cases with the seed %s (replay with "
+                "`--shuffle=%s`)\n",
+                seed,
+                seed);
+    }
+
+    if (repetitions == NULL && config->top_count > 0 && status == RX_SUCCESS) {
+        status = rxp_print_top_usage(test_case_count,
+                                     runner.summaries,
+                                     runner.completed,
+                                     (size_t)config->top_count,
+                                     config->top_metric);
+    }
+
+    if (repetitions != NULL && status == RX_SUCCESS) {
+        status = rxp_repetitions_update(
+            repetitions, test_case_count, runner.summaries, runner.completed);
+    }
+
+    if (config->timings_path != NULL) {
+        enum rx_status timings_status;
+
+        timings_status = rxp_save_timings(config->timings_path,
+                                          test_case_count,
+                                          runner.summaries,
+                                          runner.completed);
+        if (timings_status != RX_SUCCESS) {
+            RXP_LOG_WARNING_1("failed to save the timings to `%s`\n",
+                              config->timings_path);
+        }
+    }
+
+    if (config->failures_path != NULL) {
+        enum rx_status failures_status;
+
+        failures_status = rxp_save_failures(config->failures_path,
+                                            test_case_count,
+                                            runner.summaries,
+                                            runner.completed);
+        if (failures_status != RX_SUCCESS) {
+            RXP_LOG_WARNING_1("failed to save the failures to `%s`\n",
+                              config->failures_path);
+        }
+    }
+
+    if (status == RX_SUCCESS) {
+        for (j = 0; j < test_case_count; ++j) {
+            size_t k;
+            struct rx_summary *summary;
+
+            summary = &runner.summaries[j];
+
+            for (k = 0; k < summary->failure_count; ++k) {
+                const struct rx_failure *failure;
+
+                failure = &summary->failures[k];
+                if (failure->severity == RX_FATAL) {
+                    status = RX_ERROR_ABORTED;
+                    goto summary_items_cleanup;
+                }
+            }
+        }
+    }
+
+summary_items_cleanup:
+    rxp_suite_fixtures_terminate(&runner.suite_fixtures);
+
+    while (i-- > 0) {
+        rx_summary_terminate(&runner.summaries[i]);
+    }
+
+    RX_FREE(runner.time_begins);
+    RX_FREE(order);
+    RX_FREE(runner.completed);
+
+summaries_cleanup:
+    RX_FREE(runner.summaries);
+
+    return status;
+}
+
+static enum rx_status
+rxp_run_repeated_test_cases(const struct rx_run_config *config,
+                            const struct rxp_records *timings,
+                            size_t test_case_count,
+                            const struct rx_test_case *test_cases)
+{
+    enum rx_status status;
+    struct rx_run_config batch_config;
+    struct rxp_repetitions repetitions;
+    struct rx_test_case *batch;
+    size_t batch_size;
+    size_t remaining;
+    rx_uint64 seed_state;
+    int first_batch;
+    int aborted;
+
+    RX_ASSERT(config != NULL);
+
+    if ((config->repeat_count <= 1 && !config->until_fail)
+        || test_case_count == 0) {
+        return rxp_run_selected_test_cases(
+            config, timings, NULL, test_case_count, test_cases);
+    }
+
+    RX_ASSERT(test_cases != NULL);
+
+    /* Without an explicit count, repeat until a failure occurs. */
+    remaining = config->repeat_count > 0 ? (size_t)config->repeat_count
+                                         : (size_t)-1;
+    batch_size = remaining < RXP_REPETITION_BATCH_SIZE
+                     ? remaining
+                     : RXP_REPETITION_BATCH_SIZE;
+
+    if (test_case_count > (size_t)-1 / batch_size) {
+        RXP_LOG_ERROR("too many repetitions\n");
+        return RX_ERROR_MAX_SIZE_EXCEEDED;
+    }
+
+    batch = (struct rx_test_case *)RX_MALLOC(sizeof *batch * test_case_count
+                                             * batch_size);
+    if (batch == NULL) {
+        RXP_LOG_DEBUG("failed to allocate the repeated test cases\n");
+        return RX_ERROR_ALLOCATION;
+    }
+
+    status = rxp_repetitions_initialize(
+        &repetitions, test_case_count, test_cases);
+    if (status != RX_SUCCESS) {
+        RX_FREE(batch);
+        return status;
+    }
+
+    batch_config = *config;
+    batch_config.fail_fast |= config->until_fail;
+    seed_state = config->shuffle_seed;
+    first_batch = 1;
+
+    aborted = 0;
+    while (remaining > 0) {
+        size_t i;
+        size_t repeat_count;
+
+        /* Each batch after the first one explores a new order. */
+        if (batch_config.shuffle && !first_batch) {
+            batch_config.shuffle_seed = rxp_random_next(&seed_state);
+        }
+
+        first_batch = 0;
+
+        repeat_count = remaining < batch_size ? remaining : batch_size;
+        for (i = 0; i < test_case_count * repeat_count; ++i) {
+            batch[i] = test_cases[i % test_case_count];
+        }
+
+        status = rxp_run_selected_test_cases(&batch_config,
+                                             timings,
+                                             &repetitions,
+                                             test_case_count * repeat_count,
+                                             batch);
+        if (status == RX_ERROR_ABORTED) {
+            aborted = 1;
+            status = RX_SUCCESS;
+        } else if (status != RX_SUCCESS) {
+            break;
+        }
+
+        if (batch_config.fail_fast && repetitions.failed) {
+            break;
+        }
+
+        if (remaining != (size_t)-1) {
+            remaining -= repeat_count;
+        }
+    }
+
+    rxp_repetitions_report(&repetitions);
+    rxp_repetitions_terminate(&repetitions);
+    RX_FREE(batch);
+
+    if (status == RX_SUCCESS && aborted) {
+        status = RX_ERROR_ABORTED;
+    }
+
+    return status;
+}
+
+RXP_MAYBE_UNUSED static enum rx_status
+rxp_run_test_cases(const struct rx_run_config *config,
+                   size_t test_case_count,
+                   const struct rx_test_case *test_cases)
+{
+    enum rx_status status;
+    struct rxp_records timings;
+    struct rxp_records failures;
+    struct rx_test_case *selection;
+    size_t selection_count;
+
+    RX_ASSERT(config != NULL);
+
+    rxp_records_initialize(&timings);
+    rxp_records_initialize(&failures);
+
+    if (config->timings_path != NULL
+        && (config->longest_first || config->shard_count > 0)) {
+        status = rxp_records_load(&timings, config->timings_path);
+        if (status != RX_SUCCESS) {
+            goto records_cleanup;
+        }
+    }
+
+    if (config->failures_path != NULL
+        && (config->failed_first || config->only_failed)) {
+        status = rxp_records_load(&failures, config->failures_path);
+        if (status != RX_SUCCESS) {
+            goto records_cleanup;
+        }
+    }
+
+    if (test_case_count == 0
+        || (config->shard_count == 0 && failures.count == 0)) {
+        status = rxp_run_repeated_test_cases(
+            config, &timings, test_case_count, test_cases);
+        goto records_cleanup;
+    }
+
+    RX_ASSERT(test_cases != NULL);
+
+    selection = (struct rx_test_case *)RX_MALLOC(sizeof *selection
+                                                 * test_case_count);
+    if (selection == NULL) {
+        RXP_LOG_DEBUG("failed to allocate the selected test cases\n");
+        status = RX_ERROR_ALLOCATION;
+        goto records_cleanup;
+    }
+
+    if (config->shard_count > 0) {
+        status = rxp_shard_test_cases(&selection_count,
+                                      selection,
+                                      config,
+                                      &timings,
+                                      test_case_count,
+                                      test_cases);
+        if (status != RX_SUCCESS) {
+            goto selection_cleanup;
+        }
+    } else {
+        memcpy(selection, test_cases, sizeof *selection * test_case_count);
+        selection_count = test_case_count;
+    }
+
+    if (failures.count > 0) {
+        rxp_select_failed_test_cases(
+            &selection_count, selection, &failures, config->only_failed);
+    }
+
+    status = rxp_run_repeated_test_cases(
+        config, &timings, selection_count, selection);
+
+selection_cleanup:
+    RX_FREE(selection);
+
+records_cleanup:
+    rxp_records_terminate(&failures);
+    rxp_records_terminate(&timings);
+    return status;
+}
+
+RXP_MAYBE_UNUSED static enum rx_status
+rxp_run_registered_test_cases(const struct rx_run_config *config)
+{
+    enum rx_status out;
+    rx_size test_case_count;
+    struct rx_test_case *test_cases;
+
+    rx_enumerate_test_cases(&test_case_count, NULL);
+    if (test_case_count == 0) {
+        return rxp_run_test_cases(config, 0, NULL);
+    }
+
+    test_cases = (struct rx_test_case *)RX_MALLOC(sizeof *test_cases
+                                                  * test_case_count);
+    if (test_cases == NULL) {
+        RXP_LOG_ERROR("failed to allocate the test cases\n");
+        return RX_ERROR_ALLOCATION;
+    }
+
+    rx_enumerate_test_cases(&test_case_count, test_cases);
+    out = rxp_run_test_cases(config, test_case_count, test_cases);
+    RX_FREE(test_cases);
+    return out;
+}
+
+/* Implementation: Benchmark Environment                           O-(''Q)
+   -------------------------------------------------------------------------- */
+
+/*
+   Measures taken on a thread that migrates between CPUs, or on CPUs that
+   adjust their frequency, vary from one repetition to the next. The stable
+   mode pins the benchmark thread to the CPU that it's currently running on,
+   and warns about the frequency scaling settings that are known to add noise.
+
+   The affinity is set through the raw system calls, which don't depend on
+   the GNU extensions that `cpu_set_t` requires.
+*/
+
+#if defined(RXP_PLATFORM_LINUX) && defined(__NR_sched_getaffinity)            \
+    && defined(__NR_sched_setaffinity) && defined(__NR_getcpu)
+#define RXP_CPU_PINNING 1
+#endif
+
+#if !defined(RXP_CPU_PINNING)
+#define RXP_CPU_PINNING 0
+#endif
+
+#define RXP_CPU_MASK_SIZE 16
+#define RXP_CPU_MASK_BITS (sizeof(unsigned long) * 8)
+
+struct rxp_cpu_affinity {
+    int pinned;
+    unsigned int cpu;
+    unsigned long mask[RXP_CPU_MASK_SIZE];
+};
+
+#if RXP_CPU_PINNING
+static enum rx_status
+rxp_cpu_pin(struct rxp_cpu_affinity *affinity)
+{
+    unsigned long mask[RXP_CPU_MASK_SIZE];
+
+    RX_ASSERT(affinity != NULL);
+
+    affinity->pinned = 0;
+
+    if (syscall(__NR_getcpu, &affinity->cpu, NULL, NULL) != 0) {
+        RXP_LOG_DEBUG("failed to retrieve the current CPU\n");
+        return RX_ERROR;
+    }
+
+    if (affinity->cpu >= RXP_CPU_MASK_SIZE * RXP_CPU_MASK_BITS) {
+        RXP_LOG_DEBUG_1("the CPU %u is out of the mask's range\n",
+                        affinity->cpu);
+        return RX_ERROR;
+    }
+
+    memset(affinity->mask, 0, sizeof affinity->mask);
+    if (syscall(__NR_sched_getaffinity,
+                0,
+                sizeof affinity->mask,
+                affinity->mask)
+        < 0) {
+        RXP_LOG_DEBUG("failed to retrieve the CPU affinity\n");
+        return RX_ERROR;
+    }
+
+    memset(mask, 0, sizeof mask);
+    mask[affinity->cpu / RXP_CPU_MASK_BITS]
+        = 1ul << (affinity->cpu % RXP_CPU_MASK_BITS);
+    if (syscall(__NR_sched_setaffinity, 0, sizeof mask, mask) != 0) {
+        RXP_LOG_DEBUG("failed to set the CPU affinity\n");
+        return RX_ERROR;
+    }
+
+    affinity->pinned = 1;
+    return RX_SUCCESS;
+}
+
+static void
+rxp_cpu_unpin(struct rxp_cpu_affinity *affinity)
+{
+    RX_ASSERT(affinity != NULL);
+
+    if (!affinity->pinned) {
+        return;
+    }
+
+    if (syscall(__NR_sched_setaffinity,
+                0,
+                sizeof affinity->mask,
+                affinity->mask)
+        != 0) {
+        RXP_LOG_DEBUG("failed to restore the CPU affinity\n");
+    }
+
+    affinity->pinned = 0;
+}
+#else
+static enum rx_status
+rxp_cpu_pin(struct rxp_cpu_affinity *affinity)
+{
+    RX_ASSERT(affinity != NULL);
+
+    affinity->pinned = 0;
+    return RX_ERROR;
+}
+
+static void
+rxp_cpu_unpin(struct rxp_cpu_affinity *affinity)
+{
+    RX_ASSERT(affinity != NULL);
+
+    affinity->pinned = 0;
+}
+#endif
+
+#if defined(RXP_PLATFORM_LINUX)
+/*
+   Read the first line of a sysfs file, without its line feed. Returns whether
+   the file could be read.
+*/
+static int
+rxp_sysfs_read(char *buf, size_t size, const char *path)
+{
+    FILE *file;
+    char *end;
+
+    RX_ASSERT(buf != NULL);
+    RX_ASSERT(size > 0);
+    RX_ASSERT(path != NULL);
+
+    file = fopen(path, "r");
+    if (file == NULL) {
+        return 0;
+    }
+
+    if (fgets(buf, (int)size, file) == NULL) {
+        fclose(file);
+        return 0;
+    }
+
+    fclose(file);
+
+    end = strchr(buf, '\n');
+    if (end != NULL) {
+        *end = '\0';
+    }
+
+    return 1;
+}
+
+static void
+rxp_cpu_check_frequency_scaling(const struct rxp_cpu_affinity *affinity)
+{
+    char path[64];
+    char value[32];
+
+    RX_ASSERT(affinity != NULL);
+
+    if (affinity->pinned) {
+        sprintf(path,
+                "/sys/devices/system/cpu/cpu%u/cpufreq/scaling_governor",
+                affinity->cpu);
+    } else {
+        strcpy(path, "/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor");
+    }
+
+    if (rxp_sysfs_read(value, sizeof value, path)
+        && strcmp(value, "performance") != 0) {
+        RXP_LOG_WARNING_1("the CPU frequency governor is \"%s\" rather than "
+                          "\"performance\", the measures might be noisy\n",
+                          value);
+    }
+
+    if ((rxp_sysfs_read(value,
+                        sizeof value,
+                        "/sys/devices/system/cpu/intel_pstate/no_turbo")
+         && strcmp(value, "0") == 0)
+        || (rxp_sysfs_read(value,
+                           sizeof value,
+                           "/sys/devices/system/cpu/cpufreq/boost")
+            && strcmp(value, "1") == 0)) {
+        RXP_LOG_WARNING("the CPU frequency boost is enabled, "
+                        "the measures might be noisy\n");
+    }
+}
+#else
+static void
+rxp_cpu_check_frequency_scaling(const struct rxp_cpu_affinity *affinity)
+{
+    RX_ASSERT(affinity != NULL);
+
+    RXP_UNUSED(affinity);
+}
+#endif
+
+/* Implementation: Benchmark Runner                                O-(''Q)
+   -------------------------------------------------------------------------- */
+
+/*
+   Benchmarks are run serially, one after the other, to avoid them competing
+   for the same resources. The body of a benchmark is called in a loop whose
+   iteration count is first calibrated so that each repetition lasts long
+   enough to be measured accurately, and each repetition then provides one
+   sample of the time spent per iteration.
+*/
+
+#define RXP_BENCHMARK_DEFAULT_MIN_TIME 0.05
+#define RXP_BENCHMARK_DEFAULT_REPETITION_COUNT 10
+#define RXP_BENCHMARK_DEFAULT_MAX_CV 2.0
+#define RXP_BENCHMARK_DEFAULT_MAX_REPETITION_COUNT 100
+#define RXP_BENCHMARK_MAX_ITERATION_COUNT 1000000000ul
+
+/*
+   Settings of a benchmark run, resolved from the benchmark's configuration
+   and the runner's. A maximum coefficient of variation of `0` disables
+   the additional repetitions.
+*/
+struct rxp_benchmark_settings {
+    double min_time;
+    size_t repetition_count;
+    size_t warm_up_count;
+    double max_cv;
+    size_t max_repetition_count;
+};
+
+static void
+rxp_benchmark_iterate(struct rx_context *context,
+                      const struct rx_benchmark *benchmark,
+                      void *data,
+                      rx_uint64 iteration_count)
+{
+    rx_uint64 i;
+
+    for (i = 0; i < iteration_count; ++i) {
+        benchmark->run(context, data);
+    }
+}
+
+static void
+rxp_benchmark_timing_pause(struct rxp_benchmark_timing *timing)
+{
+    uint64_t end;
+
+    RX_ASSERT(timing != NULL);
+
+    if (timing->timer == NULL || timing->paused) {
+        return;
+    }
+
+    timing->paused = 1;
+    if (rxp_timer_read_end(&end, timing->timer) != RX_SUCCESS) {
+        timing->status = RX_ERROR;
+        return;
+    }
+
+    timing->elapsed += rxp_timer_get_elapsed(timing->timer, timing->begin, end);
+
+    /* The CPU time is read outside of the span being timed, for the reads to
+       leave the wall-clock time untouched when the timing is paused for each
+       iteration. The cost of the reads of both clocks that it encloses is
+       subtracted instead. */
+    if (timing->cpu_valid) {
+        uint64_t cpu_end;
+
+        if (rxp_get_thread_cpu_time(&cpu_end) == RX_SUCCESS
+            && cpu_end >= timing->cpu_begin) {
+            double cpu_elapsed;
+
+            cpu_elapsed = (double)(cpu_end - timing->cpu_begin)
+                          - timing->timer->cpu_overhead
+                          - timing->timer->overhead;
+            if (cpu_elapsed > 0.0) {
+                timing->cpu_elapsed += cpu_elapsed;
+            }
+        } else {
+            timing->cpu_valid = 0;
+        }
+    }
+}
+
+static void
+rxp_benchmark_timing_resume(struct rxp_benchmark_timing *timing)
+{
+    RX_ASSERT(timing != NULL);
+
+    if (timing->timer == NULL || !timing->paused) {
+        return;
+    }
+
+    timing->paused = 0;
+    if (timing->cpu_valid
+        && rxp_get_thread_cpu_time(&timing->cpu_begin) != RX_SUCCESS) {
+        timing->cpu_valid = 0;
+    }
+
+    if (rxp_timer_read_begin(&timing->begin, timing->timer) != RX_SUCCESS) {
+        timing->status = RX_ERROR;
+    }
+}
+
+/*
+   Time a batch of iterations. Fatal assessments made within the benchmark's
+   body jump back here, interrupting the batch. The benchmark's body can pause
+   and resume the timing, to leave out the preparation of each iteration.
+   The CPU time elapsed is negative when it couldn't be measured.
+*/
+static enum rx_status
+rxp_benchmark_measure(double *elapsed,
+                      double *cpu_elapsed,
+                      struct rx_context *context,
+                      const struct rxp_timer *timer,
+                      const struct rx_benchmark *benchmark,
+                      void *data,
+                      rx_uint64 iteration_count)
+{
+    struct rxp_benchmark_timing *timing;
+
+    RX_ASSERT(elapsed != NULL);
+    RX_ASSERT(cpu_elapsed != NULL);
+    RX_ASSERT(context != NULL);
+    RX_ASSERT(timer != NULL);
+    RX_ASSERT(benchmark != NULL);
+
+    timing = &context->benchmark_timing;
+    timing->timer = timer;
+    timing->elapsed = 0.0;
+    timing->cpu_elapsed = 0.0;
+    timing->cpu_valid = 1;
+    timing->paused = 1;
+    timing->status = RX_SUCCESS;
+
+    rxp_benchmark_timing_resume(timing);
+    if (timing->status == RX_SUCCESS && setjmp(context->env) == 0) {
+        rxp_benchmark_iterate(context, benchmark, data, iteration_count);
+    }
+
+    rxp_benchmark_timing_pause(timing);
+    timing->timer = NULL;
+
+    *elapsed = timing->elapsed;
+    *cpu_elapsed = timing->cpu_valid ? timing->cpu_elapsed : -1.0;
+    return timing->status;
+}
+
+static rx_uint64
+rxp_benchmark_get_next_iteration_count(rx_uint64 iteration_count,
+                                       double elapsed,
+                                       double min_elapsed)
+{
+    double multiplier;
+    double next;
+
+    /* Only extrapolate from measures that are long enough to be trusted,
+       aiming slightly past the target to avoid undershooting it again. */
+    if (elapsed > min_elapsed / 10.0) {
+        multiplier = 1.4 * min_elapsed / elapsed;
+        if (multiplier > 10.0) {
+            multiplier = 10.0;
+        }
+    } else {
+        multiplier = 10.0;
+    }
+
+    next = (double)iteration_count * multiplier;
+    if (next >= (double)RXP_BENCHMARK_MAX_ITERATION_COUNT) {
+        return RXP_BENCHMARK_MAX_ITERATION_COUNT;
+    }
+
+    return (rx_uint64)next > iteration_count ? (rx_uint64)next
+                                             : iteration_count + 1;
+}
+
+static int
+rxp_compare_samples(const void *a, const void *b)
+{
+    double aa;
+    double bb;
+
+    aa = *(const double *)a;
+    bb = *(const double *)b;
+    return (aa > bb) - (aa < bb);
+}
+
+/*
+   The samples are left in the order of the repetitions, the median being
+   taken from a sorted copy of them.
+*/
+static void
+rxp_samples_compute_statistics(double *median,
+                               double *mean,
+                               double *stddev,
+                               double *sorted_samples,
+                               const double *samples,
+                               size_t count)
+{
+    size_t i;
+    double sum;
+
+    RX_ASSERT(median != NULL);
+    RX_ASSERT(mean != NULL);
+    RX_ASSERT(stddev != NULL);
+    RX_ASSERT(sorted_samples != NULL);
+    RX_ASSERT(samples != NULL);
+    RX_ASSERT(count > 0);
+
+    memcpy(sorted_samples, samples, sizeof *samples * count);
+    qsort(sorted_samples, count, sizeof *sorted_samples, rxp_compare_samples);
+
+    *median = count % 2 == 1 ? sorted_samples[count / 2]
+                             : (sorted_samples[count / 2 - 1]
+                                + sorted_samples[count / 2])
+                                   / 2.0;
+
+    sum = 0.0;
+    for (i = 0; i < count; ++i) {
+        sum += samples[i];
+    }
+
+    *mean = sum / (double)count;
+
+    sum = 0.0;
+    for (i = 0; i < count; ++i) {
+        double deviation;
+
+        deviation = samples[i] - *mean;
+        sum += deviation * deviation;
+    }
+
+    *stddev = count > 1 ? sqrt(sum / (double)(count - 1)) : 0.0;
+}
+
+static void
+rxp_benchmark_summary_compute_statistics(struct rx_benchmark_summary *summary,
+                                         double *sorted_samples)
+{
+    RX_ASSERT(summary != NULL);
+    RX_ASSERT(sorted_samples != NULL);
+
+    if (summary->sample_count == 0) {
+        return;
+    }
+
+    rxp_samples_compute_statistics(&summary->median,
+                                   &summary->mean,
+                                   &summary->stddev,
+                                   sorted_samples,
+                                   summary->samples,
+                                   (size_t)summary->sample_count);
+
+    if (summary->cpu_samples != NULL) {
+        rxp_samples_compute_statistics(&summary->cpu_median,
+                                       &summary->cpu_mean,
+                                       &summary->cpu_stddev,
+                                       sorted_samples,
+                                       summary->cpu_samples,
+                                       (size_t)summary->sample_count);
+    }
+}
+
+static void
+rxp_timer_print(const struct rxp_timer *timer)
+{
+    RX_ASSERT(timer != NULL);
+
+    if (timer->tsc) {
+        fprintf(stderr,
+                "[TIMER] time-stamp counter at %.3f GHz "
+                "(overhead: %f ns, resolution: %f ns)\n",
+                1.0 / timer->ns_per_tick,
+                timer->overhead,
+                timer->resolution);
+    } else {
+        fprintf(stderr,
+                "[TIMER] real time (overhead: %f ns, resolution: %f ns)\n",
+                timer->overhead,
+                timer->resolution);
+    }
+}
+
+static enum rx_status
+rxp_benchmark_run(struct rx_benchmark_summary *summary,
+                  const struct rxp_timer *timer,
+                  const struct rx_benchmark *benchmark,
+                  const struct rxp_benchmark_settings *settings)
+{
+    enum rx_status status;
+    struct rx_test_case test_case;
+    struct rx_summary assessments;
+    struct rx_context context;
+    void *data;
+    double min_elapsed;
+    double elapsed;
+    double cpu_elapsed;
+    rx_uint64 iteration_count;
+    size_t capacity;
+    double *sorted_samples;
+    size_t i;
+
+    RX_ASSERT(summary != NULL);
+    RX_ASSERT(timer != NULL);
+    RX_ASSERT(benchmark != NULL);
+    RX_ASSERT(benchmark->suite_name != NULL);
+    RX_ASSERT(benchmark->name != NULL);
+    RX_ASSERT(benchmark->run != NULL);
+    RX_ASSERT(settings != NULL);
+    RX_ASSERT(settings->min_time > 0.0);
+    RX_ASSERT(settings->repetition_count > 0);
+
+    if (benchmark->config.skip) {
+        summary->skipped = 1;
+        return RX_SUCCESS;
+    }
+
+    capacity = settings->repetition_count;
+    if (settings->max_cv > 0.0 && settings->max_repetition_count > capacity) {
+        capacity = settings->max_repetition_count;
+    }
+
+    RX_FREE(summary->samples);
+    summary->sample_count = 0;
+    summary->samples
+        = (double *)RX_MALLOC(sizeof *summary->samples * capacity);
+    if (summary->samples == NULL) {
+        summary->error = "failed to allocate the samples\0";
+        RXP_LOG_ERROR_2("failed to allocate the samples "
+                        "(suite: \"%s\", case: \"%s\")\n",
+                        benchmark->suite_name,
+                        benchmark->name);
+        return RX_ERROR_ALLOCATION;
+    }
+
+    sorted_samples = (double *)RX_MALLOC(sizeof *sorted_samples * capacity);
+    if (sorted_samples == NULL) {
+        summary->error = "failed to allocate the samples\0";
+        RXP_LOG_ERROR_2("failed to allocate the samples "
+                        "(suite: \"%s\", case: \"%s\")\n",
+                        benchmark->suite_name,
+                        benchmark->name);
+        return RX_ERROR_ALLOCATION;
+    }
+
+    RX_FREE(summary->cpu_samples);
+    summary->cpu_samples
+        = (double *)RX_MALLOC(sizeof *summary->cpu_samples * capacity);
+    if (summary->cpu_samples == NULL) {
+        RXP_LOG_WARNING_2("failed to allocate the CPU time samples, "
+                          "measuring the benchmark without them "
+                          "(suite: \"%s\", case: \"%s\")\n",
+                          benchmark->suite_name,
+                          benchmark->name);
+    }
+
+    /* The assessments made within the benchmark's body are recorded as if
+       it was a test case. */
+    memset(&test_case, 0, sizeof test_case);
+    test_case.suite_name = benchmark->suite_name;
+    test_case.name = benchmark->name;
+    test_case.run = benchmark->run;
+
+    status = rx_summary_initialize(&assessments, &test_case);
+    if (status != RX_SUCCESS) {
+        RX_FREE(sorted_samples);
+        return status;
+    }
+
+    context.summary = &assessments;
+    context.suite_data = NULL;
+    context.benchmark_arg = summary->arg;
+    context.benchmark_timing.timer = NULL;
+    context.alloc_scope.active = 0;
+
+    if (benchmark->config.fixture.size > 0) {
+        data = RX_MALLOC(benchmark->config.fixture.size);
+        if (data == NULL) {
+            summary->error = "failed to allocate the data\0";
+            RXP_LOG_ERROR_2("failed to allocate the data "
+                            "(suite: \"%s\", case: \"%s\")\n",
+                            benchmark->suite_name,
+                            benchmark->name);
+            status = RX_ERROR_ALLOCATION;
+            goto assessments_cleanup;
+        }
+    } else {
+        data = NULL;
+    }
+
+    if (benchmark->config.fixture.config.set_up != NULL) {
+        status = benchmark->config.fixture.config.set_up(&context, data);
+        if (status != RX_SUCCESS) {
+            summary->error = "failed to set-up the fixture\0";
+            RXP_LOG_ERROR_2("failed to set-up the fixture "
+                            "(suite: \"%s\", case: \"%s\")\n",
+                            benchmark->suite_name,
+                            benchmark->name);
+            goto data_cleanup;
+        }
+    }
+
+    if (settings->warm_up_count > 0) {
+        status = rxp_benchmark_measure(&elapsed,
+                                       &cpu_elapsed,
+                                       &context,
+                                       timer,
+                                       benchmark,
+                                       data,
+                                       (rx_uint64)settings->warm_up_count);
+        if (status != RX_SUCCESS || assessments.failure_count > 0) {
+            goto tear_down;
+        }
+    }
+
+    /* Keep the error due to the timer's resolution below 0.1%. */
+    min_elapsed = settings->min_time * (double)RXP_TICKS_PER_SECOND;
+    if (min_elapsed < timer->resolution * 1000.0) {
+        min_elapsed = timer->resolution * 1000.0;
+    }
+
+    /* Calibrate the number of iterations, which also warms up the caches. */
+    iteration_count = 1;
+    for (;;) {
+        status = rxp_benchmark_measure(&elapsed,
+                                       &cpu_elapsed,
+                                       &context,
+                                       timer,
+                                       benchmark,
+                                       data,
+                                       iteration_count);
+        if (status != RX_SUCCESS || assessments.failure_count > 0) {
+            goto tear_down;
+        }
+
+        if (elapsed >= min_elapsed
+            || iteration_count >= RXP_BENCHMARK_MAX_ITERATION_COUNT) {
+            break;
+        }
+
+        iteration_count = rxp_benchmark_get_next_iteration_count(
+            iteration_count, elapsed, min_elapsed);
+    }
+
+    summary->iteration_count = iteration_count;
+
+    /* Add repetitions until the coefficient of variation, in percent, is low
+       enough, if requested. */
+    for (i = 0; i < capacity; ++i) {
+        if (i >= settings->repetition_count) {
+            rxp_benchmark_summary_compute_statistics(summary,
+                                                     sorted_samples);
+            if (!(summary->mean > 0.0)
+                || summary->stddev / summary->mean * 100.0 <= settings->max_cv) {
+                break;
+            }
+        }
+
+        status = rxp_benchmark_measure(&elapsed,
+                                       &cpu_elapsed,
+                                       &context,
+                                       timer,
+                                       benchmark,
+                                       data,
+                                       iteration_count);
+        if (status != RX_SUCCESS || assessments.failure_count > 0) {
+            goto tear_down;
+        }
+
+        summary->samples[i] = elapsed / (double)iteration_count;
+        if (summary->cpu_samples != NULL && cpu_elapsed < 0.0) {
+            RX_FREE(summary->cpu_samples);
+            summary->cpu_samples = NULL;
+        } else if (summary->cpu_samples != NULL) {
+            summary->cpu_samples[i] = cpu_elapsed / (double)iteration_count;
+        }
+
+        ++summary->sample_count;
+    }
+
+    rxp_benchmark_summary_compute_statistics(summary, sorted_samples);
+    summary->unstable = settings->max_cv > 0.0 && summary->mean > 0.0
+                        && summary->stddev / summary->mean * 100.0
+                               > settings->max_cv;
+    summary->metrics = assessments.metrics;
+
+tear_down:
+    if (status != RX_SUCCESS) {
+        summary->error = "failed to measure the time elapsed\0";
+        RXP_LOG_ERROR_2("failed to measure the time elapsed "
+                        "(suite: \"%s\", case: \"%s\")\n",
+                        benchmark->suite_name,
+                        benchmark->name);
+    } else if (assessments.failure_count > 0) {
+        summary->error = "an assessment failed within the benchmark\0";
+    }
+
+    if (benchmark->config.fixture.config.tear_down != NULL) {
+        benchmark->config.fixture.config.tear_down(&context, data);
+    }
+
+data_cleanup:
+    RX_FREE(data);
+
+assessments_cleanup:
+    RX_FREE(sorted_samples);
+
+    /* Hand the failures over to the summary for them to be reported. */
+    if (assessments.failure_count > 0) {
+        summary->failures = assessments.failures;
+        summary->failure_count = assessments.failure_count;
+        return status;
+    }
+
+    rx_summary_terminate(&assessments);
+    return status;
+}
+
+/*
+   Benchmarks defining an argument range are run once per argument, with each
+   run being named after the benchmark followed by a slash and the argument.
+*/
+
+#define RXP_BENCHMARK_ARG_SUFFIX_SIZE (RXP_UINT64_STR_SIZE + 1)
+#define RXP_BENCHMARK_DEFAULT_RANGE_MULTIPLIER 2
+
+static void
+rxp_benchmark_summary_get_arg_suffix(
+    char *suffix,
+    const struct rx_benchmark_summary *summary)
+{
+    RX_ASSERT(suffix != NULL);
+    RX_ASSERT(summary != NULL);
+    RX_ASSERT(summary->benchmark != NULL);
+
+    if (summary->benchmark->config.range_max == 0) {
+        suffix[0] = '\0';
+        return;
+    }
+
+    suffix[0] = '/';
+    rxp_str_from_uint64(&suffix[1], summary->arg);
+}
+
+static enum rx_status
+rxp_benchmark_get_args(size_t *arg_count,
+                       rx_uint64 **args,
+                       const struct rx_benchmark_config *config)
+{
+    rx_uint64 multiplier;
+    rx_uint64 arg;
+    size_t capacity;
+
+    RX_ASSERT(arg_count != NULL);
+    RX_ASSERT(args != NULL);
+    RX_ASSERT(config != NULL);
+
+    multiplier = config->range_multiplier > 1
+                     ? config->range_multiplier
+                     : RXP_BENCHMARK_DEFAULT_RANGE_MULTIPLIER;
+
+    *arg_count = 0;
+    *args = NULL;
+    capacity = 0;
+    arg = config->range_max > 0 ? config->range_min : 0;
+    for (;;) {
+        rx_uint64 next;
+
+        if (*arg_count == capacity) {
+            rx_uint64 *array;
+
+            capacity = capacity == 0 ? 16 : capacity * 2;
+            array = (rx_uint64 *)RX_REALLOC(*args, sizeof *array * capacity);
+            if (array == NULL) {
+                RXP_LOG_DEBUG("failed to allocate the benchmark arguments\n");
+                RX_FREE(*args);
+                *args = NULL;
+                return RX_ERROR_ALLOCATION;
+            }
+
+            *args = array;
+        }
+
+        (*args)[(*arg_count)++] = arg;
+
+        if (arg >= config->range_max) {
+            break;
+        }
+
+        /* Always end the range with its upper bound. */
+        next = arg * multiplier;
+        if (next / multiplier != arg || next > config->range_max) {
+            next = config->range_max;
+        } else if (next <= arg) {
+            next = arg + 1;
+        }
+
+        arg = next;
+    }
+
+    return RX_SUCCESS;
+}
+
+/*
+   The asymptotic complexity of a benchmark is estimated by fitting the median
+   time per iteration measured for each argument against each complexity
+   model. Each fit is made with the least squares method, and the model with
+   the lowest root mean square error, relative to the mean time, is the most
+   likely one.
+*/
+
+struct rxp_complexity_fit {
+    enum rx_complexity complexity;
+    double coefficient;
+    double rms;
+};
+
+static double
+rxp_complexity_evaluate(enum rx_complexity complexity, double n)
+{
+    switch (complexity) {
+        case RX_COMPLEXITY_1:
+            return 1.0;
+        case RX_COMPLEXITY_LOG_N:
+            return n > 1.0 ? log(n) / log(2.0) : 0.0;
+        case RX_COMPLEXITY_N:
+            return n;
+        case RX_COMPLEXITY_N_LOG_N:
+            return n > 1.0 ? n * log(n) / log(2.0) : 0.0;
+        case RX_COMPLEXITY_N_SQUARED:
+            return n * n;
+        default:
+            RX_ASSERT(0);
+            return 0.0;
+    }
+}
+
+static const char *
+rxp_complexity_get_name(enum rx_complexity complexity)
+{
+    switch (complexity) {
+        case RX_COMPLEXITY_1:
+            return "O(1)";
+        case RX_COMPLEXITY_LOG_N:
+            return "O(log n)";
+        case RX_COMPLEXITY_N:
+            return "O(n)";
+        case RX_COMPLEXITY_N_LOG_N:
+            return "O(n log n)";
+        case RX_COMPLEXITY_N_SQUARED:
+            return "O(n^2)";
+        default:
+            return "O(?)";
+    }
+}
+
+static int
+rxp_complexity_fit_compute(struct rxp_complexity_fit *fit,
+                           size_t count,
+                           const rx_uint64 *args,
+                           const double *times)
+{
+    int complexity;
+    size_t i;
+    double mean;
+
+    RX_ASSERT(fit != NULL);
+    RX_ASSERT(args != NULL);
+    RX_ASSERT(times != NULL);
+
+    if (count < 2) {
+        return 0;
+    }
+
+    mean = 0.0;
+    for (i = 0; i < count; ++i) {
+        mean += times[i];
+    }
+
+    mean /= (double)count;
+    if (!(mean > 0.0)) {
+        return 0;
+    }
+
+    fit->complexity = RX_COMPLEXITY_NONE;
+    for (complexity = RX_COMPLEXITY_1; complexity <= RX_COMPLEXITY_N_SQUARED;
+         ++complexity) {
+        double numerator;
+        double denominator;
+        double coefficient;
+        double squared_error;
+        double rms;
+
+        /* Minimize the squared error of `time = coefficient * f(n)`. */
+        numerator = 0.0;
+        denominator = 0.0;
+        for (i = 0; i < count; ++i) {
+            double f;
+
+            f = rxp_complexity_evaluate((enum rx_complexity)complexity,
+                                        (double)args[i]);
+            numerator += times[i] * f;
+            denominator += f * f;
+        }
+
+        if (!(denominator > 0.0)) {
+            continue;
+        }
+
+        coefficient = numerator / denominator;
+
+        squared_error = 0.0;
+        for (i = 0; i < count; ++i) {
+            double error;
+
+            error = times[i]
+                    - coefficient
+                          * rxp_complexity_evaluate(
+                              (enum rx_complexity)complexity,
+                              (double)args[i]);
+            squared_error += error * error;
+        }
+
+        rms = sqrt(squared_error / (double)count) / mean;
+        if (fit->complexity == RX_COMPLEXITY_NONE || rms < fit->rms) {
+            fit->complexity = (enum rx_complexity)complexity;
+            fit->coefficient = coefficient;
+            fit->rms = rms;
+        }
+    }
+
+    return fit->complexity != RX_COMPLEXITY_NONE;
+}
+
+static void
+rxp_complexity_fit_print(const struct rxp_complexity_fit *fit,
+                         const struct rx_benchmark *benchmark,
+                         int exceeded)
+{
+    const char *style_begin;
+    const char *style_end;
+
+    RX_ASSERT(fit != NULL);
+    RX_ASSERT(benchmark != NULL);
+
+#if RXP_LOG_STYLING
+    if (RXP_ISATTY(RXP_FILENO(stderr))) {
+        rxp_log_style_get_ansi_code(&style_begin,
+                                    exceeded ? RXP_LOG_STYLE_BRIGHT_RED
+                                             : RXP_LOG_STYLE_BRIGHT_GREEN);
+        rxp_log_style_get_ansi_code(&style_end, RXP_LOG_STYLE_RESET);
+    } else {
+        style_begin = style_end = "";
+    }
+#else
+    style_begin = style_end = "";
+#endif
+
+    fprintf(stderr,
+            "[%s%s%s] \"%s\" / \"%s\" (%s, coefficient: %f ns, "
+            "RMS: %.2f%%)",
+            style_begin,
+            exceeded ? "FAILED" : "COMPLEXITY",
+            style_end,
+            benchmark->suite_name,
+            benchmark->name,
+            rxp_complexity_get_name(fit->complexity),
+            fit->coefficient,
+            fit->rms * 100.0);
+
+    if (exceeded) {
+        fprintf(stderr,
+                ": the complexity exceeds the bound %s",
+                rxp_complexity_get_name(benchmark->config.complexity_bound));
+    }
+
+    fputc('\n', stderr);
+}
+
+/*
+   Baselines hold the samples of previous benchmark runs, stored in a text file
+   with one line per benchmark made of the test suite name, the benchmark
+   name, and each sample in nanoseconds per iteration, separated by tabs.
+*/
+
+struct rxp_baseline {
+    char *suite_name;
+    char *name;
+    size_t sample_count;
+    double *samples;
+};
+
+struct rxp_baselines {
+    size_t count;
+    size_t capacity;
+    struct rxp_baseline *array;
+};
+
+static void
+rxp_baselines_initialize(struct rxp_baselines *baselines)
+{
+    RX_ASSERT(baselines != NULL);
+
+    memset(baselines, 0, sizeof *baselines);
+}
+
+static void
+rxp_baselines_terminate(struct rxp_baselines *baselines)
+{
+    size_t i;
+
+    RX_ASSERT(baselines != NULL);
+
+    for (i = 0; i < baselines->count; ++i) {
+        RX_FREE(baselines->array[i].suite_name);
+        RX_FREE(baselines->array[i].name);
+        RX_FREE(baselines->array[i].samples);
+    }
+
+    RX_FREE(baselines->array);
+    memset(baselines, 0, sizeof *baselines);
+}
+
+static void
+rxp_baselines_find(const struct rxp_baseline **baseline,
+                   const struct rxp_baselines *baselines,
+                   const struct rx_benchmark_summary *summary)
+{
+    const struct rx_benchmark *benchmark;
+    char suffix[RXP_BENCHMARK_ARG_SUFFIX_SIZE];
+    size_t length;
+    size_t i;
+
+    RX_ASSERT(baseline != NULL);
+    RX_ASSERT(baselines != NULL);
+    RX_ASSERT(summary != NULL);
+    RX_ASSERT(summary->benchmark != NULL);
+
+    benchmark = summary->benchmark;
+    rxp_benchmark_summary_get_arg_suffix(suffix, summary);
+    length = strlen(benchmark->name);
+
+    /* Later lines take precedence over earlier ones. */
+    for (i = baselines->count; i-- > 0;) {
+        const char *name;
+
+        name = baselines->array[i].name;
+        if (strcmp(baselines->array[i].suite_name, benchmark->suite_name) == 0
+            && strncmp(name, benchmark->name, length) == 0
+            && strcmp(name + length, suffix) == 0) {
+            *baseline = &baselines->array[i];
+            return;
+        }
+    }
+
+    *baseline = NULL;
+}
+
+static enum rx_status
+rxp_baselines_parse_line(struct rxp_baselines *baselines, char *line)
+{
+    enum rx_status status;
+    struct rxp_baseline *baseline;
+    char *name;
+    char *it;
+    size_t capacity;
+
+    RX_ASSERT(baselines != NULL);
+    RX_ASSERT(line != NULL);
+
+    name = strchr(line, '\t');
+    if (name == NULL) {
+        return RX_SUCCESS;
+    }
+
+    *name++ = '\0';
+
+    it = strchr(name, '\t');
+    if (it == NULL) {
+        return RX_SUCCESS;
+    }
+
+    *it++ = '\0';
+
+    if (baselines->count == baselines->capacity) {
+        struct rxp_baseline *array;
+
+        capacity = baselines->capacity == 0 ? 16 : baselines->capacity * 2;
+        array = (struct rxp_baseline *)RX_REALLOC(
+            baselines->array, sizeof *array * capacity);
+        if (array == NULL) {
+            RXP_LOG_DEBUG("failed to allocate the baselines\n");
+            return RX_ERROR_ALLOCATION;
+        }
+
+        baselines->array = array;
+        baselines->capacity = capacity;
+    }
+
+    baseline = &baselines->array[baselines->count];
+    memset(baseline, 0, sizeof *baseline);
+
+    status = rxp_str_copy(&baseline->suite_name, line);
+    if (status != RX_SUCCESS) {
+        return status;
+    }
+
+    ++baselines->count;
+
+    status = rxp_str_copy(&baseline->name, name);
+    if (status != RX_SUCCESS) {
+        return status;
+    }
+
+    capacity = 0;
+    while (*it != '\0') {
+        double sample;
+        char *end;
+
+        sample = strtod(it, &end);
+        if (end == it || !(sample >= 0.0)) {
+            break;
+        }
+
+        if (baseline->sample_count == capacity) {
+            double *samples;
+
+            capacity = capacity == 0 ? 16 : capacity * 2;
+            samples = (double *)RX_REALLOC(baseline->samples,
+                                           sizeof *samples * capacity);
+            if (samples == NULL) {
+                RXP_LOG_DEBUG("failed to allocate the baseline samples\n");
+                return RX_ERROR_ALLOCATION;
+            }
+
+            baseline->samples = samples;
+        }
+
+        baseline->samples[baseline->sample_count++] = sample;
+
+        it = end;
+        if (*it == '\t') {
+            ++it;
+        }
+    }
+
+    if (baseline->sample_count == 0) {
+        return RX_SUCCESS;
+    }
+
+    qsort(baseline->samples,
+          baseline->sample_count,
+          sizeof *baseline->samples,
+          rxp_compare_samples);
+    return RX_SUCCESS;
+}
+
+static enum rx_status
+rxp_baselines_load(struct rxp_baselines *baselines, const char *path)
+{
+    enum rx_status status;
+    FILE *file;
+    char *line;
+    size_t capacity;
+
+    RX_ASSERT(baselines != NULL);
+    RX_ASSERT(path != NULL);
+
+    file = fopen(path, "r");
+    if (file == NULL) {
+        RXP_LOG_ERROR_1("could not open the baseline file `%s`\n", path);
+        return RX_ERROR;
+    }
+
+    line = NULL;
+    capacity = 0;
+
+    for (;;) {
+        int found;
+
+        status = rxp_file_read_line(&found, &line, &capacity, file);
+        if (status != RX_SUCCESS || !found) {
+            break;
+        }
+
+        status = rxp_baselines_parse_line(baselines, line);
+        if (status != RX_SUCCESS) {
+            break;
+        }
+    }
+
+    RX_FREE(line);
+    fclose(file);
+
+    if (status != RX_SUCCESS) {
+        RXP_LOG_ERROR_1("failed to load the baselines from `%s`\n", path);
+    }
+
+    return status;
+}
+
+static void
+rxp_baseline_write(FILE *file, const struct rx_benchmark_summary *summary)
+{
+    char suffix[RXP_BENCHMARK_ARG_SUFFIX_SIZE];
+    size_t i;
+
+    RX_ASSERT(file != NULL);
+    RX_ASSERT(summary != NULL);
+
+    if (summary->sample_count == 0) {
+        return;
+    }
+
+    rxp_benchmark_summary_get_arg_suffix(suffix, summary);
+    fprintf(file,
+            "%s\t%s%s",
+            summary->benchmark->suite_name,
+            summary->benchmark->name,
+            suffix);
+    for (i = 0; i < summary->sample_count; ++i) {
+        fprintf(file, "\t%.17g", summary->samples[i]);
+    }
+
+    fputc('\n', file);
+}
+
+/*
+   The samples of a benchmark are compared against its baseline with
+   a Mann-Whitney U test, which doesn't assume the timings to be normally
+   distributed. The change is estimated with the Hodges-Lehmann estimator,
+   that is the median of the differences between all the pairs of samples,
+   along with its distribution-free confidence interval.
+*/
+
+#define RXP_BENCHMARK_SIGNIFICANCE_LEVEL 0.05
+#define RXP_BENCHMARK_CONFIDENCE_Z 1.959964
+#define RXP_BENCHMARK_DEFAULT_THRESHOLD 5.0
+
+struct rxp_benchmark_comparison {
+    double change;
+    double change_lower;
+    double change_upper;
+    double p_value;
+};
+
+struct rxp_ranked_sample {
+    double value;
+    int baseline;
+};
+
+static int
+rxp_compare_ranked_samples(const void *a, const void *b)
+{
+    double aa;
+    double bb;
+
+    aa = ((const struct rxp_ranked_sample *)a)->value;
+    bb = ((const struct rxp_ranked_sample *)b)->value;
+    return (aa > bb) - (aa < bb);
+}
+
+/*
+   Complementary error function, with a fractional error below 1.2e-7.
+   Defined here since `erfc()` isn't part of C89.
+*/
+static double
+rxp_erfc(double x)
+{
+    double z;
+    double t;
+    double out;
+
+    z = fabs(x);
+    t = 1.0 / (1.0 + 0.5 * z);
+    out = 0.17087277;
+    out = -0.82215223 + t * out;
+    out = 1.48851587 + t * out;
+    out = -1.13520398 + t * out;
+    out = 0.27886807 + t * out;
+    out = -0.18628806 + t * out;
+    out = 0.09678418 + t * out;
+    out = 0.37409196 + t * out;
+    out = 1.00002368 + t * out;
+    out = -1.26551223 + t * out;
+    out = t * exp(-z * z + out);
+    return x >= 0.0 ? out : 2.0 - out;
+}
+
+static enum rx_status
+rxp_benchmark_compare(struct rxp_benchmark_comparison *comparison,
+                      size_t sample_count,
+                      const double *samples,
+                      size_t baseline_count,
+                      const double *baseline_samples)
+{
+    struct rxp_ranked_sample *ranked;
+    double *differences;
+    size_t count;
+    size_t i;
+    size_t j;
+    size_t k;
+    double rank_sum;
+    double tie_sum;
+    double u;
+    double mean;
+    double deviation;
+    double z;
+    double median;
+    double n;
+    double m;
+
+    RX_ASSERT(comparison != NULL);
+    RX_ASSERT(sample_count > 0);
+    RX_ASSERT(samples != NULL);
+    RX_ASSERT(baseline_count > 0);
+    RX_ASSERT(baseline_samples != NULL);
+
+    /* Only the baseline samples are expected to be sorted. */
+    n = (double)sample_count;
+    m = (double)baseline_count;
+    count = sample_count + baseline_count;
+
+    ranked = (struct rxp_ranked_sample *)RX_MALLOC(sizeof *ranked * count);
+    if (ranked == NULL) {
+        RXP_LOG_DEBUG("failed to allocate the ranked samples\n");
+        return RX_ERROR_ALLOCATION;
+    }
+
+    for (i = 0; i < sample_count; ++i) {
+        ranked[i].value = samples[i];
+        ranked[i].baseline = 0;
+    }
+
+    for (i = 0; i < baseline_count; ++i) {
+        ranked[sample_count + i].value = baseline_samples[i];
+        ranked[sample_count + i].baseline = 1;
+    }
+
+    qsort(ranked, count, sizeof *ranked, rxp_compare_ranked_samples);
+
+    /* Sum the ranks of the new samples, averaging the ranks of ties. */
+    rank_sum = 0.0;
+    tie_sum = 0.0;
+    for (i = 0; i < count; i = j) {
+        double rank;
+        double tie_count;
+
+        for (j = i + 1; j < count && !(ranked[j].value > ranked[i].value);
+             ++j) {
+            continue;
+        }
+
+        rank = (double)(i + 1 + j) / 2.0;
+        tie_count = (double)(j - i);
+        tie_sum += tie_count * tie_count * tie_count - tie_count;
+        for (k = i; k < j; ++k) {
+            if (!ranked[k].baseline) {
+                rank_sum += rank;
+            }
+        }
+    }
+
+    RX_FREE(ranked);
+
+    u = rank_sum - n * (n + 1.0) / 2.0;
+    mean = n * m / 2.0;
+    deviation = sqrt(n * m / 12.0
+                     * ((n + m + 1.0)
+                        - tie_sum / ((n + m) * (n + m - 1.0))));
+    if (deviation > 0.0) {
+        /* Normal approximation with a continuity correction. */
+        z = (fabs(u - mean) - 0.5) / deviation;
+        comparison->p_value = z > 0.0 ? rxp_erfc(z / sqrt(2.0)) : 1.0;
+    } else {
+        comparison->p_value = 1.0;
+    }
+
+    if (sample_count > (size_t)-1 / sizeof *differences / baseline_count) {
+        RXP_LOG_DEBUG("too many samples to compare\n");
+        return RX_ERROR_MAX_SIZE_EXCEEDED;
+    }
+
+    differences = (double *)RX_MALLOC(sizeof *differences * sample_count
+                                      * baseline_count);
+    if (differences == NULL) {
+        RXP_LOG_DEBUG("failed to allocate the sample differences\n");
+        return RX_ERROR_ALLOCATION;
+    }
+
+    count = 0;
+    for (i = 0; i < sample_count; ++i) {
+        for (j = 0; j < baseline_count; ++j) {
+            differences[count++] = samples[i] - baseline_samples[j];
+        }
+    }
+
+    qsort(differences, count, sizeof *differences, rxp_compare_samples);
+
+    /* The confidence interval bounds are the order statistics of
+       the differences at the critical value of the U statistic. */
+    z = n * m / 2.0
+        - RXP_BENCHMARK_CONFIDENCE_Z * sqrt(n * m * (n + m + 1.0) / 12.0);
+    k = z > 0.0 ? (size_t)z : 0;
+    if (k >= count) {
+        k = count - 1;
+    }
+
+    median = baseline_count % 2 == 1
+                 ? baseline_samples[baseline_count / 2]
+                 : (baseline_samples[baseline_count / 2 - 1]
+                    + baseline_samples[baseline_count / 2])
+                       / 2.0;
+
+    if (median > 0.0) {
+        comparison->change
+            = (count % 2 == 1 ? differences[count / 2]
+                              : (differences[count / 2 - 1]
+                                 + differences[count / 2])
+                                    / 2.0)
+              * 100.0 / median;
+        comparison->change_lower = differences[k] * 100.0 / median;
+        comparison->change_upper
+            = differences[count - 1 - k] * 100.0 / median;
+    } else {
+        comparison->change = 0.0;
+        comparison->change_lower = 0.0;
+        comparison->change_upper = 0.0;
+    }
+
+    RX_FREE(differences);
+    return RX_SUCCESS;
+}
+
+static void
+rxp_benchmark_comparison_print(
+    const struct rxp_benchmark_comparison *comparison,
+    const struct rx_benchmark_summary *summary,
+    int regressed)
+{
+    const char *label;
+    const char *style_begin;
+    const char *style_end;
+    char suffix[RXP_BENCHMARK_ARG_SUFFIX_SIZE];
+    int significant;
+
+    RX_ASSERT(comparison != NULL);
+    RX_ASSERT(summary != NULL);
+
+    rxp_benchmark_summary_get_arg_suffix(suffix, summary);
+
+    significant = comparison->p_value < RXP_BENCHMARK_SIGNIFICANCE_LEVEL;
+    if (regressed) {
+        label = "REGRESSED";
+    } else if (significant && comparison->change < 0.0) {
+        label = "IMPROVED";
+    } else if (significant) {
+        label = "SLOWER";
+    } else {
+        label = "UNCHANGED";
+    }
+
+#if RXP_LOG_STYLING
+    if (RXP_ISATTY(RXP_FILENO(stderr))) {
+        rxp_log_style_get_ansi_code(
+            &style_begin,
+            regressed ? RXP_LOG_STYLE_BRIGHT_RED
+                      : (significant && comparison->change < 0.0
+                             ? RXP_LOG_STYLE_BRIGHT_GREEN
+                             : RXP_LOG_STYLE_BRIGHT_YELLOW));
+        rxp_log_style_get_ansi_code(&style_end, RXP_LOG_STYLE_RESET);
+    } else {
+        style_begin = style_end = "";
+    }
+#else
+    style_begin = style_end = "";
+#endif
+
+    fprintf(stderr,
+            "[%s%s%s] \"%s\" / \"%s%s\" (%+.2f%% [%+.2f%%, %+.2f%%] compared "
+            "to the baseline, p-value: %.4f)\n",
+            style_begin,
+            label,
+            style_end,
+            summary->benchmark->suite_name,
+            summary->benchmark->name,
+            suffix,
+            comparison->change,
+            comparison->change_lower,
+            comparison->change_upper,
+            comparison->p_value);
+}
+
+/*
+   The results can also be written in the JSON format of Google Benchmark, so
+   that the tools built around it, such as its `compare.py` script, can ingest
+   them as is. Each repetition is reported as an iteration run, followed by
+   the mean, median, standard deviation, and coefficient of variation
+   aggregates, and the complexity fit of the benchmarks sweeping over a range
+   of arguments is reported as the `BigO` and `RMS` aggregates.
+*/
+
+#if defined(RXP_PLATFORM_UNIX)
+#include <sys/utsname.h>
+#endif
+#include <time.h>
+
+struct rxp_json_report {
+    FILE *file;
+    char *temporary_path;
+    size_t entry_count;
+};
+
+static void
+rxp_json_write_chars(FILE *file, const char *s)
+{
+    RX_ASSERT(file != NULL);
+    RX_ASSERT(s != NULL);
+
+    for (; *s != '\0'; ++s) {
+        unsigned char c;
+
+        c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            fputc('\\', file);
+            fputc(c, file);
+        } else if (c < 0x20) {
+            fprintf(file, "\\u%04x", (unsigned int)c);
+        } else {
+            fputc(c, file);
+        }
+    }
+}
+
+static void
+rxp_json_write_str(FILE *file, const char *s)
+{
+    fputc('"', file);
+    rxp_json_write_chars(file, s);
+    fputc('"', file);
+}
+
+/* Benchmarks are named `suite/name`, followed by their argument if any. */
+static void
+rxp_json_write_name(FILE *file,
+                    const struct rx_benchmark *benchmark,
+                    const char *arg_suffix,
+                    const char *aggregate_name)
+{
+    RX_ASSERT(file != NULL);
+    RX_ASSERT(benchmark != NULL);
+    RX_ASSERT(arg_suffix != NULL);
+
+    fputc('"', file);
+    rxp_json_write_chars(file, benchmark->suite_name);
+    fputc('/', file);
+    rxp_json_write_chars(file, benchmark->name);
+    rxp_json_write_chars(file, arg_suffix);
+    if (aggregate_name != NULL) {
+        fputc('_', file);
+        rxp_json_write_chars(file, aggregate_name);
+    }
+
+    fputc('"', file);
+}
+
+#if defined(RXP_PLATFORM_LINUX)
+/* Count the CPUs of a list such as `0-3,8-11`. */
+static unsigned long
+rxp_cpu_list_count(const char *list)
+{
+    unsigned long count;
+
+    RX_ASSERT(list != NULL);
+
+    count = 0;
+    while (*list != '\0') {
+        char *end;
+        unsigned long first;
+        unsigned long last;
+
+        first = strtoul(list, &end, 10);
+        if (end == list) {
+            break;
+        }
+
+        last = first;
+        if (*end == '-') {
+            list = end + 1;
+            last = strtoul(list, &end, 10);
+            if (end == list || last < first) {
+                break;
+            }
+        }
+
+        count += last - first + 1;
+        list = *end == ',' ? end + 1 : end;
+    }
+
+    return count;
+}
+
+static void
+rxp_json_write_caches(FILE *file)
+{
+    size_t i;
+    int first;
+
+    RX_ASSERT(file != NULL);
+
+    fputs("    \"caches\": [", file);
+
+    first = 1;
+    for (i = 0;; ++i) {
+        char path[64];
+        char type[32];
+        char level[16];
+        char size[32];
+        char shared[256];
+        char *end;
+        unsigned long bytes;
+
+        sprintf(path, "/sys/devices/system/cpu/cpu0/cache/index%lu/type",
+                (unsigned long)i);
+        if (!rxp_sysfs_read(type, sizeof type, path)) {
+            break;
+        }
+
+        sprintf(path, "/sys/devices/system/cpu/cpu0/cache/index%lu/level",
+                (unsigned long)i);
+        if (!rxp_sysfs_read(level, sizeof level, path)) {
+            continue;
+        }
+
+        sprintf(path, "/sys/devices/system/cpu/cpu0/cache/index%lu/size",
+                (unsigned long)i);
+        if (!rxp_sysfs_read(size, sizeof size, path)) {
+            continue;
+        }
+
+        bytes = strtoul(size, &end, 10);
+        if (*end == 'K') {
+            bytes *= 1024ul;
+        } else if (*end == 'M') {
+            bytes *= 1024ul * 1024ul;
+        } else if (*end == 'G') {
+            bytes *= 1024ul * 1024ul * 1024ul;
+        }
+
+        sprintf(path,
+                "/sys/devices/system/cpu/cpu0/cache/index%lu/shared_cpu_list",
+                (unsigned long)i);
+        if (!rxp_sysfs_read(shared, sizeof shared, path)) {
+            strcpy(shared, "0");
+        }
+
+        fputs(first ? "\n" : ",\n", file);
+        first = 0;
+
+        fputs("      {\n        \"type\": ", file);
+        rxp_json_write_str(file, type);
+        fprintf(file,
+                ",\n        \"level\": %lu,\n        \"size\": %lu,\n"
+                "        \"num_sharing\": %lu\n      }",
+                strtoul(level, NULL, 10),
+                bytes,
+                rxp_cpu_list_count(shared));
+    }
+
+    fputs(first ? "],\n" : "\n    ],\n", file);
+}
+#endif
+
+static void
+rxp_json_write_context(FILE *file, const struct rxp_timer *timer)
+{
+    time_t now;
+    struct tm *utc;
+    char date[32];
+    size_t cpu_count;
+    double mhz;
+    int scaling;
+    double loads[3];
+    int load_count;
+
+    RX_ASSERT(file != NULL);
+    RX_ASSERT(timer != NULL);
+
+    fputs("{\n  \"context\": {\n", file);
+
+    /* The date is expressed in UTC since the `%z` format is C99 only. */
+    now = time(NULL);
+    utc = gmtime(&now);
+    if (utc != NULL
+        && strftime(date, sizeof date, "%Y-%m-%dT%H:%M:%SZ", utc) > 0) {
+        fputs("    \"date\": ", file);
+        rxp_json_write_str(file, date);
+        fputs(",\n", file);
+    }
+
+#if defined(RXP_PLATFORM_UNIX)
+    {
+        struct utsname name;
+
+        if (uname(&name) == 0) {
+            fputs("    \"host_name\": ", file);
+            rxp_json_write_str(file, name.nodename);
+            fputs(",\n", file);
+        }
+    }
+#endif
+
+    rxp_get_cpu_count(&cpu_count);
+
+    mhz = 0.0;
+    scaling = 0;
+    if (timer->tsc) {
+        mhz = 1000.0 / timer->ns_per_tick;
+    }
+
+#if defined(RXP_PLATFORM_LINUX)
+    {
+        char value[32];
+
+        if (!timer->tsc
+            && rxp_sysfs_read(
+                value,
+                sizeof value,
+                "/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_max_freq")) {
+            mhz = strtod(value, NULL) / 1000.0;
+        }
+
+        scaling = rxp_sysfs_read(
+                      value,
+                      sizeof value,
+                      "/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor")
+                  && strcmp(value, "performance") != 0;
+    }
+#endif
+
+    fprintf(file,
+            "    \"num_cpus\": %lu,\n"
+            "    \"mhz_per_cpu\": %.0f,\n"
+            "    \"cpu_scaling_enabled\": %s,\n",
+            (unsigned long)cpu_count,
+            mhz,
+            scaling ? "true" : "false");
+
+#if defined(RXP_PLATFORM_LINUX)
+    rxp_json_write_caches(file);
+#else
+    fputs("    \"caches\": [],\n", file);
+#endif
+
+    load_count = 0;
+#if defined(RXP_PLATFORM_LINUX)
+    {
+        char value[128];
+
+        if (rxp_sysfs_read(value, sizeof value, "/proc/loadavg")
+            && sscanf(value, "%lf %lf %lf", &loads[0], &loads[1], &loads[2])
+                   == 3) {
+            load_count = 3;
+        }
+    }
+#endif
+
+    if (load_count == 3) {
+        fprintf(file,
+                "    \"load_avg\": [%g, %g, %g],\n",
+                loads[0],
+                loads[1],
+                loads[2]);
+    } else {
+        fputs("    \"load_avg\": [],\n", file);
+    }
+
+    fprintf(file,
+            "    \"library_build_type\": \"%s\",\n"
+            "    \"json_schema_version\": 1\n"
+            "  },\n"
+            "  \"benchmarks\": [",
+            RXP_DEBUGGING ? "debug" : "release");
+}
+
+static void
+rxp_json_begin_entry(struct rxp_json_report *report)
+{
+    RX_ASSERT(report != NULL);
+
+    fputs(report->entry_count > 0 ? ",\n    {\n" : "\n    {\n", report->file);
+    ++report->entry_count;
+}
+
+static void
+rxp_json_write_run_header(struct rxp_json_report *report,
+                          const struct rx_benchmark_summary *summary,
+                          size_t family_index,
+                          size_t instance_index,
+                          const char *aggregate_name)
+{
+    char suffix[RXP_BENCHMARK_ARG_SUFFIX_SIZE];
+
+    RX_ASSERT(report != NULL);
+    RX_ASSERT(summary != NULL);
+
+    rxp_benchmark_summary_get_arg_suffix(suffix, summary);
+
+    fputs("      \"name\": ", report->file);
+    rxp_json_write_name(
+        report->file, summary->benchmark, suffix, aggregate_name);
+    fprintf(report->file,
+            ",\n      \"family_index\": %lu,\n"
+            "      \"per_family_instance_index\": %lu,\n"
+            "      \"run_name\": ",
+            (unsigned long)family_index,
+            (unsigned long)instance_index);
+    rxp_json_write_name(report->file, summary->benchmark, suffix, NULL);
+    fprintf(report->file,
+            ",\n      \"run_type\": \"%s\",\n"
+            "      \"repetitions\": %lu,\n"
+            "      \"threads\": 1,\n",
+            aggregate_name != NULL ? "aggregate" : "iteration",
+            (unsigned long)summary->sample_count);
+}
+
+/*
+   The throughputs and the custom metrics, set for each iteration, are only
+   reported for the runs expressing a time per iteration.
+*/
+static void
+rxp_json_write_times(struct rxp_json_report *report,
+                     const struct rx_benchmark_summary *summary,
+                     rx_uint64 iteration_count,
+                     double real_time,
+                     double cpu_time,
+                     int metrics)
+{
+    size_t i;
+
+    RX_ASSERT(report != NULL);
+    RX_ASSERT(summary != NULL);
+
+    fprintf(report->file,
+            "      \"iterations\": %lu,\n"
+            "      \"real_time\": %.17g,\n"
+            "      \"cpu_time\": %.17g,\n"
+            "      \"time_unit\": \"ns\"",
+            (unsigned long)iteration_count,
+            real_time,
+            cpu_time);
+
+    if (metrics && real_time > 0.0) {
+        if (summary->metrics.bytes_processed > 0) {
+            fprintf(report->file,
+                    ",\n      \"bytes_per_second\": %.17g",
+                    (double)summary->metrics.bytes_processed * 1e9
+                        / real_time);
+        }
+
+        if (summary->metrics.items_processed > 0) {
+            fprintf(report->file,
+                    ",\n      \"items_per_second\": %.17g",
+                    (double)summary->metrics.items_processed * 1e9
+                        / real_time);
+        }
+    }
+
+    for (i = 0; metrics && i < summary->metrics.count; ++i) {
+        fputs(",\n      ", report->file);
+        rxp_json_write_str(report->file, summary->metrics.values[i].name);
+        fprintf(report->file, ": %.17g", summary->metrics.values[i].value);
+    }
+
+    fputs("\n    }", report->file);
+}
+
+/*
+   The CPU time falls back to the wall-clock time when it couldn't be
+   measured, since the format requires it.
+*/
+static void
+rxp_json_write_summary(struct rxp_json_report *report,
+                       const struct rx_benchmark_summary *summary,
+                       size_t family_index,
+                       size_t instance_index)
+{
+    const double *cpu_samples;
+    double cpu_median;
+    double cpu_mean;
+    double cpu_stddev;
+    size_t i;
+
+    RX_ASSERT(report != NULL);
+    RX_ASSERT(summary != NULL);
+
+    if (summary->skipped) {
+        return;
+    }
+
+    if (summary->error != NULL) {
+        rxp_json_begin_entry(report);
+        rxp_json_write_run_header(
+            report, summary, family_index, instance_index, NULL);
+        fputs("      \"error_occurred\": true,\n"
+              "      \"error_message\": ",
+              report->file);
+        rxp_json_write_str(report->file, summary->error);
+        fputs(",\n", report->file);
+        rxp_json_write_times(report, summary, 0, 0.0, 0.0, 0);
+        return;
+    }
+
+    if (summary->cpu_samples != NULL) {
+        cpu_samples = summary->cpu_samples;
+        cpu_median = summary->cpu_median;
+        cpu_mean = summary->cpu_mean;
+        cpu_stddev = summary->cpu_stddev;
+    } else {
+        cpu_samples = summary->samples;
+        cpu_median = summary->median;
+        cpu_mean = summary->mean;
+        cpu_stddev = summary->stddev;
+    }
+
+    for (i = 0; i < summary->sample_count; ++i) {
+        rxp_json_begin_entry(report);
+        rxp_json_write_run_header(
+            report, summary, family_index, instance_index, NULL);
+        fprintf(report->file,
+                "      \"repetition_index\": %lu,\n",
+                (unsigned long)i);
+        rxp_json_write_times(report,
+                             summary,
+                             summary->iteration_count,
+                             summary->samples[i],
+                             cpu_samples[i],
+                             1);
+    }
+
+    if (summary->sample_count < 2) {
+        return;
+    }
+
+    rxp_json_begin_entry(report);
+    rxp_json_write_run_header(
+        report, summary, family_index, instance_index, "mean");
+    fputs("      \"aggregate_name\": \"mean\",\n"
+          "      \"aggregate_unit\": \"time\",\n",
+          report->file);
+    rxp_json_write_times(
+        report, summary, summary->sample_count, summary->mean, cpu_mean, 1);
+
+    rxp_json_begin_entry(report);
+    rxp_json_write_run_header(
+        report, summary, family_index, instance_index, "median");
+    fputs("      \"aggregate_name\": \"median\",\n"
+          "      \"aggregate_unit\": \"time\",\n",
+          report->file);
+    rxp_json_write_times(report,
+                         summary,
+                         summary->sample_count,
+                         summary->median,
+                         cpu_median,
+                         1);
+
+    rxp_json_begin_entry(report);
+    rxp_json_write_run_header(
+        report, summary, family_index, instance_index, "stddev");
+    fputs("      \"aggregate_name\": \"stddev\",\n"
+          "      \"aggregate_unit\": \"time\",\n",
+          report->file);
+    rxp_json_write_times(report,
+                         summary,
+                         summary->sample_count,
+                         summary->stddev,
+                         cpu_stddev,
+                         0);
+
+    rxp_json_begin_entry(report);
+    rxp_json_write_run_header(
+        report, summary, family_index, instance_index, "cv");
+    fputs("      \"aggregate_name\": \"cv\",\n"
+          "      \"aggregate_unit\": \"percentage\",\n",
+          report->file);
+    rxp_json_write_times(
+        report,
+        summary,
+        summary->sample_count,
+        summary->mean > 0.0 ? summary->stddev / summary->mean : 0.0,
+        cpu_mean > 0.0 ? cpu_stddev / cpu_mean : 0.0,
+        0);
+}
+
+static const char *
+rxp_json_get_big_o(enum rx_complexity complexity)
+{
+    switch (complexity) {
+        case RX_COMPLEXITY_1:
+            return "(1)";
+        case RX_COMPLEXITY_LOG_N:
+            return "lgN";
+        case RX_COMPLEXITY_N:
+            return "N";
+        case RX_COMPLEXITY_N_LOG_N:
+            return "NlgN";
+        case RX_COMPLEXITY_N_SQUARED:
+            return "N^2";
+        default:
+            return "f(N)";
+    }
+}
+
+/* The complexity is fitted against the median wall-clock times only. */
+static void
+rxp_json_write_complexity(struct rxp_json_report *report,
+                          const struct rx_benchmark *benchmark,
+                          size_t family_index,
+                          size_t arg_count,
+                          const struct rxp_complexity_fit *fit)
+{
+    RX_ASSERT(report != NULL);
+    RX_ASSERT(benchmark != NULL);
+    RX_ASSERT(fit != NULL);
+
+    rxp_json_begin_entry(report);
+    fputs("      \"name\": ", report->file);
+    rxp_json_write_name(report->file, benchmark, "", "BigO");
+    fprintf(report->file,
+            ",\n      \"family_index\": %lu,\n"
+            "      \"per_family_instance_index\": 0,\n"
+            "      \"run_name\": ",
+            (unsigned long)family_index);
+    rxp_json_write_name(report->file, benchmark, "", NULL);
+    fprintf(report->file,
+            ",\n      \"run_type\": \"aggregate\",\n"
+            "      \"repetitions\": %lu,\n"
+            "      \"threads\": 1,\n"
+            "      \"aggregate_name\": \"BigO\",\n"
+            "      \"aggregate_unit\": \"time\",\n"
+            "      \"cpu_coefficient\": %.17g,\n"
+            "      \"real_coefficient\": %.17g,\n"
+            "      \"big_o\": \"%s\",\n"
+            "      \"time_unit\": \"ns\"\n    }",
+            (unsigned long)arg_count,
+            fit->coefficient,
+            fit->coefficient,
+            rxp_json_get_big_o(fit->complexity));
+
+    rxp_json_begin_entry(report);
+    fputs("      \"name\": ", report->file);
+    rxp_json_write_name(report->file, benchmark, "", "RMS");
+    fprintf(report->file,
+            ",\n      \"family_index\": %lu,\n"
+            "      \"per_family_instance_index\": 0,\n"
+            "      \"run_name\": ",
+            (unsigned long)family_index);
+    rxp_json_write_name(report->file, benchmark, "", NULL);
+    fprintf(report->file,
+            ",\n      \"run_type\": \"aggregate\",\n"
+            "      \"repetitions\": %lu,\n"
+            "      \"threads\": 1,\n"
+            "      \"aggregate_name\": \"RMS\",\n"
+            "      \"aggregate_unit\": \"percentage\",\n"
+            "      \"rms\": %.17g\n    }",
+            (unsigned long)arg_count,
+            fit->rms);
+}
+
+static enum rx_status
+rxp_json_report_open(struct rxp_json_report *report,
+                     const char *path,
+                     const struct rxp_timer *timer)
+{
+    enum rx_status status;
+
+    RX_ASSERT(report != NULL);
+    RX_ASSERT(path != NULL);
+
+    report->entry_count = 0;
+    status = rxp_file_open_temporary(
+        &report->file, &report->temporary_path, path);
+    if (status != RX_SUCCESS) {
+        report->file = NULL;
+        return status;
+    }
+
+    rxp_json_write_context(report->file, timer);
+    return RX_SUCCESS;
+}
+
+static enum rx_status
+rxp_json_report_close(struct rxp_json_report *report,
+                      const char *path,
+                      int commit)
+{
+    FILE *file;
+
+    RX_ASSERT(report != NULL);
+    RX_ASSERT(report->file != NULL);
+    RX_ASSERT(path != NULL);
+
+    if (!commit) {
+        fclose(report->file);
+        remove(report->temporary_path);
+        RX_FREE(report->temporary_path);
+        report->file = NULL;
+        return RX_SUCCESS;
+    }
+
+    file = report->file;
+    report->file = NULL;
+    fputs(report->entry_count > 0 ? "\n  ]\n}\n" : "]\n}\n", file);
+    return rxp_file_commit_temporary(file, report->temporary_path, path);
+}
+
+static enum rx_status
+rxp_run_benchmarks(const struct rx_run_config *config,
+                   size_t benchmark_count,
+                   const struct rx_benchmark *benchmarks)
+{
+    enum rx_status status;
+    size_t i;
+    int failed;
+    size_t regressed_count;
+    double threshold;
+    struct rxp_baselines baselines;
+    FILE *save_file;
+    char *save_temporary_path;
+    struct rxp_timer timer;
+    struct rxp_cpu_affinity affinity;
+    size_t unstable_count;
+    struct rxp_json_report json_report;
+
+    RX_ASSERT(config != NULL);
+
+    if (benchmark_count == 0) {
+        RXP_LOG_INFO("no benchmark to run\n");
+        return RX_SUCCESS;
+    }
+
+    RX_ASSERT(benchmarks != NULL);
+
+    /* Pin the thread before calibrating the timer, which the time-stamp
+       counter of another CPU could otherwise skew. */
+    affinity.pinned = 0;
+    if (config->bench_stable) {
+        if (rxp_cpu_pin(&affinity) != RX_SUCCESS) {
+            RXP_LOG_WARNING("failed to pin the benchmarks to a CPU\n");
+        }
+
+        rxp_cpu_check_frequency_scaling(&affinity);
+    }
+
+    status = rxp_timer_initialize(&timer);
+    if (status != RX_SUCCESS) {
+        RXP_LOG_ERROR("failed to initialize the benchmark timer\n");
+        rxp_cpu_unpin(&affinity);
+        return status;
+    }
+
+    rxp_timer_print(&timer);
+
+    rxp_baselines_initialize(&baselines);
+    save_file = NULL;
+    save_temporary_path = NULL;
+    json_report.file = NULL;
+
+    if (config->bench_compare_path != NULL) {
+        status = rxp_baselines_load(&baselines, config->bench_compare_path);
+        if (status != RX_SUCCESS) {
+            goto baselines_cleanup;
+        }
+    }
+
+    if (config->bench_save_path != NULL) {
+        status = rxp_file_open_temporary(
+            &save_file, &save_temporary_path, config->bench_save_path);
+        if (status != RX_SUCCESS) {
+            goto baselines_cleanup;
+        }
+    }
+
+    if (config->bench_json_path != NULL) {
+        status = rxp_json_report_open(
+            &json_report, config->bench_json_path, &timer);
+        if (status != RX_SUCCESS) {
+            if (save_file != NULL) {
+                fclose(save_file);
+                remove(save_temporary_path);
+                RX_FREE(save_temporary_path);
+            }
+
+            goto baselines_cleanup;
+        }
+    }
+
+    threshold = config->bench_threshold > 0.0 ? config->bench_threshold
+                                              : RXP_BENCHMARK_DEFAULT_THRESHOLD;
+
+    status = RX_SUCCESS;
+    failed = 0;
+    regressed_count = 0;
+    unstable_count = 0;
+    for (i = 0; i < benchmark_count; ++i) {
+        const struct rx_benchmark *benchmark;
+        struct rxp_benchmark_settings settings;
+        size_t arg_count;
+        rx_uint64 *args;
+        double *medians;
+        size_t fit_count;
+        size_t j;
+
+        benchmark = &benchmarks[i];
+
+        /* The benchmark's own settings take precedence over the run's. */
+        settings.min_time = benchmark->config.min_time;
+        if (!(settings.min_time > 0.0)) {
+            settings.min_time = config->bench_min_time > 0.0
+                                    ? config->bench_min_time
+                                    : RXP_BENCHMARK_DEFAULT_MIN_TIME;
+        }
+
+        settings.repetition_count = (size_t)benchmark->config.repetition_count;
+        if (settings.repetition_count == 0) {
+            settings.repetition_count
+                = config->bench_repetition_count > 0
+                      ? (size_t)config->bench_repetition_count
+                      : RXP_BENCHMARK_DEFAULT_REPETITION_COUNT;
+        }
+
+        settings.warm_up_count = (size_t)config->bench_warm_up_count;
+        settings.max_cv = 0.0;
+        settings.max_repetition_count = 0;
+        if (config->bench_stable) {
+            settings.max_cv = config->bench_max_cv > 0.0
+                                  ? config->bench_max_cv
+                                  : RXP_BENCHMARK_DEFAULT_MAX_CV;
+            settings.max_repetition_count
+                = config->bench_max_repetition_count > 0
+                      ? (size_t)config->bench_max_repetition_count
+                      : RXP_BENCHMARK_DEFAULT_MAX_REPETITION_COUNT;
+        }
+
+        status = rxp_benchmark_get_args(&arg_count, &args, &benchmark->config);
+        if (status != RX_SUCCESS) {
+            break;
+        }
+
+        medians = (double *)RX_MALLOC(sizeof *medians * arg_count);
+        if (medians == NULL) {
+            RXP_LOG_DEBUG("failed to allocate the benchmark medians\n");
+            RX_FREE(args);
+            status = RX_ERROR_ALLOCATION;
+            break;
+        }
+
+        fit_count = 0;
+        for (j = 0; j < arg_count; ++j) {
+            struct rx_benchmark_summary summary;
+
+            status = rx_benchmark_summary_initialize(&summary, benchmark);
+            if (status != RX_SUCCESS) {
+                break;
+            }
+
+            summary.arg = args[j];
+
+            status = rxp_benchmark_run(&summary, &timer, benchmark, &settings);
+            if (status == RX_SUCCESS) {
+                rx_benchmark_summary_print(&summary);
+            }
+
+            if (status == RX_SUCCESS && config->bench_compare_path != NULL
+                && summary.sample_count > 0) {
+                const struct rxp_baseline *baseline;
+
+                rxp_baselines_find(&baseline, &baselines, &summary);
+                if (baseline == NULL || baseline->sample_count == 0) {
+                    char suffix[RXP_BENCHMARK_ARG_SUFFIX_SIZE];
+
+                    rxp_benchmark_summary_get_arg_suffix(suffix, &summary);
+                    RXP_LOG_INFO_3("no baseline to compare against "
+                                   "(suite: \"%s\", case: \"%s%s\")\n",
+                                   benchmark->suite_name,
+                                   benchmark->name,
+                                   suffix);
+                } else {
+                    struct rxp_benchmark_comparison comparison;
+
+                    status = rxp_benchmark_compare(
+                        &comparison,
+                        (size_t)summary.sample_count,
+                        summary.samples,
+                        baseline->sample_count,
+                        baseline->samples);
+                    if (status == RX_SUCCESS) {
+                        int regressed;
+
+                        regressed = comparison.p_value
+                                        < RXP_BENCHMARK_SIGNIFICANCE_LEVEL
+                                    && comparison.change > threshold;
+                        regressed_count += (size_t)regressed;
+                        rxp_benchmark_comparison_print(
+                            &comparison, &summary, regressed);
+                    }
+                }
+            }
+
+            if (status == RX_SUCCESS && save_file != NULL) {
+                rxp_baseline_write(save_file, &summary);
+            }
+
+            if (status == RX_SUCCESS && json_report.file != NULL) {
+                rxp_json_write_summary(&json_report, &summary, i, j);
+            }
+
+            /* Only the arguments that ran successfully are fitted, since
+               the others have no meaningful median. */
+            if (summary.error == NULL && summary.sample_count > 0) {
+                args[fit_count] = args[j];
+                medians[fit_count] = summary.median;
+                ++fit_count;
+            }
+
+            failed |= summary.error != NULL;
+            unstable_count += (size_t)summary.unstable;
+            rx_benchmark_summary_terminate(&summary);
+
+            if (status != RX_SUCCESS || summary.skipped
+                || (failed && config->fail_fast)) {
+                break;
+            }
+        }
+
+        /* Only fit the complexity once all the arguments were run. */
+        if (status == RX_SUCCESS && j == arg_count
+            && benchmark->config.range_max > 0) {
+            struct rxp_complexity_fit fit;
+
+            if (rxp_complexity_fit_compute(&fit, fit_count, args, medians)) {
+                int exceeded;
+
+                exceeded = benchmark->config.complexity_bound
+                               != RX_COMPLEXITY_NONE
+                           && fit.complexity
+                                  > benchmark->config.complexity_bound;
+                failed |= exceeded;
+                rxp_complexity_fit_print(&fit, benchmark, exceeded);
+
+                if (json_report.file != NULL) {
+                    rxp_json_write_complexity(
+                        &json_report, benchmark, i, fit_count, &fit);
+                }
+            } else {
+                RXP_LOG_INFO_2("not enough measures to fit the complexity "
+                               "(suite: \"%s\", case: \"%s\")\n",
+                               benchmark->suite_name,
+                               benchmark->name);
+            }
+        }
+
+        RX_FREE(medians);
+        RX_FREE(args);
+
+        if (status != RX_SUCCESS) {
+            RXP_LOG_ERROR_2("failed to run a benchmark "
+                            "(suite: \"%s\", case: \"%s\")\n",
+                            benchmark->suite_name,
+                            benchmark->name);
+            break;
+        }
+
+        if (failed && config->fail_fast) {
+            RXP_LOG_INFO("stopping the run after the first failure\n");
+            break;
+        }
+    }
+
+    if (save_file != NULL) {
+        if (status == RX_SUCCESS) {
+            status = rxp_file_commit_temporary(
+                save_file, save_temporary_path, config->bench_save_path);
+        } else {
+            fclose(save_file);
+            remove(save_temporary_path);
+            RX_FREE(save_temporary_path);
+        }
+    }
+
+    if (json_report.file != NULL) {
+        if (status == RX_SUCCESS) {
+            status = rxp_json_report_close(
+                &json_report, config->bench_json_path, 1);
+        } else {
+            rxp_json_report_close(&json_report, config->bench_json_path, 0);
+        }
+    }
+
+    if (status == RX_SUCCESS && unstable_count > 0) {
+        RXP_LOG_WARNING_1("%lu benchmarks remained unstable\n",
+                          (unsigned long)unstable_count);
+    }
+
+    if (status == RX_SUCCESS && regressed_count > 0) {
+        RXP_LOG_ERROR_2("%lu benchmarks regressed by more than %g%%\n",
+                        (unsigned long)regressed_count,
+                        threshold);
+        failed = 1;
+    }
+
+    if (status == RX_SUCCESS && failed) {
+        status = RX_ERROR_ABORTED;
+    }
+
+baselines_cleanup:
+    rxp_baselines_terminate(&baselines);
+    rxp_cpu_unpin(&affinity);
+    return status;
+}
+
+/* Implementation: Test Assessments                                O-(''Q)
+   -------------------------------------------------------------------------- */
+
+RXP_PRINTF_CHECK(8, 0)
+RXP_MAYBE_UNUSED static void
+rxp_assess_value(struct rx_context *context,
+                 int x,
+                 int expected,
+                 const char *expr,
+                 const char *file,
+                 int line,
+                 enum rx_severity severity,
+                 const char *failure_fmt,
+                 ...)
+{
+    int result;
+    char *failure_msg;
+    char *diagnostic_msg;
+
+    RX_ASSERT(context != NULL);
+    RX_ASSERT(file != NULL);
+
+    result = ((x && expected) || (!x && !expected));
+
+    if (result) {
+        failure_msg = NULL;
+        diagnostic_msg = NULL;
+    } else {
+        enum rx_status status;
+
+        if (failure_fmt == NULL) {
+            RXP_STR_CREATE_1(status,
+                             failure_msg,
+                             "`%s` is expected to evaluate to true",
+                             expr);
+        } else {
+            RXP_STR_CREATE_VA_LIST(status, failure_msg, failure_fmt);
+        }
+
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the failure message for "
+                            "the test located at %s:%d\n",
+                            file,
+                            line);
+            failure_msg = NULL;
+        }
+
+        RXP_STR_CREATE_1(status, diagnostic_msg, "%d", x);
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the diagnostic message for "
+                            "the test located at %s:%d\n",
+                            file,
+                            line);
+            diagnostic_msg = NULL;
+        }
+    }
+
+    if (rx_handle_test_result(
+            context, result, file, line, severity, failure_msg, diagnostic_msg)
+        != RX_SUCCESS) {
+        RXP_LOG_DEBUG_2("failed to handle the test result for the test "
+                        "located at %s:%d\n",
+                        file,
+                        line);
+    }
+
+    RX_FREE(failure_msg);
+    RX_FREE(diagnostic_msg);
+
+    if (!result && severity == RX_FATAL) {
+        rx_abort(context);
+    }
+}
+
+RXP_PRINTF_CHECK(8, 0)
+RXP_MAYBE_UNUSED static void
+rxp_bool_assess_value(struct rx_context *context,
+                      int x,
+                      int expected,
+                      const char *expr,
+                      const char *file,
+                      int line,
+                      enum rx_severity severity,
+                      const char *failure_fmt,
+                      ...)
+{
+    int result;
+    char *failure_msg;
+    char *diagnostic_msg;
+
+    RX_ASSERT(context != NULL);
+    RX_ASSERT(expr != NULL);
+    RX_ASSERT(file != NULL);
+
+    result = ((x && expected) || (!x && !expected));
+
+    if (result) {
+        failure_msg = NULL;
+        diagnostic_msg = NULL;
+    } else {
+        enum rx_status status;
+
+        if (failure_fmt == NULL) {
+            RXP_STR_CREATE_2(status,
+                             failure_msg,
+                             "`%s` is expected to be %s",
+                             expr,
+                             expected ? "true" : "false");
+        } else {
+            RXP_STR_CREATE_VA_LIST(status, failure_msg, failure_fmt);
+        }
+
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the failure message for "
+                            "the boolean test located at %s:%d\n",
+                            file,
+                            line);
+            failure_msg = NULL;
+        }
+
+        RXP_STR_CREATE_2(status, diagnostic_msg, "%d == %d", x, expected);
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the diagnostic message for "
+                            "the boolean test located at %s:%d\n",
+                            file,
+                            line);
+            diagnostic_msg = NULL;
+        }
+    }
+
+    if (rx_handle_test_result(
+            context, result, file, line, severity, failure_msg, diagnostic_msg)
+        != RX_SUCCESS) {
+        RXP_LOG_DEBUG_2("failed to handle the test result for the boolean test "
+                        "located at %s:%d\n",
+                        file,
+                        line);
+    }
+
+    RX_FREE(failure_msg);
+    RX_FREE(diagnostic_msg);
+
+    if (!result && severity == RX_FATAL) {
+        rx_abort(context);
+    }
+}
+
+RXP_PRINTF_CHECK(10, 0)
+RXP_MAYBE_UNUSED static void
+rxp_int_assess_comparison(struct rx_context *context,
+                          rxp_int x1,
+                          rxp_int x2,
+                          enum rxp_op op,
+                          const char *expr1,
+                          const char *expr2,
+                          const char *file,
+                          int line,
+                          enum rx_severity severity,
+                          const char *failure_fmt,
+                          ...)
+{
+    int result;
+    char *failure_msg;
+    char *diagnostic_msg;
+
+    RX_ASSERT(context != NULL);
+    RX_ASSERT(expr1 != NULL);
+    RX_ASSERT(expr2 != NULL);
+    RX_ASSERT(file != NULL);
+
+    switch (op) {
+        case RXP_OP_EQUAL:
+            result = x1 == x2;
+            break;
+        case RXP_OP_NOT_EQUAL:
+            result = x1 != x2;
+            break;
+        case RXP_OP_GREATER:
+            result = x1 > x2;
+            break;
+        case RXP_OP_LESSER:
+            result = x1 < x2;
+            break;
+        case RXP_OP_GREATER_OR_EQUAL:
+            result = x1 >= x2;
+            break;
+        case RXP_OP_LESSER_OR_EQUAL:
+            result = x1 <= x2;
+            break;
+        default:
+            RX_ASSERT(0);
+            result = 0;
+            break;
+    }
+
+    if (result) {
+        failure_msg = NULL;
+        diagnostic_msg = NULL;
+    } else {
+        enum rx_status status;
+        const char *op_symbol;
+
+        if (failure_fmt == NULL) {
+            const char *op_name;
+
+            rxp_op_get_name(&op_name, op);
+            RXP_STR_CREATE_3(status,
+                             failure_msg,
+                             "`%s` is expected to be %s `%s`",
+                             expr1,
+                             op_name,
+                             expr2);
+        } else {
+            RXP_STR_CREATE_VA_LIST(status, failure_msg, failure_fmt);
+        }
+
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the failure message for "
+                            "the integer comparison test located at %s:%d\n",
+                            file,
+                            line);
+            failure_msg = NULL;
+        }
+
+        rxp_op_get_symbol(&op_symbol, op);
+        RXP_STR_CREATE_3(status,
+                         diagnostic_msg,
+                         "%ld %s %ld",
+                         (long)x1,
+                         op_symbol,
+                         (long)x2);
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the diagnostic message for "
+                            "the integer comparison test located at %s:%d\n",
+                            file,
+                            line);
+            diagnostic_msg = NULL;
+        }
+    }
+
+    if (rx_handle_test_result(
+            context, result, file, line, severity, failure_msg, diagnostic_msg)
+        != RX_SUCCESS) {
+        RXP_LOG_DEBUG_2("failed to handle the test result for the integer "
+                        "comparison test located at %s:%d\n",
+                        file,
+                        line);
+    }
+
+    RX_FREE(failure_msg);
+    RX_FREE(diagnostic_msg);
+
+    if (!result && severity == RX_FATAL) {
+        rx_abort(context);
+    }
+}
+
+RXP_PRINTF_CHECK(10, 0)
+RXP_MAYBE_UNUSED static void
+rxp_uint_assess_comparison(struct rx_context *context,
+                           rxp_uint x1,
+                           rxp_uint x2,
+                           enum rxp_op op,
+                           const char *expr1,
+                           const char *expr2,
+                           const char *file,
+                           int line,
+                           enum rx_severity severity,
+                           const char *failure_fmt,
+                           ...)
+{
+    int result;
+    char *failure_msg;
+    char *diagnostic_msg;
+
+    RX_ASSERT(context != NULL);
+    RX_ASSERT(expr1 != NULL);
+    RX_ASSERT(expr2 != NULL);
+    RX_ASSERT(file != NULL);
+
+    switch (op) {
+        case RXP_OP_EQUAL:
+            result = x1 == x2;
+            break;
+        case RXP_OP_NOT_EQUAL:
+            result = x1 != x2;
+            break;
+        case RXP_OP_GREATER:
+            result = x1 > x2;
+            break;
+        case RXP_OP_LESSER:
+            result = x1 < x2;
+            break;
+        case RXP_OP_GREATER_OR_EQUAL:
+            result = x1 >= x2;
+            break;
+        case RXP_OP_LESSER_OR_EQUAL:
+            result = x1 <= x2;
+            break;
+        default:
+            RX_ASSERT(0);
+            result = 0;
+            break;
+    }
+
+    if (result) {
+        failure_msg = NULL;
+        diagnostic_msg = NULL;
+    } else {
+        enum rx_status status;
+        const char *op_symbol;
+
+        if (failure_fmt == NULL) {
+            const char *op_name;
+
+            rxp_op_get_name(&op_name, op);
+            RXP_STR_CREATE_3(status,
+                             failure_msg,
+                             "`%s` is expected to be %s `%s`",
+                             expr1,
+                             op_name,
+                             expr2);
+        } else {
+            RXP_STR_CREATE_VA_LIST(status, failure_msg, failure_fmt);
+        }
+
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the failure message for "
+                            "the unsigned integer comparison test located at "
+                            "%s:%d\n",
+                            file,
+                            line);
+            failure_msg = NULL;
+        }
+
+        rxp_op_get_symbol(&op_symbol, op);
+        RXP_STR_CREATE_3(status,
+                         diagnostic_msg,
+                         "%lu %s %lu",
+                         (unsigned long)x1,
+                         op_symbol,
+                         (unsigned long)x2);
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the diagnostic message for "
+                            "the unsigned integer comparison test located at "
+                            "%s:%d\n",
+                            file,
+                            line);
+            diagnostic_msg = NULL;
+        }
+    }
+
+    if (rx_handle_test_result(
+            context, result, file, line, severity, failure_msg, diagnostic_msg)
+        != RX_SUCCESS) {
+        RXP_LOG_DEBUG_2("failed to handle the test result for the unsigned "
+                        "integer comparison test located at %s:%d\n",
+                        file,
+                        line);
+    }
+
+    RX_FREE(failure_msg);
+    RX_FREE(diagnostic_msg);
+
+    if (!result && severity == RX_FATAL) {
+        rx_abort(context);
+    }
+}
+
+RXP_PRINTF_CHECK(10, 0)
+RXP_MAYBE_UNUSED static void
+rxp_real_assess_comparison(struct rx_context *context,
+                           rxp_real x1,
+                           rxp_real x2,
+                           enum rxp_op op,
+                           const char *expr1,
+                           const char *expr2,
+                           const char *file,
+                           int line,
+                           enum rx_severity severity,
+                           const char *failure_fmt,
+                           ...)
+{
+    int result;
+    char *failure_msg;
+    char *diagnostic_msg;
+
+    RX_ASSERT(context != NULL);
+    RX_ASSERT(expr1 != NULL);
+    RX_ASSERT(expr2 != NULL);
+    RX_ASSERT(file != NULL);
+
+    switch (op) {
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#endif
+        case RXP_OP_EQUAL:
+            result = x1 == x2;
+            break;
+        case RXP_OP_NOT_EQUAL:
+            result = x1 != x2;
+            break;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+        case RXP_OP_GREATER:
+            result = x1 > x2;
+            break;
+        case RXP_OP_LESSER:
+            result = x1 < x2;
+            break;
+        case RXP_OP_GREATER_OR_EQUAL:
+            result = x1 >= x2;
+            break;
+        case RXP_OP_LESSER_OR_EQUAL:
+            result = x1 <= x2;
+            break;
+        default:
+            RX_ASSERT(0);
+            result = 0;
+            break;
+    }
+
+    if (result) {
+        failure_msg = NULL;
+        diagnostic_msg = NULL;
+    } else {
+        enum rx_status status;
+        const char *op_symbol;
+
+        if (failure_fmt == NULL) {
+            const char *op_name;
+
+            rxp_op_get_name(&op_name, op);
+            RXP_STR_CREATE_3(status,
+                             failure_msg,
+                             "`%s` is expected to be %s `%s`",
+                             expr1,
+                             op_name,
+                             expr2);
+        } else {
+            RXP_STR_CREATE_VA_LIST(status, failure_msg, failure_fmt);
+        }
+
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the failure message for "
+                            "the real comparison test located at %s:%d\n",
+                            file,
+                            line);
+            failure_msg = NULL;
+        }
+
+        rxp_op_get_symbol(&op_symbol, op);
+        RXP_STR_CREATE_3(
+            status, diagnostic_msg, "%Lf %s %Lf", x1, op_symbol, x2);
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the diagnostic message for "
+                            "the real comparison test located at %s:%d\n",
+                            file,
+                            line);
+            diagnostic_msg = NULL;
+        }
+    }
+
+    if (rx_handle_test_result(
+            context, result, file, line, severity, failure_msg, diagnostic_msg)
+        != RX_SUCCESS) {
+        RXP_LOG_DEBUG_2("failed to handle the test result for the real "
+                        "comparison test located at %s:%d\n",
+                        file,
+                        line);
+    }
+
+    RX_FREE(failure_msg);
+    RX_FREE(diagnostic_msg);
+
+    if (!result && severity == RX_FATAL) {
+        rx_abort(context);
+    }
+}
+
+RXP_PRINTF_CHECK(11, 0)
+RXP_MAYBE_UNUSED static void
+rxp_real_assess_fuzzy_comparison(struct rx_context *context,
+                                 rxp_real x1,
+                                 rxp_real x2,
+                                 rxp_real tol,
+                                 enum rxp_op op,
+                                 const char *expr1,
+                                 const char *expr2,
+                                 const char *file,
+                                 int line,
+                                 enum rx_severity severity,
+                                 const char *failure_fmt,
+                                 ...)
+{
+    int result;
+    char *failure_msg;
+    char *diagnostic_msg;
+
+    RX_ASSERT(context != NULL);
+    RX_ASSERT(expr1 != NULL);
+    RX_ASSERT(expr2 != NULL);
+    RX_ASSERT(file != NULL);
+
+    switch (op) {
+        case RXP_OP_EQUAL:
+            rxp_real_are_equal_fuzzy(&result, x1, x2, tol);
+            break;
+        case RXP_OP_NOT_EQUAL:
+            rxp_real_are_equal_fuzzy(&result, x1, x2, tol);
+            result = !result;
+            break;
+        default:
+            RX_ASSERT(0);
+            result = 0;
+            break;
+    }
+
+    if (result) {
+        failure_msg = NULL;
+        diagnostic_msg = NULL;
+    } else {
+        enum rx_status status;
+        const char *op_symbol;
+
+        if (failure_fmt == NULL) {
+            const char *op_name;
+
+            rxp_op_get_name(&op_name, op);
+            RXP_STR_CREATE_4(status,
+                             failure_msg,
+                             "`%s` is expected to be almost %s `%s` "
+                             "(tolerance: %Lf)",
+                             expr1,
+                             op_name,
+                             expr2,
+                             tol);
+        } else {
+            RXP_STR_CREATE_VA_LIST(status, failure_msg, failure_fmt);
+        }
+
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the failure message for "
+                            "the real almost equal test located at %s:%d\n",
+                            file,
+                            line);
+            failure_msg = NULL;
+        }
+
+        rxp_op_get_symbol(&op_symbol, op);
+        RXP_STR_CREATE_3(
+            status, diagnostic_msg, "%Lf %s %Lf", x1, op_symbol, x2);
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the diagnostic message for "
+                            "the real almost equal test located at %s:%d\n",
+                            file,
+                            line);
+            diagnostic_msg = NULL;
+        }
+    }
+
+    if (rx_handle_test_result(
+            context, result, file, line, severity, failure_msg, diagnostic_msg)
+        != RX_SUCCESS) {
+        RXP_LOG_DEBUG_2("failed to handle the test result for the real "
+                        "almost equal test located at %s:%d\n",
+                        file,
+                        line);
+    }
+
+    RX_FREE(failure_msg);
+    RX_FREE(diagnostic_msg);
+
+    if (!result && severity == RX_FATAL) {
+        rx_abort(context);
+    }
+}
+
+RXP_PRINTF_CHECK(11, 0)
+RXP_MAYBE_UNUSED static void
+rxp_str_assess_comparison(struct rx_context *context,
+                          const char *s1,
+                          const char *s2,
+                          enum rxp_str_case str_case,
+                          enum rxp_op op,
+                          const char *expr1,
+                          const char *expr2,
+                          const char *file,
+                          int line,
+                          enum rx_severity severity,
+                          const char *failure_fmt,
+                          ...)
+{
+    int result;
+    char *failure_msg;
+    char *diagnostic_msg;
+
+    RX_ASSERT(context != NULL);
     RX_ASSERT(s1 != NULL);
     RX_ASSERT(s2 != NULL);
     RX_ASSERT(expr1 != NULL);
     RX_ASSERT(expr2 != NULL);
     RX_ASSERT(file != NULL);
 
-    switch (op) {
-        case RXP_OP_EQUAL:
-            str_case == RXP_STR_CASE_OBEY
-                ? rxp_str_are_equal(&result, s1, s2)
-                : rxp_str_are_equal_no_case(&result, s1, s2);
-            break;
-        case RXP_OP_NOT_EQUAL:
-            str_case == RXP_STR_CASE_OBEY
-                ? rxp_str_are_equal(&result, s1, s2)
-                : rxp_str_are_equal_no_case(&result, s1, s2);
-            result = !result;
-            break;
-        default:
-            RX_ASSERT(0);
-            result = 0;
-            break;
+    switch (op) {
+        case RXP_OP_EQUAL:
+            str_case == RXP_STR_CASE_OBEY
+                ? rxp_str_are_equal(&result, s1, s2)
+                : rxp_str_are_equal_no_case(&result, s1, s2);
+            break;
+        case RXP_OP_NOT_EQUAL:
+            str_case == RXP_STR_CASE_OBEY
+                ? rxp_str_are_equal(&result, s1, s2)
+                : rxp_str_are_equal_no_case(&result, s1, s2);
+            result = !result;
+            break;
+        default:
+            RX_ASSERT(0);
+            result = 0;
+            break;
+    }
+
+    if (result) {
+        failure_msg = NULL;
+        diagnostic_msg = NULL;
+    } else {
+        enum rx_status status;
+        const char *op_symbol;
+
+        if (failure_fmt == NULL) {
+            const char *str_case_type;
+            const char *op_name;
+
+            rxp_str_case_get_type(&str_case_type, str_case);
+            rxp_op_get_name(&op_name, op);
+            RXP_STR_CREATE_4(status,
+                             failure_msg,
+                             "`%s` is expected to be %s `%s` (case: %s)",
+                             expr1,
+                             op_name,
+                             expr2,
+                             str_case_type);
+        } else {
+            RXP_STR_CREATE_VA_LIST(status, failure_msg, failure_fmt);
+        }
+
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the failure message for "
+                            "the string comparison test located at %s:%d\n",
+                            file,
+                            line);
+            failure_msg = NULL;
+        }
+
+        rxp_op_get_symbol(&op_symbol, op);
+        RXP_STR_CREATE_3(
+            status, diagnostic_msg, "\"%s\" %s \"%s\"", s1, op_symbol, s2);
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the diagnostic message for "
+                            "the string comparison test located at %s:%d\n",
+                            file,
+                            line);
+            diagnostic_msg = NULL;
+        }
+    }
+
+    if (rx_handle_test_result(
+            context, result, file, line, severity, failure_msg, diagnostic_msg)
+        != RX_SUCCESS) {
+        RXP_LOG_DEBUG_2("failed to handle the test result for the string "
+                        "comparison test located at %s:%d\n",
+                        file,
+                        line);
+    }
+
+    RX_FREE(failure_msg);
+    RX_FREE(diagnostic_msg);
+
+    if (!result && severity == RX_FATAL) {
+        rx_abort(context);
+    }
+}
+
+RXP_PRINTF_CHECK(10, 0)
+RXP_MAYBE_UNUSED static void
+rxp_ptr_assess_comparison(struct rx_context *context,
+                          const void *x1,
+                          const void *x2,
+                          enum rxp_op op,
+                          const char *expr1,
+                          const char *expr2,
+                          const char *file,
+                          int line,
+                          enum rx_severity severity,
+                          const char *failure_fmt,
+                          ...)
+{
+    int result;
+    char *failure_msg;
+    char *diagnostic_msg;
+
+    RX_ASSERT(context != NULL);
+    RX_ASSERT(expr1 != NULL);
+    RX_ASSERT(expr2 != NULL);
+    RX_ASSERT(file != NULL);
+
+    switch (op) {
+        case RXP_OP_EQUAL:
+            result = x1 == x2;
+            break;
+        case RXP_OP_NOT_EQUAL:
+            result = x1 != x2;
+            break;
+        default:
+            RX_ASSERT(0);
+            result = 0;
+            break;
+    }
+
+    if (result) {
+        failure_msg = NULL;
+        diagnostic_msg = NULL;
+    } else {
+        enum rx_status status;
+        const char *op_symbol;
+
+        if (failure_fmt == NULL) {
+            const char *op_name;
+
+            rxp_op_get_name(&op_name, op);
+            RXP_STR_CREATE_3(status,
+                             failure_msg,
+                             "`%s` is expected to be %s `%s`",
+                             expr1,
+                             op_name,
+                             expr2);
+        } else {
+            RXP_STR_CREATE_VA_LIST(status, failure_msg, failure_fmt);
+        }
+
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the failure message for "
+                            "the pointer comparison test located at "
+                            "%s:%d\n",
+                            file,
+                            line);
+            failure_msg = NULL;
+        }
+
+        rxp_op_get_symbol(&op_symbol, op);
+        RXP_STR_CREATE_3(status,
+                         diagnostic_msg,
+                         "0x%08lx %s 0x%08lx",
+                         (uintptr_t)x1,
+                         op_symbol,
+                         (uintptr_t)x2);
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the diagnostic message for "
+                            "the pointer comparison test located at "
+                            "%s:%d\n",
+                            file,
+                            line);
+            diagnostic_msg = NULL;
+        }
+    }
+
+    if (rx_handle_test_result(
+            context, result, file, line, severity, failure_msg, diagnostic_msg)
+        != RX_SUCCESS) {
+        RXP_LOG_DEBUG_2("failed to handle the test result for the pointer "
+                        "comparison test located at %s:%d\n",
+                        file,
+                        line);
+    }
+
+    RX_FREE(failure_msg);
+    RX_FREE(diagnostic_msg);
+
+    if (!result && severity == RX_FATAL) {
+        rx_abort(context);
+    }
+}
+
+RXP_PRINTF_CHECK(8, 0)
+RXP_MAYBE_UNUSED static void
+rxp_ptr_assess_alignment(struct rx_context *context,
+                         const void *x,
+                         size_t alignment,
+                         const char *expr,
+                         const char *file,
+                         int line,
+                         enum rx_severity severity,
+                         const char *failure_fmt,
+                         ...)
+{
+    int result;
+    char *failure_msg;
+    char *diagnostic_msg;
+
+    RX_ASSERT(context != NULL);
+    RX_ASSERT(expr != NULL);
+    RX_ASSERT(file != NULL);
+
+    result = (uintptr_t)x % alignment == 0;
+
+    if (result) {
+        failure_msg = NULL;
+        diagnostic_msg = NULL;
+    } else {
+        enum rx_status status;
+
+        if (failure_fmt == NULL) {
+            RXP_STR_CREATE_2(status,
+                             failure_msg,
+                             "`%s` is expected to have an %lu-byte alignment",
+                             expr,
+                             (unsigned long)alignment);
+        } else {
+            RXP_STR_CREATE_VA_LIST(status, failure_msg, failure_fmt);
+        }
+
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the failure message for "
+                            "the pointer alignment test located at "
+                            "%s:%d\n",
+                            file,
+                            line);
+            failure_msg = NULL;
+        }
+
+        RXP_STR_CREATE_2(status,
+                         diagnostic_msg,
+                         "0x%08lx %% %lu != 0",
+                         (uintptr_t)x,
+                         (unsigned long)alignment);
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the diagnostic message for "
+                            "the pointer alignment test located at "
+                            "%s:%d\n",
+                            file,
+                            line);
+            diagnostic_msg = NULL;
+        }
+    }
+
+    if (rx_handle_test_result(
+            context, result, file, line, severity, failure_msg, diagnostic_msg)
+        != RX_SUCCESS) {
+        RXP_LOG_DEBUG_2("failed to handle the test result for the pointer "
+                        "alignment test located at %s:%d\n",
+                        file,
+                        line);
+    }
+
+    RX_FREE(failure_msg);
+    RX_FREE(diagnostic_msg);
+
+    if (!result && severity == RX_FATAL) {
+        rx_abort(context);
+    }
+}
+
+/*
+   Allocation scopes compare the allocation counters of the running test case
+   against the ones recorded when the scope began. Without any allocation
+   tracking, there is nothing to compare and the scope is left unenforced.
+*/
+RXP_MAYBE_UNUSED static void
+rxp_alloc_scope_begin(struct rx_context *context)
+{
+    const struct rxp_alloc_counters *counters;
+
+    RX_ASSERT(context != NULL);
+
+    counters = rxp_alloc_tracking_get_counters();
+    if (counters == NULL) {
+        context->alloc_scope.active = 0;
+        return;
+    }
+
+    context->alloc_scope.active = 1;
+    context->alloc_scope.begin = *counters;
+}
+
+RXP_MAYBE_UNUSED static void
+rxp_alloc_scope_assess(struct rx_context *context,
+                       rx_uint64 max_count,
+                       rx_uint64 max_bytes,
+                       const char *file,
+                       int line,
+                       enum rx_severity severity)
+{
+    int result;
+    const struct rxp_alloc_counters *counters;
+    int enforced;
+    rx_uint64 count;
+    rx_uint64 bytes;
+    char *failure_msg;
+    char *diagnostic_msg;
+
+    RX_ASSERT(context != NULL);
+    RX_ASSERT(file != NULL);
+
+    counters = rxp_alloc_tracking_get_counters();
+    enforced = counters != NULL && context->alloc_scope.active;
+    context->alloc_scope.active = 0;
+
+    if (enforced) {
+        count = counters->allocation_count
+                - context->alloc_scope.begin.allocation_count;
+        bytes = counters->allocated_bytes
+                - context->alloc_scope.begin.allocated_bytes;
+        result = count <= max_count && bytes <= max_bytes;
+    } else {
+        count = 0;
+        bytes = 0;
+        result = 0;
+    }
+
+    if (result) {
+        failure_msg = NULL;
+        diagnostic_msg = NULL;
+    } else if (!enforced) {
+        enum rx_status status;
+
+        if (counters == NULL) {
+            RXP_STR_CREATE(status,
+                           failure_msg,
+                           "the allocations are expected to be tracked, see "
+                           "`RX_ENABLE_ALLOC_TRACKING`");
+        } else {
+            RXP_STR_CREATE(status,
+                           failure_msg,
+                           "an allocation scope is expected to have begun");
+        }
+
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the failure message for "
+                            "the allocation scope test located at %s:%d\n",
+                            file,
+                            line);
+            failure_msg = NULL;
+        }
+
+        diagnostic_msg = NULL;
+    } else {
+        enum rx_status status;
+
+        RXP_STR_CREATE_2(status,
+                         failure_msg,
+                         "the scope is expected to make at most %lu "
+                         "allocations of %lu bytes",
+                         (unsigned long)max_count,
+                         (unsigned long)max_bytes);
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the failure message for "
+                            "the allocation scope test located at %s:%d\n",
+                            file,
+                            line);
+            failure_msg = NULL;
+        }
+
+        RXP_STR_CREATE_2(status,
+                         diagnostic_msg,
+                         "%lu allocations of %lu bytes",
+                         (unsigned long)count,
+                         (unsigned long)bytes);
+        if (status != RX_SUCCESS) {
+            RXP_LOG_DEBUG_2("failed to create the diagnostic message for "
+                            "the allocation scope test located at %s:%d\n",
+                            file,
+                            line);
+            diagnostic_msg = NULL;
+        }
+    }
+
+    if (rx_handle_test_result(
+            context, result, file, line, severity, failure_msg, diagnostic_msg)
+        != RX_SUCCESS) {
+        RXP_LOG_DEBUG_2("failed to handle the test result for the allocation "
+                        "scope test located at %s:%d\n",
+                        file,
+                        line);
+    }
+
+    RX_FREE(failure_msg);
+    RX_FREE(diagnostic_msg);
+
+    if (!result && severity == RX_FATAL) {
+        rx_abort(context);
+    }
+}
+
+/* Implementation: Public API                                      O-(''Q)
+   -------------------------------------------------------------------------- */
+
+RXP_MAYBE_UNUSED RXP_STORAGE void
+rx_abort(struct rx_context *context)
+{
+    longjmp(context->env, 1);
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE const void *
+rx_get_suite_data(const struct rx_context *context)
+{
+    RX_ASSERT(context != NULL);
+
+    return context->suite_data;
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE rx_uint64
+rx_get_benchmark_arg(const struct rx_context *context)
+{
+    RX_ASSERT(context != NULL);
+
+    return context->benchmark_arg;
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE void
+rx_set_bytes_processed(struct rx_context *context, rx_uint64 count)
+{
+    RX_ASSERT(context != NULL);
+
+    if (context->summary != NULL) {
+        context->summary->metrics.bytes_processed = count;
+    }
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE void
+rx_set_items_processed(struct rx_context *context, rx_uint64 count)
+{
+    RX_ASSERT(context != NULL);
+
+    if (context->summary != NULL) {
+        context->summary->metrics.items_processed = count;
+    }
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE enum rx_status
+rx_set_metric(struct rx_context *context, const char *name, double value)
+{
+    struct rx_metrics *metrics;
+    size_t i;
+
+    RX_ASSERT(context != NULL);
+    RX_ASSERT(name != NULL);
+
+    if (context->summary == NULL) {
+        return RX_ERROR;
+    }
+
+    metrics = &context->summary->metrics;
+    for (i = 0; i < metrics->count; ++i) {
+        if (strcmp(metrics->values[i].name, name) == 0) {
+            metrics->values[i].value = value;
+            return RX_SUCCESS;
+        }
+    }
+
+    if (metrics->count == RXP_METRIC_MAX_COUNT) {
+        RXP_LOG_WARNING_1("too many metrics, \"%s\" is left out\n", name);
+        return RX_ERROR_MAX_SIZE_EXCEEDED;
+    }
+
+    metrics->values[metrics->count].name = name;
+    metrics->values[metrics->count].value = value;
+    ++metrics->count;
+    return RX_SUCCESS;
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE enum rx_status
+rx_record_latency(struct rx_context *context, const char *name, rx_uint64 ns)
+{
+    struct rx_latency_histograms *histograms;
+    struct rx_latency_histogram *histogram;
+    size_t i;
+
+    RX_ASSERT(context != NULL);
+    RX_ASSERT(name != NULL);
+
+    if (context->summary == NULL) {
+        return RX_ERROR;
+    }
+
+    histograms = &context->summary->latencies;
+    for (i = 0; i < histograms->count; ++i) {
+        if (strcmp(histograms->values[i].name, name) == 0) {
+            rxp_latency_histogram_record(&histograms->values[i], ns);
+            return RX_SUCCESS;
+        }
+    }
+
+    if (histograms->count == RXP_LATENCY_HISTOGRAM_MAX_COUNT) {
+        RXP_LOG_WARNING_1("too many latency histograms, \"%s\" is left out\n",
+                          name);
+        return RX_ERROR_MAX_SIZE_EXCEEDED;
+    }
+
+    histogram = (struct rx_latency_histogram *)RX_REALLOC(
+        histograms->values, sizeof *histogram * (histograms->count + 1));
+    if (histogram == NULL) {
+        RXP_LOG_ERROR_1("failed to allocate the latency histogram \"%s\"\n",
+                        name);
+        return RX_ERROR_ALLOCATION;
+    }
+
+    histograms->values = histogram;
+    histogram = &histograms->values[histograms->count];
+    memset(histogram, 0, sizeof *histogram);
+    histogram->name = name;
+    rxp_latency_histogram_record(histogram, ns);
+    ++histograms->count;
+    return RX_SUCCESS;
+}
+
+/*
+   As with HdrHistogram, the value reported for a percentile is the highest
+   one falling in the same bucket as the sample ranked at that percentile,
+   which is then clamped to the range of the recorded values.
+*/
+RXP_MAYBE_UNUSED RXP_STORAGE rx_uint64
+rx_latency_histogram_get_percentile(
+    const struct rx_latency_histogram *histogram, double percentile)
+{
+    double position;
+    rx_uint64 rank;
+    rx_uint64 total;
+    rx_uint64 value;
+    size_t i;
+
+    RX_ASSERT(histogram != NULL);
+
+    if (histogram->count == 0) {
+        return 0;
+    }
+
+    if (!(percentile < 100.0)) {
+        return histogram->max;
+    }
+
+    position = percentile / 100.0 * (double)histogram->count;
+    rank = (rx_uint64)position;
+    if ((double)rank < position || rank == 0) {
+        ++rank;
+    }
+
+    total = 0;
+    value = histogram->max;
+    for (i = 0; i < RXP_LATENCY_HISTOGRAM_BUCKET_COUNT; ++i) {
+        total += histogram->buckets[i];
+        if (total >= rank) {
+            value = rxp_latency_histogram_get_bucket_max(i);
+            break;
+        }
+    }
+
+    if (value < histogram->min) {
+        return histogram->min;
+    }
+
+    if (value > histogram->max) {
+        return histogram->max;
+    }
+
+    return value;
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE void
+rx_pause_timing(struct rx_context *context)
+{
+    RX_ASSERT(context != NULL);
+
+    rxp_benchmark_timing_pause(&context->benchmark_timing);
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE void
+rx_resume_timing(struct rx_context *context)
+{
+    RX_ASSERT(context != NULL);
+
+    rxp_benchmark_timing_resume(&context->benchmark_timing);
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE enum rx_status
+rx_handle_test_result(struct rx_context *context,
+                      int result,
+                      const char *file,
+                      int line,
+                      enum rx_severity severity,
+                      const char *failure_msg,
+                      const char *diagnostic_msg)
+{
+    struct rx_summary *summary;
+
+    RX_ASSERT(context != NULL);
+    RX_ASSERT(context->summary != NULL);
+    RX_ASSERT(context->summary->failures != NULL);
+    RX_ASSERT(file != NULL);
+
+    summary = context->summary;
+
+    ++summary->assessed_count;
+
+    if (result) {
+        return RX_SUCCESS;
+    }
+
+    return rxp_summary_add_failure(
+        summary, file, line, severity, failure_msg, diagnostic_msg);
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE enum rx_status
+rx_summary_initialize(struct rx_summary *summary,
+                      const struct rx_test_case *test_case)
+{
+    enum rx_status status;
+
+    RX_ASSERT(summary != NULL);
+    RX_ASSERT(test_case != NULL);
+
+    memset(summary, 0, sizeof *summary);
+
+    status = rxp_test_failure_array_create(&summary->failures, 0);
+    if (status != RX_SUCCESS) {
+        RXP_LOG_ERROR_2("failed to create the test failure array "
+                        "(suite: \"%s\", case: \"%s\")\n",
+                        test_case->suite_name,
+                        test_case->name);
+        return status;
+    }
+
+    summary->test_case = test_case;
+    return RX_SUCCESS;
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE void
+rx_summary_terminate(struct rx_summary *summary)
+{
+    RX_ASSERT(summary != NULL);
+    RX_ASSERT(summary->failures != NULL);
+
+    rxp_failures_destroy(summary->failures, summary->failure_count);
+    RX_FREE(summary->latencies.values);
+}
+
+static void
+rxp_phase_times_print(const char *phase,
+                      rx_uint64 wall_time,
+                      rx_uint64 cpu_time,
+                      int wall_time_available,
+                      int cpu_time_available)
+{
+    RX_ASSERT(phase != NULL);
+
+    if (!wall_time_available) {
+        return;
+    }
+
+    fprintf(stderr,
+            "; %s: %f ms",
+            phase,
+            (double)wall_time * (1000.0 / RXP_TICKS_PER_SECOND));
+    if (cpu_time_available) {
+        fprintf(stderr,
+                ", %f ms CPU",
+                (double)cpu_time * (1000.0 / RXP_TICKS_PER_SECOND));
+    }
+}
+
+static void
+rxp_get_si_prefix(double *scaled, const char **prefix, double value)
+{
+    static const char *const prefixes[] = {"", "k", "M", "G", "T"};
+    size_t i;
+
+    RX_ASSERT(scaled != NULL);
+    RX_ASSERT(prefix != NULL);
+
+    i = 0;
+    while ((value >= 1000.0 || value <= -1000.0)
+           && i + 1 < sizeof prefixes / sizeof *prefixes) {
+        value /= 1000.0;
+        ++i;
+    }
+
+    *scaled = value;
+    *prefix = prefixes[i];
+}
+
+/*
+   The metrics are turned into rates per second, based on the time elapsed
+   while they were being measured. The rates are left out if that time is
+   unknown.
+*/
+static void
+rxp_metrics_print(const struct rx_metrics *metrics, double seconds)
+{
+    size_t i;
+    double scaled;
+    const char *prefix;
+
+    RX_ASSERT(metrics != NULL);
+
+    if (!(seconds > 0.0)) {
+        seconds = 0.0;
+    }
+
+    if (metrics->bytes_processed > 0 && seconds > 0.0) {
+        rxp_get_si_prefix(
+            &scaled, &prefix, (double)metrics->bytes_processed / seconds);
+        fprintf(stderr, "; %.3f %sB/s", scaled, prefix);
+    }
+
+    if (metrics->items_processed > 0 && seconds > 0.0) {
+        rxp_get_si_prefix(
+            &scaled, &prefix, (double)metrics->items_processed / seconds);
+        fprintf(stderr, "; %.3f %s items/s", scaled, prefix);
+    }
+
+    for (i = 0; i < metrics->count; ++i) {
+        const struct rx_metric *metric;
+
+        metric = &metrics->values[i];
+        fprintf(stderr, "; %s: %g", metric->name, metric->value);
+        if (seconds > 0.0) {
+            rxp_get_si_prefix(&scaled, &prefix, metric->value / seconds);
+            fprintf(stderr, " (%.3f %s/s)", scaled, prefix);
+        }
+    }
+}
+
+static void
+rxp_latencies_print(const struct rx_latency_histograms *histograms)
+{
+    static const double percentiles[] = {50.0, 90.0, 99.0, 99.9};
+    size_t i;
+    size_t j;
+
+    RX_ASSERT(histograms != NULL);
+
+    for (i = 0; i < histograms->count; ++i) {
+        const struct rx_latency_histogram *histogram;
+
+        histogram = &histograms->values[i];
+        fprintf(stderr,
+                "latency \"%s\" (%lu samples):",
+                histogram->name,
+                (unsigned long)histogram->count);
+        for (j = 0; j < sizeof percentiles / sizeof *percentiles; ++j) {
+            fprintf(stderr,
+                    " p%g %f ms,",
+                    percentiles[j],
+                    (double)rx_latency_histogram_get_percentile(
+                        histogram, percentiles[j])
+                        / 1e6);
+        }
+
+        fprintf(stderr, " max %f ms\n", (double)histogram->max / 1e6);
+    }
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE void
+rx_summary_print(const struct rx_summary *summary)
+{
+    int passed;
+    const char *style_begin;
+    const char *style_end;
+
+    RX_ASSERT(summary != NULL);
+    RX_ASSERT(summary->test_case != NULL);
+    RX_ASSERT(summary->test_case->suite_name != NULL);
+    RX_ASSERT(summary->test_case->name != NULL);
+    RX_ASSERT(summary->failures != NULL);
+
+    passed = summary->failure_count == 0;
+
+#if RXP_LOG_STYLING
+    if (RXP_ISATTY(RXP_FILENO(stderr))) {
+        rxp_log_style_get_ansi_code(
+            &style_begin,
+            passed ? RXP_LOG_STYLE_BRIGHT_GREEN : RXP_LOG_STYLE_BRIGHT_RED);
+        rxp_log_style_get_ansi_code(&style_end, RXP_LOG_STYLE_RESET);
+    } else {
+        style_begin = style_end = "";
+    }
+#else
+    style_begin = style_end = "";
+#endif
+
+    fprintf(stderr,
+            "[%s%s%s] \"%s\" / \"%s\" (%f ms",
+            style_begin,
+            passed ? "PASSED" : "FAILED",
+            style_end,
+            summary->test_case->suite_name,
+            summary->test_case->name,
+            (double)summary->elapsed * (1000.0 / RXP_TICKS_PER_SECOND));
+
+    if (summary->cpu_time.run_available) {
+        fprintf(stderr,
+                ", %f ms CPU",
+                (double)summary->cpu_time.run
+                    * (1000.0 / RXP_TICKS_PER_SECOND));
+    }
+
+    if (summary->test_case->config.fixture.config.set_up != NULL) {
+        rxp_phase_times_print("set-up",
+                              summary->wall_time.set_up,
+                              summary->cpu_time.set_up,
+                              summary->wall_time.set_up_available,
+                              summary->cpu_time.set_up_available);
+    }
+
+    if (summary->test_case->config.fixture.config.tear_down != NULL) {
+        rxp_phase_times_print("tear-down",
+                              summary->wall_time.tear_down,
+                              summary->cpu_time.tear_down,
+                              summary->wall_time.tear_down_available,
+                              summary->cpu_time.tear_down_available);
+    }
+
+    if (summary->perf_counters.available) {
+        const struct rx_perf_counters *counters;
+
+        counters = &summary->perf_counters;
+        fprintf(stderr,
+                "; %.0f cycles, %.0f instructions, %.2f IPC, "
+                "%.0f cache misses, %.0f branch misses",
+                (double)counters->cycles,
+                (double)counters->instructions,
+                counters->cycles > 0 ? (double)counters->instructions
+                                           / (double)counters->cycles
+                                     : 0.0,
+                (double)counters->cache_misses,
+                (double)counters->branch_misses);
+    }
+
+    if (summary->alloc_stats.available) {
+        const struct rx_alloc_stats *stats;
+
+        stats = &summary->alloc_stats;
+        fprintf(stderr,
+                "; %lu allocations of %lu bytes, %lu bytes peak, "
+                "%lu bytes in %lu blocks still live",
+                (unsigned long)stats->allocation_count,
+                (unsigned long)stats->allocated_bytes,
+                (unsigned long)stats->peak_bytes,
+                (unsigned long)stats->live_bytes,
+                (unsigned long)stats->live_count);
+    }
+
+    rxp_metrics_print(&summary->metrics,
+                      (double)summary->elapsed / RXP_TICKS_PER_SECOND);
+    fputs(")\n", stderr);
+
+    rxp_latencies_print(&summary->latencies);
+
+    rxp_failures_print(summary->failures, summary->failure_count);
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE void
+rx_repetition_summary_print(const struct rx_repetition_summary *summary)
+{
+    const char *label;
+    const char *style_begin;
+    const char *style_end;
+
+    RX_ASSERT(summary != NULL);
+    RX_ASSERT(summary->test_case != NULL);
+    RX_ASSERT(summary->test_case->suite_name != NULL);
+    RX_ASSERT(summary->test_case->name != NULL);
+
+    /* The test cases left over by a run stopping early have no runs. */
+    if (summary->run_count == 0) {
+        label = "NOT RUN";
+    } else if (summary->fail_count == 0) {
+        label = "PASSED";
+    } else if (summary->pass_count == 0) {
+        label = "FAILED";
+    } else {
+        label = "FLAKY";
     }
 
-    if (result) {
-        failure_msg = NULL;
-        diagnostic_msg = NULL;
+#if RXP_LOG_STYLING
+    if (RXP_ISATTY(RXP_FILENO(stderr))) {
+        rxp_log_style_get_ansi_code(
+            &style_begin,
+            summary->run_count == 0
+                ? RXP_LOG_STYLE_BRIGHT_BLACK
+                : (summary->fail_count == 0
+                       ? RXP_LOG_STYLE_BRIGHT_GREEN
+                       : (summary->pass_count == 0
+                              ? RXP_LOG_STYLE_BRIGHT_RED
+                              : RXP_LOG_STYLE_BRIGHT_YELLOW)));
+        rxp_log_style_get_ansi_code(&style_end, RXP_LOG_STYLE_RESET);
     } else {
-        enum rx_status status;
-        const char *op_symbol;
+        style_begin = style_end = "";
+    }
+#else
+    style_begin = style_end = "";
+#endif
 
-        if (failure_fmt == NULL) {
-            const char *str_case_type;
-            const char *op_name;
+    fprintf(stderr,
+            "[%s%s%s] \"%s\" / \"%s\"",
+            style_begin,
+            label,
+            style_end,
+            summary->test_case->suite_name,
+            summary->test_case->name);
 
-            rxp_str_case_get_type(&str_case_type, str_case);
-            rxp_op_get_name(&op_name, op);
-            RXP_STR_CREATE_4(status,
-                             failure_msg,
-                             "`%s` is expected to be %s `%s` (case: %s)",
-                             expr1,
-                             op_name,
-                             expr2,
-                             str_case_type);
-        } else {
-            RXP_STR_CREATE_VA_LIST(status, failure_msg, failure_fmt);
+    if (summary->run_count == 0) {
+        fputc('\n', stderr);
+        return;
+    }
+
+    fprintf(stderr,
+            " (%lu/%lu runs passed",
+            (unsigned long)summary->pass_count,
+            (unsigned long)summary->run_count);
+
+    /* Only the test cases that both passed and failed are flaky. */
+    if (summary->fail_count > 0 && summary->pass_count > 0) {
+        fprintf(stderr,
+                ", flake rate: %.2f%%",
+                (double)summary->fail_count * 100.0
+                    / (double)summary->run_count);
+    }
+
+    fprintf(stderr,
+            ", min: %f ms, median: %f ms, max: %f ms)\n",
+            (double)summary->elapsed_min * (1000.0 / RXP_TICKS_PER_SECOND),
+            (double)summary->elapsed_median * (1000.0 / RXP_TICKS_PER_SECOND),
+            (double)summary->elapsed_max * (1000.0 / RXP_TICKS_PER_SECOND));
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE void
+rx_sort_summaries_by_test_suite(struct rx_summary *summaries,
+                                rx_size summary_count)
+{
+    qsort(summaries,
+          summary_count,
+          sizeof *summaries,
+          rxp_compare_summaries_by_test_suite);
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE void
+rx_group_summaries_by_test_suite(rx_size *summary_group_count,
+                                 struct rx_summary_group *summary_groups,
+                                 rx_size summary_count,
+                                 const struct rx_summary *summaries)
+{
+    size_t i;
+    struct rx_summary_group *it;
+
+    RX_ASSERT(summary_group_count != NULL);
+
+    if (summary_count == 0) {
+        *summary_group_count = 0;
+        return;
+    }
+
+    RX_ASSERT(summaries != NULL);
+
+    if (summary_groups == NULL) {
+        *summary_group_count = 1;
+        for (i = 0; i < summary_count - 1; ++i) {
+            *summary_group_count
+                += (rx_size)(rxp_compare_summaries_by_test_suite(
+                                 &summaries[i], &summaries[i + 1])
+                             != 0);
+        }
+
+        return;
+    }
+
+    it = summary_groups;
+    it->count = 0;
+    it->array = summaries;
+    for (i = 0; i < summary_count - 1; ++i) {
+        ++it->count;
+
+        if (rxp_compare_summaries_by_test_suite(&summaries[i],
+                                                &summaries[i + 1])
+            != 0) {
+            ++it;
+            it->count = 0;
+            it->array = &summaries[i + 1];
+        }
+    }
+
+    ++it->count;
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE enum rx_status
+rx_test_case_run(struct rx_summary *summary,
+                 const struct rx_test_case *test_case)
+{
+    enum rx_status status;
+    void *suite_data;
+
+    RX_ASSERT(summary != NULL);
+    RX_ASSERT(test_case != NULL);
+
+    if (!rxp_test_case_has_suite_fixture(test_case)) {
+        return rxp_test_case_run(summary, test_case, NULL, 0, NULL);
+    }
+
+    /* Without a runner to share it, the suite fixture only lives for
+       the duration of this test case. */
+    status = rxp_suite_fixture_set_up(&suite_data, test_case);
+    if (status != RX_SUCCESS) {
+        summary->error = "failed to set-up the suite fixture\0";
+        return status;
+    }
+
+    status = rxp_test_case_run(summary, test_case, suite_data, 0, NULL);
+    rxp_suite_fixture_tear_down(test_case, suite_data);
+    return status;
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE void
+rx_enumerate_test_cases(rx_size *test_case_count,
+                        struct rx_test_case *test_cases)
+{
+    size_t i;
+    const struct rxp_test_case_desc *const *c_it;
+
+    RX_ASSERT(test_case_count != NULL);
+
+#if !RXP_TEST_DISCOVERY
+    RXP_UNUSED(test_cases);
+    RXP_UNUSED(i);
+    RXP_UNUSED(c_it);
+
+    *test_case_count = 0;
+    return;
+#else
+    if (test_cases == NULL) {
+        *test_case_count = 0;
+        for (c_it = RXP_TEST_CASE_SECTION_BEGIN;
+             c_it != RXP_TEST_CASE_SECTION_END;
+             ++c_it) {
+            *test_case_count += (rx_size)(*c_it != NULL);
+        }
+
+        return;
+    }
+
+    i = 0;
+    for (c_it = RXP_TEST_CASE_SECTION_BEGIN; c_it != RXP_TEST_CASE_SECTION_END;
+         ++c_it) {
+        const struct rxp_test_suite_desc *const *s_it;
+        struct rxp_test_case_config_blueprint config_blueprint;
+        struct rx_test_case *test_case;
+
+        if (*c_it == NULL) {
+            continue;
+        }
+
+        /* Find the corresponding test suite description, if any. */
+        for (s_it = RXP_TEST_SUITE_SECTION_BEGIN;
+             s_it != RXP_TEST_SUITE_SECTION_END;
+             ++s_it) {
+            if (*s_it == NULL) {
+                continue;
+            }
+
+            if (strcmp((*s_it)->name, (*c_it)->suite_name) == 0) {
+                break;
+            }
+        }
+
+        memset(&config_blueprint, 0, sizeof config_blueprint);
+
+        if (s_it != RXP_TEST_SUITE_SECTION_END
+            && (*s_it)->config_desc != NULL) {
+            /* Inherit the config from the test suite's description. */
+            (*s_it)->config_desc->update(&config_blueprint);
+        }
+
+        if ((*c_it)->config_desc != NULL) {
+            /* Inherit the config from the test case's description. */
+            (*c_it)->config_desc->update(&config_blueprint);
+        }
+
+        test_case = &test_cases[i];
+
+        test_case->suite_name = (*c_it)->suite_name;
+        test_case->name = (*c_it)->name;
+        test_case->run = (*c_it)->run;
+
+        test_case->config.skip = config_blueprint.skip;
+        test_case->config.timeout = config_blueprint.timeout;
+
+        memset(&test_case->config.fixture, 0, sizeof test_case->config.fixture);
+
+        if (config_blueprint.fixture != NULL) {
+            test_case->config.fixture.size = config_blueprint.fixture->size;
+
+            if (config_blueprint.fixture->update != NULL) {
+                config_blueprint.fixture->update(
+                    &test_case->config.fixture.config);
+            }
+        }
+
+        memset(&test_case->config.suite_fixture,
+               0,
+               sizeof test_case->config.suite_fixture);
+
+        if (config_blueprint.suite_fixture != NULL) {
+            test_case->config.suite_fixture.size
+                = config_blueprint.suite_fixture->size;
+
+            if (config_blueprint.suite_fixture->update != NULL) {
+                config_blueprint.suite_fixture->update(
+                    &test_case->config.suite_fixture.config);
+            }
         }
 
-        if (status != RX_SUCCESS) {
-            RXP_LOG_DEBUG_2("failed to create the failure message for "
-                            "the string comparison test located at %s:%d\n",
-                            file,
-                            line);
-            failure_msg = NULL;
-        }
+        ++i;
+    }
+
+    RX_ASSERT(i == *test_case_count);
+
+/* Objects that are defined in a custom memory section can only be retrieved
+   in an undefined order, so these need to be manually sorted afterwards
+   in a sensible way. */
+#ifndef RXP_DEBUG_TESTS
+    qsort(test_cases,
+          *test_case_count,
+          sizeof *test_cases,
+          rxp_compare_test_cases);
+#endif
+#endif
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE enum rx_status
+rx_benchmark_summary_initialize(struct rx_benchmark_summary *summary,
+                                const struct rx_benchmark *benchmark)
+{
+    RX_ASSERT(summary != NULL);
+    RX_ASSERT(benchmark != NULL);
+
+    memset(summary, 0, sizeof *summary);
+    summary->benchmark = benchmark;
+    return RX_SUCCESS;
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE void
+rx_benchmark_summary_terminate(struct rx_benchmark_summary *summary)
+{
+    RX_ASSERT(summary != NULL);
 
-        rxp_op_get_symbol(&op_symbol, op);
-        RXP_STR_CREATE_3(
-            status, diagnostic_msg, "\"%s\" %s \"%s\"", s1, op_symbol, s2);
-        if (status != RX_SUCCESS) {
-            RXP_LOG_DEBUG_2("failed to create the diagnostic message for "
-                            "the string comparison test located at %s:%d\n",
-                            file,
-                            line);
-            diagnostic_msg = NULL;
-        }
+    RX_FREE(summary->samples);
+    RX_FREE(summary->cpu_samples);
+    summary->samples = NULL;
+    summary->cpu_samples = NULL;
+    summary->sample_count = 0;
+
+    if (summary->failures != NULL) {
+        rxp_failures_destroy(summary->failures, summary->failure_count);
+        summary->failures = NULL;
+        summary->failure_count = 0;
     }
+}
 
-    if (rx_handle_test_result(
-            context, result, file, line, severity, failure_msg, diagnostic_msg)
-        != RX_SUCCESS) {
-        RXP_LOG_DEBUG_2("failed to handle the test result for the string "
-                        "comparison test located at %s:%d\n",
-                        file,
-                        line);
+RXP_MAYBE_UNUSED RXP_STORAGE void
+rx_benchmark_summary_print(const struct rx_benchmark_summary *summary)
+{
+    const char *label;
+    const char *style_begin;
+    const char *style_end;
+    char suffix[RXP_BENCHMARK_ARG_SUFFIX_SIZE];
+
+    RX_ASSERT(summary != NULL);
+    RX_ASSERT(summary->benchmark != NULL);
+    RX_ASSERT(summary->benchmark->suite_name != NULL);
+    RX_ASSERT(summary->benchmark->name != NULL);
+
+    rxp_benchmark_summary_get_arg_suffix(suffix, summary);
+
+    if (summary->skipped) {
+        label = "SKIPPED";
+    } else if (summary->error != NULL) {
+        label = "FAILED";
+    } else if (summary->unstable) {
+        label = "UNSTABLE";
+    } else {
+        label = "BENCH";
     }
 
-    RX_FREE(failure_msg);
-    RX_FREE(diagnostic_msg);
+#if RXP_LOG_STYLING
+    if (RXP_ISATTY(RXP_FILENO(stderr))) {
+        rxp_log_style_get_ansi_code(
+            &style_begin,
+            summary->skipped || summary->unstable
+                ? RXP_LOG_STYLE_BRIGHT_YELLOW
+                : (summary->error != NULL ? RXP_LOG_STYLE_BRIGHT_RED
+                                          : RXP_LOG_STYLE_BRIGHT_GREEN));
+        rxp_log_style_get_ansi_code(&style_end, RXP_LOG_STYLE_RESET);
+    } else {
+        style_begin = style_end = "";
+    }
+#else
+    style_begin = style_end = "";
+#endif
 
-    if (!result && severity == RX_FATAL) {
-        rx_abort(context);
+    if (summary->skipped || summary->error != NULL) {
+        fprintf(stderr,
+                "[%s%s%s] \"%s\" / \"%s%s\"%s%s\n",
+                style_begin,
+                label,
+                style_end,
+                summary->benchmark->suite_name,
+                summary->benchmark->name,
+                suffix,
+                summary->error != NULL ? ": " : "",
+                summary->error != NULL ? summary->error : "");
+        rxp_failures_print(summary->failures, summary->failure_count);
+        return;
     }
+
+    fprintf(stderr,
+            "[%s%s%s] \"%s\" / \"%s%s\" (median: %f ns/op, mean: %f ns/op, "
+            "stddev: %f ns/op",
+            style_begin,
+            label,
+            style_end,
+            summary->benchmark->suite_name,
+            summary->benchmark->name,
+            suffix,
+            summary->median,
+            summary->mean,
+            summary->stddev);
+
+    if (summary->cpu_samples != NULL) {
+        fprintf(stderr, ", CPU median: %f ns/op", summary->cpu_median);
+    }
+
+    fprintf(stderr,
+            ", %lu repetitions of %lu iterations",
+            (unsigned long)summary->sample_count,
+            (unsigned long)summary->iteration_count);
+
+    /* The metrics are set for each iteration. */
+    rxp_metrics_print(&summary->metrics, summary->median / 1e9);
+    fputs(")\n", stderr);
 }
 
-RXP_PRINTF_CHECK(10, 0)
-RXP_MAYBE_UNUSED static void
-rxp_ptr_assess_comparison(struct rx_context *context,
-                          const void *x1,
-                          const void *x2,
-                          enum rxp_op op,
-                          const char *expr1,
-                          const char *expr2,
-                          const char *file,
-                          int line,
-                          enum rx_severity severity,
-                          const char *failure_fmt,
-                          ...)
+RXP_MAYBE_UNUSED RXP_STORAGE enum rx_status
+rx_benchmark_run(struct rx_benchmark_summary *summary,
+                 const struct rx_benchmark *benchmark)
 {
-    int result;
-    char *failure_msg;
-    char *diagnostic_msg;
+    enum rx_status status;
+    struct rxp_timer timer;
+    struct rxp_benchmark_settings settings;
 
-    RX_ASSERT(context != NULL);
-    RX_ASSERT(expr1 != NULL);
-    RX_ASSERT(expr2 != NULL);
-    RX_ASSERT(file != NULL);
+    RX_ASSERT(summary != NULL);
+    RX_ASSERT(benchmark != NULL);
 
-    switch (op) {
-        case RXP_OP_EQUAL:
-            result = x1 == x2;
-            break;
-        case RXP_OP_NOT_EQUAL:
-            result = x1 != x2;
-            break;
-        default:
-            RX_ASSERT(0);
-            result = 0;
-            break;
+    status = rxp_timer_initialize(&timer);
+    if (status != RX_SUCCESS) {
+        RXP_LOG_ERROR("failed to initialize the benchmark timer\n");
+        return status;
     }
 
-    if (result) {
-        failure_msg = NULL;
-        diagnostic_msg = NULL;
-    } else {
-        enum rx_status status;
-        const char *op_symbol;
+    settings.min_time = benchmark->config.min_time > 0.0
+                            ? benchmark->config.min_time
+                            : RXP_BENCHMARK_DEFAULT_MIN_TIME;
+    settings.repetition_count = benchmark->config.repetition_count > 0
+                                    ? (size_t)benchmark->config.repetition_count
+                                    : RXP_BENCHMARK_DEFAULT_REPETITION_COUNT;
+    settings.warm_up_count = 0;
+    settings.max_cv = 0.0;
+    settings.max_repetition_count = 0;
+    return rxp_benchmark_run(summary, &timer, benchmark, &settings);
+}
 
-        if (failure_fmt == NULL) {
-            const char *op_name;
+RXP_MAYBE_UNUSED RXP_STORAGE void
+rx_enumerate_benchmarks(rx_size *benchmark_count,
+                        struct rx_benchmark *benchmarks)
+{
+    size_t i;
+    const struct rxp_benchmark_desc *const *b_it;
 
-            rxp_op_get_name(&op_name, op);
-            RXP_STR_CREATE_3(status,
-                             failure_msg,
-                             "`%s` is expected to be %s `%s`",
-                             expr1,
-                             op_name,
-                             expr2);
-        } else {
-            RXP_STR_CREATE_VA_LIST(status, failure_msg, failure_fmt);
+    RX_ASSERT(benchmark_count != NULL);
+
+#if !RXP_TEST_DISCOVERY
+    RXP_UNUSED(benchmarks);
+    RXP_UNUSED(i);
+    RXP_UNUSED(b_it);
+
+    *benchmark_count = 0;
+    return;
+#else
+    if (benchmarks == NULL) {
+        *benchmark_count = 0;
+        for (b_it = RXP_BENCHMARK_SECTION_BEGIN;
+             b_it != RXP_BENCHMARK_SECTION_END;
+             ++b_it) {
+            *benchmark_count += (rx_size)(*b_it != NULL);
         }
 
-        if (status != RX_SUCCESS) {
-            RXP_LOG_DEBUG_2("failed to create the failure message for "
-                            "the pointer comparison test located at "
-                            "%s:%d\n",
-                            file,
-                            line);
-            failure_msg = NULL;
+        return;
+    }
+
+    i = 0;
+    for (b_it = RXP_BENCHMARK_SECTION_BEGIN; b_it != RXP_BENCHMARK_SECTION_END;
+         ++b_it) {
+        struct rxp_benchmark_config_blueprint config_blueprint;
+        struct rx_benchmark *benchmark;
+
+        if (*b_it == NULL) {
+            continue;
         }
 
-        rxp_op_get_symbol(&op_symbol, op);
-        RXP_STR_CREATE_3(status,
-                         diagnostic_msg,
-                         "0x%08lx %s 0x%08lx",
-                         (uintptr_t)x1,
-                         op_symbol,
-                         (uintptr_t)x2);
-        if (status != RX_SUCCESS) {
-            RXP_LOG_DEBUG_2("failed to create the diagnostic message for "
-                            "the pointer comparison test located at "
-                            "%s:%d\n",
-                            file,
-                            line);
-            diagnostic_msg = NULL;
+        memset(&config_blueprint, 0, sizeof config_blueprint);
+
+        if ((*b_it)->config_desc != NULL) {
+            (*b_it)->config_desc->update(&config_blueprint);
         }
-    }
 
-    if (rx_handle_test_result(
-            context, result, file, line, severity, failure_msg, diagnostic_msg)
-        != RX_SUCCESS) {
-        RXP_LOG_DEBUG_2("failed to handle the test result for the pointer "
-                        "comparison test located at %s:%d\n",
-                        file,
-                        line);
-    }
+        benchmark = &benchmarks[i];
 
-    RX_FREE(failure_msg);
-    RX_FREE(diagnostic_msg);
+        benchmark->suite_name = (*b_it)->suite_name;
+        benchmark->name = (*b_it)->name;
+        benchmark->run = (*b_it)->run;
 
-    if (!result && severity == RX_FATAL) {
-        rx_abort(context);
+        benchmark->config.skip = config_blueprint.skip;
+        benchmark->config.min_time = config_blueprint.min_time;
+        benchmark->config.repetition_count = config_blueprint.repetition_count;
+        benchmark->config.range_min = config_blueprint.range_min;
+        benchmark->config.range_max = config_blueprint.range_max;
+        benchmark->config.range_multiplier = config_blueprint.range_multiplier;
+        benchmark->config.complexity_bound = config_blueprint.complexity_bound;
+
+        memset(&benchmark->config.fixture, 0, sizeof benchmark->config.fixture);
+
+        if (config_blueprint.fixture != NULL) {
+            benchmark->config.fixture.size = config_blueprint.fixture->size;
+
+            if (config_blueprint.fixture->update != NULL) {
+                config_blueprint.fixture->update(
+                    &benchmark->config.fixture.config);
+            }
+        }
+
+        ++i;
     }
+
+    RX_ASSERT(i == *benchmark_count);
+
+#ifndef RXP_DEBUG_TESTS
+    qsort(benchmarks,
+          *benchmark_count,
+          sizeof *benchmarks,
+          rxp_compare_benchmarks);
+#endif
+#endif
 }
 
-RXP_PRINTF_CHECK(8, 0)
-RXP_MAYBE_UNUSED static void
-rxp_ptr_assess_alignment(struct rx_context *context,
-                         const void *x,
-                         size_t alignment,
-                         const char *expr,
-                         const char *file,
-                         int line,
-                         enum rx_severity severity,
-                         const char *failure_fmt,
-                         ...)
+/*
+   Parse the command-line arguments, either rejecting the unknown ones or
+   leaving them to the program when `strict` is unset.
+*/
+static enum rx_status
+rxp_run_config_parse(struct rx_run_config *config,
+                     int argc,
+                     const char *const *argv,
+                     int strict)
 {
-    int result;
-    char *failure_msg;
-    char *diagnostic_msg;
+    int i;
+    const char *fail_fast;
 
-    RX_ASSERT(context != NULL);
-    RX_ASSERT(expr != NULL);
-    RX_ASSERT(file != NULL);
+    RX_ASSERT(config != NULL);
 
-    result = (uintptr_t)x % alignment == 0;
+    memset(config, 0, sizeof *config);
 
-    if (result) {
-        failure_msg = NULL;
-        diagnostic_msg = NULL;
-    } else {
+    fail_fast = getenv("RX_FAIL_FAST");
+    config->fail_fast = fail_fast != NULL && *fail_fast != '\0'
+                        && strcmp(fail_fast, "0") != 0;
+
+    for (i = 1; i < argc; ++i) {
         enum rx_status status;
+        int matched;
+        const char *value;
 
-        if (failure_fmt == NULL) {
-            RXP_STR_CREATE_2(status,
-                             failure_msg,
-                             "`%s` is expected to have an %lu-byte alignment",
-                             expr,
-                             (unsigned long)alignment);
-        } else {
-            RXP_STR_CREATE_VA_LIST(status, failure_msg, failure_fmt);
-        }
+        RX_ASSERT(argv != NULL);
+        RX_ASSERT(argv[i] != NULL);
 
+        status = rxp_arg_match(
+            &matched, &value, &i, argc, argv, "--jobs", RXP_ARG_OPTIONAL);
         if (status != RX_SUCCESS) {
-            RXP_LOG_DEBUG_2("failed to create the failure message for "
-                            "the pointer alignment test located at "
-                            "%s:%d\n",
-                            file,
-                            line);
-            failure_msg = NULL;
+            return status;
         }
 
-        RXP_STR_CREATE_2(status,
-                         diagnostic_msg,
-                         "0x%08lx %% %lu != 0",
-                         (uintptr_t)x,
-                         (unsigned long)alignment);
-        if (status != RX_SUCCESS) {
-            RXP_LOG_DEBUG_2("failed to create the diagnostic message for "
-                            "the pointer alignment test located at "
-                            "%s:%d\n",
-                            file,
-                            line);
-            diagnostic_msg = NULL;
+        if (matched) {
+            rx_uint64 job_count;
+
+            job_count = 0;
+            if (value != NULL) {
+                status = rxp_arg_parse_uint64(&job_count, "--jobs", value);
+                if (status != RX_SUCCESS) {
+                    return status;
+                }
+            }
+
+            if (job_count == 0) {
+                size_t cpu_count;
+
+                rxp_get_cpu_count(&cpu_count);
+                job_count = (rx_uint64)cpu_count;
+            }
+
+            config->job_count = (rx_size)job_count;
+            continue;
         }
-    }
 
-    if (rx_handle_test_result(
-            context, result, file, line, severity, failure_msg, diagnostic_msg)
-        != RX_SUCCESS) {
-        RXP_LOG_DEBUG_2("failed to handle the test result for the pointer "
-                        "alignment test located at %s:%d\n",
-                        file,
-                        line);
-    }
+        status = rxp_arg_match(
+            &matched, &value, &i, argc, argv, "--isolate", RXP_ARG_NONE);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-    RX_FREE(failure_msg);
-    RX_FREE(diagnostic_msg);
+        if (matched) {
+            config->isolate = 1;
+            continue;
+        }
 
-    if (!result && severity == RX_FATAL) {
-        rx_abort(context);
-    }
-}
+        status = rxp_arg_match(
+            &matched, &value, &i, argc, argv, "--timings", RXP_ARG_OPTIONAL);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-/* Implementation: Public API                                      O-(''Q)
-   -------------------------------------------------------------------------- */
+        if (matched) {
+            config->timings_path
+                = value != NULL ? value : RXP_DEFAULT_TIMINGS_PATH;
+            continue;
+        }
 
-RXP_MAYBE_UNUSED RXP_STORAGE void
-rx_abort(struct rx_context *context)
-{
-    longjmp(context->env, 1);
-}
+        status = rxp_arg_match(&matched,
+                               &value,
+                               &i,
+                               argc,
+                               argv,
+                               "--longest-first",
+                               RXP_ARG_NONE);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-RXP_MAYBE_UNUSED RXP_STORAGE enum rx_status
-rx_handle_test_result(struct rx_context *context,
-                      int result,
-                      const char *file,
-                      int line,
-                      enum rx_severity severity,
-                      const char *failure_msg,
-                      const char *diagnostic_msg)
-{
-    enum rx_status status;
-    struct rx_summary *summary;
-    struct rx_failure *failure;
-    size_t failure_count;
+        if (matched) {
+            config->longest_first = 1;
+            continue;
+        }
 
-    RX_ASSERT(context != NULL);
-    RX_ASSERT(context->summary != NULL);
-    RX_ASSERT(context->summary->failures != NULL);
-    RX_ASSERT(file != NULL);
+        status = rxp_arg_match(&matched,
+                               &value,
+                               &i,
+                               argc,
+                               argv,
+                               "--shard-index",
+                               RXP_ARG_REQUIRED);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-    summary = context->summary;
+        if (matched) {
+            rx_uint64 shard_index;
 
-    ++summary->assessed_count;
+            status = rxp_arg_parse_uint64(
+                &shard_index, "--shard-index", value);
+            if (status != RX_SUCCESS) {
+                return status;
+            }
 
-    if (result) {
-        return RX_SUCCESS;
-    }
+            config->shard_index = (rx_size)shard_index;
+            continue;
+        }
 
-    status
-        = rxp_test_failure_array_extend_back(&failure, &summary->failures, 1);
-    if (status != RX_SUCCESS) {
-        summary->error = "failed to extend the test failure array\0";
-        RXP_LOG_ERROR_2("failed to extend the test failure array for the test "
-                        "located at %s:%d\n",
-                        file,
-                        line);
-        return status;
-    }
+        status = rxp_arg_match(&matched,
+                               &value,
+                               &i,
+                               argc,
+                               argv,
+                               "--shard-count",
+                               RXP_ARG_REQUIRED);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-    rxp_test_failure_array_get_size(&failure_count, summary->failures);
-    summary->failure_count = failure_count;
+        if (matched) {
+            rx_uint64 shard_count;
 
-    {
-        char *buf;
+            status = rxp_arg_parse_uint64(
+                &shard_count, "--shard-count", value);
+            if (status != RX_SUCCESS) {
+                return status;
+            }
 
-        status = rxp_str_copy(&buf, file);
+            config->shard_count = (rx_size)shard_count;
+            continue;
+        }
+
+        status = rxp_arg_match(&matched,
+                               &value,
+                               &i,
+                               argc,
+                               argv,
+                               "--shard-manifest",
+                               RXP_ARG_REQUIRED);
         if (status != RX_SUCCESS) {
-            RXP_LOG_ERROR_2("failed to allocate the file name for the test "
-                            "located at %s:%d\n",
-                            file,
-                            line);
-            failure->file = NULL;
-        } else {
-            failure->file = buf;
+            return status;
         }
-    }
 
-    failure->line = line;
-    failure->severity = severity;
+        if (matched) {
+            config->shard_manifest_path = value;
+            continue;
+        }
 
-    if (failure_msg == NULL) {
-        failure->msg = NULL;
-    } else {
-        char *buf;
+        status = rxp_arg_match(
+            &matched, &value, &i, argc, argv, "--timeout", RXP_ARG_REQUIRED);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-        status = rxp_str_copy(&buf, failure_msg);
+        if (matched) {
+            status = rxp_arg_parse_double(&config->timeout, "--timeout", value);
+            if (status != RX_SUCCESS) {
+                return status;
+            }
+
+            continue;
+        }
+
+        status = rxp_arg_match(
+            &matched, &value, &i, argc, argv, "--fail-fast", RXP_ARG_NONE);
         if (status != RX_SUCCESS) {
-            RXP_LOG_ERROR_2("failed to allocate the failure message for "
-                            "the test located at %s:%d\n",
-                            file,
-                            line);
-            failure->msg = NULL;
-        } else {
-            failure->msg = buf;
+            return status;
         }
-    }
 
-    if (diagnostic_msg == NULL) {
-        failure->diagnostic_msg = NULL;
-    } else {
-        char *buf;
+        if (matched) {
+            config->fail_fast = 1;
+            continue;
+        }
 
-        status = rxp_str_copy(&buf, diagnostic_msg);
+        status = rxp_arg_match(
+            &matched, &value, &i, argc, argv, "--repeat", RXP_ARG_REQUIRED);
         if (status != RX_SUCCESS) {
-            RXP_LOG_ERROR_2("failed to allocate the diagnostic message for "
-                            "the test located at %s:%d\n",
-                            file,
-                            line);
-            failure->diagnostic_msg = NULL;
-        } else {
-            failure->diagnostic_msg = buf;
+            return status;
         }
-    }
 
-    return RX_SUCCESS;
-}
+        if (matched) {
+            rx_uint64 repeat_count;
 
-RXP_MAYBE_UNUSED RXP_STORAGE enum rx_status
-rx_summary_initialize(struct rx_summary *summary,
-                      const struct rx_test_case *test_case)
-{
-    enum rx_status status;
+            status = rxp_arg_parse_uint64(&repeat_count, "--repeat", value);
+            if (status != RX_SUCCESS) {
+                return status;
+            }
 
-    RX_ASSERT(summary != NULL);
-    RX_ASSERT(test_case != NULL);
+            config->repeat_count = (rx_size)repeat_count;
+            continue;
+        }
 
-    memset(summary, 0, sizeof *summary);
+        status = rxp_arg_match(
+            &matched, &value, &i, argc, argv, "--until-fail", RXP_ARG_NONE);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-    status = rxp_test_failure_array_create(&summary->failures, 0);
-    if (status != RX_SUCCESS) {
-        RXP_LOG_ERROR_2("failed to create the test failure array "
-                        "(suite: \"%s\", case: \"%s\")\n",
-                        test_case->suite_name,
-                        test_case->name);
-        return status;
-    }
+        if (matched) {
+            config->until_fail = 1;
+            continue;
+        }
 
-    summary->test_case = test_case;
-    return RX_SUCCESS;
-}
+        status = rxp_arg_match(
+            &matched, &value, &i, argc, argv, "--shuffle", RXP_ARG_OPTIONAL);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-RXP_MAYBE_UNUSED RXP_STORAGE void
-rx_summary_terminate(struct rx_summary *summary)
-{
-    size_t i;
+        if (matched) {
+            config->shuffle = 1;
+            if (value != NULL) {
+                status = rxp_arg_parse_uint64(
+                    &config->shuffle_seed, "--shuffle", value);
+                if (status != RX_SUCCESS) {
+                    return status;
+                }
+            } else {
+                uint64_t time;
 
-    RX_ASSERT(summary != NULL);
-    RX_ASSERT(summary->failures != NULL);
+                /* Derive a seed from the current time. */
+                if (rxp_get_real_time(&time) != RX_SUCCESS) {
+                    time = 0;
+                }
 
-    for (i = 0; i < summary->failure_count; ++i) {
-        const struct rx_failure *failure;
+                config->shuffle_seed = (rx_uint64)time;
+                config->shuffle_seed = rxp_random_next(&config->shuffle_seed);
+            }
 
-        failure = &summary->failures[i];
+            continue;
+        }
 
-        RX_FREE((void *)(uintptr_t)failure->file);
-        RX_FREE((void *)(uintptr_t)failure->msg);
-        RX_FREE((void *)(uintptr_t)failure->diagnostic_msg);
-    }
+        status = rxp_arg_match(
+            &matched, &value, &i, argc, argv, "--failures", RXP_ARG_OPTIONAL);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-    rxp_test_failure_array_destroy(summary->failures);
-}
+        if (matched) {
+            config->failures_path
+                = value != NULL ? value : RXP_DEFAULT_FAILURES_PATH;
+            continue;
+        }
 
-RXP_MAYBE_UNUSED RXP_STORAGE void
-rx_summary_print(const struct rx_summary *summary)
-{
-    size_t i;
-    int passed;
-    const char *style_begin;
-    const char *style_end;
+        status = rxp_arg_match(
+            &matched, &value, &i, argc, argv, "--failed-first", RXP_ARG_NONE);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-    RX_ASSERT(summary != NULL);
-    RX_ASSERT(summary->test_case != NULL);
-    RX_ASSERT(summary->test_case->suite_name != NULL);
-    RX_ASSERT(summary->test_case->name != NULL);
-    RX_ASSERT(summary->failures != NULL);
+        if (matched) {
+            config->failed_first = 1;
+            continue;
+        }
 
-    passed = summary->failure_count == 0;
+        status = rxp_arg_match(
+            &matched, &value, &i, argc, argv, "--only-failed", RXP_ARG_NONE);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-#if RXP_LOG_STYLING
-    if (RXP_ISATTY(RXP_FILENO(stderr))) {
-        rxp_log_style_get_ansi_code(
-            &style_begin,
-            passed ? RXP_LOG_STYLE_BRIGHT_GREEN : RXP_LOG_STYLE_BRIGHT_RED);
-        rxp_log_style_get_ansi_code(&style_end, RXP_LOG_STYLE_RESET);
-    } else {
-        style_begin = style_end = "";
-    }
-#else
-    style_begin = style_end = "";
-#endif
+        if (matched) {
+            config->only_failed = 1;
+            continue;
+        }
 
-    fprintf(stderr,
-            "[%s%s%s] \"%s\" / \"%s\" (%f ms)\n",
-            style_begin,
-            passed ? "PASSED" : "FAILED",
-            style_end,
-            summary->test_case->suite_name,
-            summary->test_case->name,
-            (double)summary->elapsed * (1000.0 / RXP_TICKS_PER_SECOND));
+        status = rxp_arg_match(
+            &matched, &value, &i, argc, argv, "--bench", RXP_ARG_NONE);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-    for (i = 0; i < summary->failure_count; ++i) {
-        const struct rx_failure *failure;
-        const char *failure_msg;
+        if (matched) {
+            config->bench = 1;
+            continue;
+        }
 
-        failure = &summary->failures[i];
-        failure_msg = failure->msg == NULL ? "" : failure->msg;
+        status = rxp_arg_match(&matched,
+                               &value,
+                               &i,
+                               argc,
+                               argv,
+                               "--bench-min-time",
+                               RXP_ARG_REQUIRED);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-        if (failure->diagnostic_msg != NULL) {
-            fprintf(stderr,
-                    "%s:%d: %s test failure: %s\n%s\n",
-                    failure->file,
-                    failure->line,
-                    failure->severity == RX_FATAL ? "fatal" : "nonfatal",
-                    failure_msg,
-                    failure->diagnostic_msg);
-        } else {
-            fprintf(stderr,
-                    "%s:%d: %s test failure: %s\n",
-                    failure->file,
-                    failure->line,
-                    failure->severity == RX_FATAL ? "fatal" : "nonfatal",
-                    failure_msg);
+        if (matched) {
+            status = rxp_arg_parse_double(
+                &config->bench_min_time, "--bench-min-time", value);
+            if (status != RX_SUCCESS) {
+                return status;
+            }
+
+            continue;
         }
-    }
-}
 
-RXP_MAYBE_UNUSED RXP_STORAGE void
-rx_sort_summaries_by_test_suite(struct rx_summary *summaries,
-                                rx_size summary_count)
-{
-    qsort(summaries,
-          summary_count,
-          sizeof *summaries,
-          rxp_compare_summaries_by_test_suite);
-}
+        status = rxp_arg_match(&matched,
+                               &value,
+                               &i,
+                               argc,
+                               argv,
+                               "--bench-repetitions",
+                               RXP_ARG_REQUIRED);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-RXP_MAYBE_UNUSED RXP_STORAGE void
-rx_group_summaries_by_test_suite(rx_size *summary_group_count,
-                                 struct rx_summary_group *summary_groups,
-                                 rx_size summary_count,
-                                 const struct rx_summary *summaries)
-{
-    size_t i;
-    struct rx_summary_group *it;
+        if (matched) {
+            rx_uint64 repetition_count;
+
+            status = rxp_arg_parse_uint64(
+                &repetition_count, "--bench-repetitions", value);
+            if (status != RX_SUCCESS) {
+                return status;
+            }
 
-    RX_ASSERT(summary_group_count != NULL);
+            config->bench_repetition_count = (rx_size)repetition_count;
+            continue;
+        }
 
-    if (summary_count == 0) {
-        *summary_group_count = 0;
-        return;
-    }
+        status = rxp_arg_match(&matched,
+                               &value,
+                               &i,
+                               argc,
+                               argv,
+                               "--bench-save",
+                               RXP_ARG_REQUIRED);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-    RX_ASSERT(summaries != NULL);
+        if (matched) {
+            config->bench = 1;
+            config->bench_save_path = value;
+            continue;
+        }
 
-    if (summary_groups == NULL) {
-        *summary_group_count = 1;
-        for (i = 0; i < summary_count - 1; ++i) {
-            *summary_group_count
-                += (rx_size)(rxp_compare_summaries_by_test_suite(
-                                 &summaries[i], &summaries[i + 1])
-                             != 0);
+        status = rxp_arg_match(&matched,
+                               &value,
+                               &i,
+                               argc,
+                               argv,
+                               "--bench-compare",
+                               RXP_ARG_REQUIRED);
+        if (status != RX_SUCCESS) {
+            return status;
         }
 
-        return;
-    }
+        if (matched) {
+            config->bench = 1;
+            config->bench_compare_path = value;
+            continue;
+        }
 
-    it = summary_groups;
-    it->count = 0;
-    it->array = summaries;
-    for (i = 0; i < summary_count - 1; ++i) {
-        ++it->count;
+        status = rxp_arg_match(&matched,
+                               &value,
+                               &i,
+                               argc,
+                               argv,
+                               "--bench-threshold",
+                               RXP_ARG_REQUIRED);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-        if (rxp_compare_summaries_by_test_suite(&summaries[i],
-                                                &summaries[i + 1])
-            != 0) {
-            ++it;
-            it->count = 0;
-            it->array = &summaries[i + 1];
+        if (matched) {
+            status = rxp_arg_parse_double(
+                &config->bench_threshold, "--bench-threshold", value);
+            if (status != RX_SUCCESS) {
+                return status;
+            }
+
+            continue;
         }
-    }
 
-    ++it->count;
-}
+        status = rxp_arg_match(&matched,
+                               &value,
+                               &i,
+                               argc,
+                               argv,
+                               "--bench-stable",
+                               RXP_ARG_NONE);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-RXP_MAYBE_UNUSED RXP_STORAGE enum rx_status
-rx_test_case_run(struct rx_summary *summary,
-                 const struct rx_test_case *test_case)
-{
-    enum rx_status status;
-    struct rx_context context;
-    void *data;
-    uint64_t time_begin;
-    uint64_t time_end;
+        if (matched) {
+            config->bench = 1;
+            config->bench_stable = 1;
+            continue;
+        }
 
-    RX_ASSERT(summary != NULL);
-    RX_ASSERT(test_case != NULL);
-    RX_ASSERT(test_case->suite_name != NULL);
-    RX_ASSERT(test_case->name != NULL);
-    RX_ASSERT(test_case->run != NULL);
+        status = rxp_arg_match(&matched,
+                               &value,
+                               &i,
+                               argc,
+                               argv,
+                               "--bench-warm-up",
+                               RXP_ARG_REQUIRED);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-    if (test_case->config.skip) {
-        summary->skipped = 1;
-        return RX_SUCCESS;
-    }
+        if (matched) {
+            rx_uint64 warm_up_count;
 
-    status = RX_SUCCESS;
-    context.summary = summary;
+            status = rxp_arg_parse_uint64(
+                &warm_up_count, "--bench-warm-up", value);
+            if (status != RX_SUCCESS) {
+                return status;
+            }
 
-    if (test_case->config.fixture.size > 0) {
-        data = RX_MALLOC(test_case->config.fixture.size);
-        if (data == NULL) {
-            summary->error = "failed to allocate the data\0";
-            RXP_LOG_ERROR_2("failed to allocate the data"
-                            "(suite: \"%s\", case: \"%s\")\n",
-                            test_case->suite_name,
-                            test_case->name);
-            return RX_ERROR_ALLOCATION;
+            config->bench_warm_up_count = (rx_size)warm_up_count;
+            continue;
         }
-    } else {
-        data = NULL;
-    }
 
-    if (test_case->config.fixture.config.set_up != NULL) {
-        status = test_case->config.fixture.config.set_up(&context, data);
+        status = rxp_arg_match(&matched,
+                               &value,
+                               &i,
+                               argc,
+                               argv,
+                               "--bench-max-cv",
+                               RXP_ARG_REQUIRED);
         if (status != RX_SUCCESS) {
-            summary->error = "failed to set-up the fixture\0";
-            RXP_LOG_ERROR_2("failed to set-up the fixture "
-                            "(suite: \"%s\", case: \"%s\")\n",
-                            test_case->suite_name,
-                            test_case->name);
-            goto data_cleanup;
+            return status;
         }
-    }
 
-    if (rxp_get_real_time(&time_begin) != RX_SUCCESS) {
-        time_begin = (uint64_t)-1;
-    }
+        if (matched) {
+            status = rxp_arg_parse_double(
+                &config->bench_max_cv, "--bench-max-cv", value);
+            if (status != RX_SUCCESS) {
+                return status;
+            }
 
-    if (setjmp(context.env) == 0) {
-        test_case->run(&context, data);
-    }
+            continue;
+        }
 
-    if (time_begin == (uint64_t)-1
-        || rxp_get_real_time(&time_end) != RX_SUCCESS) {
-        RXP_LOG_ERROR_2("failed to measure the time elapsed "
-                        "(suite: \"%s\", case: \"%s\")\n",
-                        test_case->suite_name,
-                        test_case->name);
-        summary->elapsed = 0;
-    } else {
-        RX_ASSERT(time_end >= time_begin);
-        summary->elapsed = (rx_uint64)(time_end - time_begin);
-    }
+        status = rxp_arg_match(&matched,
+                               &value,
+                               &i,
+                               argc,
+                               argv,
+                               "--bench-max-repetitions",
+                               RXP_ARG_REQUIRED);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-    if (test_case->config.fixture.config.tear_down != NULL) {
-        test_case->config.fixture.config.tear_down(&context, data);
-    }
+        if (matched) {
+            rx_uint64 max_repetition_count;
 
-data_cleanup:
-    RX_FREE(data);
-    return status;
-}
+            status = rxp_arg_parse_uint64(
+                &max_repetition_count, "--bench-max-repetitions", value);
+            if (status != RX_SUCCESS) {
+                return status;
+            }
 
-RXP_MAYBE_UNUSED RXP_STORAGE void
-rx_enumerate_test_cases(rx_size *test_case_count,
-                        struct rx_test_case *test_cases)
-{
-    size_t i;
-    const struct rxp_test_case_desc *const *c_it;
+            config->bench_max_repetition_count = (rx_size)max_repetition_count;
+            continue;
+        }
 
-    RX_ASSERT(test_case_count != NULL);
+        status = rxp_arg_match(&matched,
+                               &value,
+                               &i,
+                               argc,
+                               argv,
+                               "--bench-json",
+                               RXP_ARG_REQUIRED);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-#if !RXP_TEST_DISCOVERY
-    RXP_UNUSED(test_cases);
-    RXP_UNUSED(i);
-    RXP_UNUSED(c_it);
+        if (matched) {
+            config->bench = 1;
+            config->bench_json_path = value;
+            continue;
+        }
 
-    *test_case_count = 0;
-    return;
-#else
-    if (test_cases == NULL) {
-        *test_case_count = 0;
-        for (c_it = RXP_TEST_CASE_SECTION_BEGIN;
-             c_it != RXP_TEST_CASE_SECTION_END;
-             ++c_it) {
-            *test_case_count += (rx_size)(*c_it != NULL);
+        status = rxp_arg_match(&matched,
+                               &value,
+                               &i,
+                               argc,
+                               argv,
+                               "--perf-counters",
+                               RXP_ARG_NONE);
+        if (status != RX_SUCCESS) {
+            return status;
         }
 
-        return;
-    }
+        if (matched) {
+            config->perf_counters = 1;
+            continue;
+        }
 
-    i = 0;
-    for (c_it = RXP_TEST_CASE_SECTION_BEGIN; c_it != RXP_TEST_CASE_SECTION_END;
-         ++c_it) {
-        const struct rxp_test_suite_desc *const *s_it;
-        struct rxp_test_case_config_blueprint config_blueprint;
-        struct rx_test_case *test_case;
+        status = rxp_arg_match(
+            &matched, &value, &i, argc, argv, "--profile", RXP_ARG_OPTIONAL);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-        if (*c_it == NULL) {
+        if (matched) {
+            config->profile_path = value != NULL ? value : ".";
             continue;
         }
 
-        /* Find the corresponding test suite description, if any. */
-        for (s_it = RXP_TEST_SUITE_SECTION_BEGIN;
-             s_it != RXP_TEST_SUITE_SECTION_END;
-             ++s_it) {
-            if (*s_it == NULL) {
-                continue;
-            }
+        status = rxp_arg_match(
+            &matched, &value, &i, argc, argv, "--top", RXP_ARG_REQUIRED);
+        if (status != RX_SUCCESS) {
+            return status;
+        }
 
-            if (strcmp((*s_it)->name, (*c_it)->suite_name) == 0) {
-                break;
+        if (matched) {
+            rx_uint64 top_count;
+
+            status = rxp_arg_parse_uint64(&top_count, "--top", value);
+            if (status != RX_SUCCESS) {
+                return status;
             }
-        }
 
-        memset(&config_blueprint, 0, sizeof config_blueprint);
+            config->top_count = (rx_size)top_count;
+            continue;
+        }
 
-        if (s_it != RXP_TEST_SUITE_SECTION_END
-            && (*s_it)->config_desc != NULL) {
-            /* Inherit the config from the test suite's description. */
-            (*s_it)->config_desc->update(&config_blueprint);
+        status = rxp_arg_match(
+            &matched, &value, &i, argc, argv, "--top-by", RXP_ARG_REQUIRED);
+        if (status != RX_SUCCESS) {
+            return status;
         }
 
-        if ((*c_it)->config_desc != NULL) {
-            /* Inherit the config from the test case's description. */
-            (*c_it)->config_desc->update(&config_blueprint);
+        if (matched) {
+            if (rxp_usage_metric_parse(&config->top_metric, value)
+                != RX_SUCCESS) {
+                RXP_LOG_ERROR_2("invalid value `%s` for the option `%s`\n",
+                                value,
+                                "--top-by");
+                return RX_ERROR;
+            }
+
+            continue;
         }
 
-        test_case = &test_cases[i];
+        if (strict) {
+            RXP_LOG_ERROR_1("unknown option `%s`\n", argv[i]);
+            return RX_ERROR;
+        }
 
-        test_case->suite_name = (*c_it)->suite_name;
-        test_case->name = (*c_it)->name;
-        test_case->run = (*c_it)->run;
+        if (strncmp(argv[i], "--", 2) == 0) {
+            RXP_LOG_WARNING_1("ignoring the unknown option `%s`\n", argv[i]);
+        }
+    }
 
-        test_case->config.skip = config_blueprint.skip;
+    if (config->longest_first && config->shuffle) {
+        RXP_LOG_ERROR("the options `--longest-first` and `--shuffle` are "
+                      "mutually exclusive\n");
+        return RX_ERROR;
+    }
 
-        memset(&test_case->config.fixture, 0, sizeof test_case->config.fixture);
+    if (config->longest_first && config->timings_path == NULL) {
+        config->timings_path = RXP_DEFAULT_TIMINGS_PATH;
+    }
 
-        if (config_blueprint.fixture != NULL) {
-            test_case->config.fixture.size = config_blueprint.fixture->size;
+    if ((config->failed_first || config->only_failed)
+        && config->failures_path == NULL) {
+        config->failures_path = RXP_DEFAULT_FAILURES_PATH;
+    }
 
-            if (config_blueprint.fixture->update != NULL) {
-                config_blueprint.fixture->update(
-                    &test_case->config.fixture.config);
-            }
-        }
+    if (config->shard_count > 0
+        && config->shard_index >= config->shard_count) {
+        RXP_LOG_ERROR_2("the shard index %lu is out of range (shard count: "
+                        "%lu)\n",
+                        (unsigned long)config->shard_index,
+                        (unsigned long)config->shard_count);
+        return RX_ERROR;
+    }
 
-        ++i;
+    if (config->shard_count == 0
+        && (config->shard_index > 0 || config->shard_manifest_path != NULL)) {
+        RXP_LOG_ERROR("the sharding options require `--shard-count`\n");
+        return RX_ERROR;
     }
 
-    RX_ASSERT(i == *test_case_count);
+    return RX_SUCCESS;
+}
 
-/* Objects that are defined in a custom memory section can only be retrieved
-   in an undefined order, so these need to be manually sorted afterwards
-   in a sensible way. */
-#ifndef RXP_DEBUG_TESTS
-    qsort(test_cases,
-          *test_case_count,
-          sizeof *test_cases,
-          rxp_compare_test_cases);
-#endif
-#endif
+RXP_MAYBE_UNUSED RXP_STORAGE enum rx_status
+rx_run_config_parse(struct rx_run_config *config,
+                    int argc,
+                    const char *const *argv)
+{
+    return rxp_run_config_parse(config, argc, argv, 1);
 }
 
 RXP_MAYBE_UNUSED RXP_STORAGE enum rx_status
 rx_run(rx_size test_case_count, const struct rx_test_case *test_cases)
 {
+    struct rx_run_config config;
+
+    memset(&config, 0, sizeof config);
+    return rx_run_with_config(&config, test_case_count, test_cases);
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE enum rx_status
+rx_run_with_config(const struct rx_run_config *config,
+                   rx_size test_case_count,
+                   const struct rx_test_case *test_cases)
+{
+    RX_ASSERT(config != NULL);
+
+    if (config->bench) {
+        return rx_run_benchmarks(config, 0, NULL);
+    }
+
     if (test_cases != NULL) {
-        return rxp_run_test_cases(test_case_count, test_cases);
+        return rxp_run_test_cases(config, test_case_count, test_cases);
     }
 
     /* If no test cases are explicitly passed, fallback to discovering the
        ones defined through the automatic registration framework. */
-    return rxp_run_registered_test_cases();
+    return rxp_run_registered_test_cases(config);
+}
+
+RXP_MAYBE_UNUSED RXP_STORAGE enum rx_status
+rx_run_benchmarks(const struct rx_run_config *config,
+                  rx_size benchmark_count,
+                  const struct rx_benchmark *benchmarks)
+{
+    enum rx_status status;
+    struct rx_benchmark *registered;
+
+    RX_ASSERT(config != NULL);
+
+    if (benchmarks != NULL) {
+        return rxp_run_benchmarks(config, benchmark_count, benchmarks);
+    }
+
+    /* If no benchmarks are explicitly passed, fallback to discovering the
+       ones defined through the automatic registration framework. */
+    rx_enumerate_benchmarks(&benchmark_count, NULL);
+    if (benchmark_count == 0) {
+        return rxp_run_benchmarks(config, 0, NULL);
+    }
+
+    registered = (struct rx_benchmark *)RX_MALLOC(sizeof *registered
+                                                  * benchmark_count);
+    if (registered == NULL) {
+        RXP_LOG_ERROR("failed to allocate the benchmarks\n");
+        return RX_ERROR_ALLOCATION;
+    }
+
+    rx_enumerate_benchmarks(&benchmark_count, registered);
+    status = rxp_run_benchmarks(config, benchmark_count, registered);
+    RX_FREE(registered);
+    return status;
 }
 
 RXP_MAYBE_UNUSED RXP_STORAGE enum rx_status
@@ -3191,10 +13329,15 @@ rx_main(rx_size test_case_count,
         int argc,
         const char *const *argv)
 {
-    RXP_UNUSED(argc);
-    RXP_UNUSED(argv);
+    enum rx_status status;
+    struct rx_run_config config;
+
+    status = rxp_run_config_parse(&config, argc, argv, 0);
+    if (status != RX_SUCCESS) {
+        return status;
+    }
 
-    return rx_run(test_case_count, test_cases);
+    return rx_run_with_config(&config, test_case_count, test_cases);
 }
 
 /* Assertion Macro Helpers                                         O-(''Q)
@@ -4400,6 +14543,24 @@ rx_main(rx_size test_case_count,
                                   NULL,                                        \
                                   NULL)
 
+#define RX_ALLOC_SCOPE_BEGIN() rxp_alloc_scope_begin(RX_PARAM_CONTEXT)
+
+#define RX_ALLOC_SCOPE_REQUIRE_AT_MOST(COUNT, BYTES)                           \
+    rxp_alloc_scope_assess(RX_PARAM_CONTEXT,                                   \
+                           (rx_uint64)(COUNT),                                 \
+                           (rx_uint64)(BYTES),                                 \
+                           __FILE__,                                           \
+                           __LINE__,                                           \
+                           RX_FATAL)
+
+#define RX_ALLOC_SCOPE_CHECK_AT_MOST(COUNT, BYTES)                             \
+    rxp_alloc_scope_assess(RX_PARAM_CONTEXT,                                   \
+                           (rx_uint64)(COUNT),                                 \
+                           (rx_uint64)(BYTES),                                 \
+                           __FILE__,                                           \
+                           __LINE__,                                           \
+                           RX_NONFATAL)
+
 /* Message Assertion Macros                                        O-(''Q)
    -------------------------------------------------------------------------- */
 
@@ -0,0 +1,43 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+static int reached = 0;
+
+RX_TEST_CASE(my_test_suite, my_untracked_scope)
+{
+    RX_ALLOC_SCOPE_BEGIN();
+    RX_ALLOC_SCOPE_REQUIRE_AT_MOST(0, 0);
+    reached = 1;
+}
+
+int
+main(void)
+{
+    struct rx_test_case test_case;
+    struct rx_summary summary;
+    rx_size test_case_count;
+
+    rx_enumerate_test_cases(&test_case_count, NULL);
+    ASSERT(test_case_count == 1);
+    rx_enumerate_test_cases(&test_case_count, &test_case);
+
+    /* Without the allocations being tracked, the scope can't pass. */
+    ASSERT(rx_summary_initialize(&summary, &test_case) == RX_SUCCESS);
+    ASSERT(rx_test_case_run(&summary, &test_case) == RX_SUCCESS);
+    ASSERT(summary.failure_count == 1);
+    ASSERT(summary.failures[0].severity == RX_FATAL);
+    ASSERT(summary.failures[0].line == 17);
+    ASSERT(strstr(summary.failures[0].msg, "RX_ENABLE_ALLOC_TRACKING") != NULL);
+    ASSERT(!reached);
+    rx_summary_terminate(&summary);
+
+    return 0;
+}
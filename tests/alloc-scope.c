@@ -0,0 +1,89 @@
+#define RX_ENABLE_ALLOC_TRACKING
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+static void *volatile block;
+
+RX_TEST_CASE(my_test_suite, my_allocating_scope)
+{
+    block = malloc(100);
+
+    RX_ALLOC_SCOPE_BEGIN();
+    free(block);
+    block = malloc(64);
+    RX_ALLOC_SCOPE_CHECK_AT_MOST(0, 0);
+
+    RX_ALLOC_SCOPE_BEGIN();
+    free(block);
+    block = malloc(64);
+    RX_ALLOC_SCOPE_CHECK_AT_MOST(1, 64);
+
+    free(block);
+}
+
+RX_TEST_CASE(my_test_suite, my_non_allocating_scope)
+{
+    block = malloc(100);
+
+    RX_ALLOC_SCOPE_BEGIN();
+    memset(block, 0, 100);
+    RX_ALLOC_SCOPE_REQUIRE_AT_MOST(0, 0);
+
+    free(block);
+}
+
+RX_TEST_CASE(my_test_suite, my_unbegun_scope)
+{
+    RX_ALLOC_SCOPE_BEGIN();
+    RX_ALLOC_SCOPE_CHECK_AT_MOST(0, 0);
+
+    /* The previous assertion closed the scope. */
+    RX_ALLOC_SCOPE_CHECK_AT_MOST(0, 0);
+}
+
+static void
+run(const struct rx_test_case *test_case, struct rx_summary *summary)
+{
+    ASSERT(rx_summary_initialize(summary, test_case) == RX_SUCCESS);
+    ASSERT(rx_test_case_run(summary, test_case) == RX_SUCCESS);
+    rx_summary_print(summary);
+}
+
+int
+main(void)
+{
+    rx_size test_case_count;
+    struct rx_test_case test_cases[3];
+    struct rx_summary summary;
+
+    rx_enumerate_test_cases(&test_case_count, NULL);
+    ASSERT(test_case_count == 3);
+    rx_enumerate_test_cases(&test_case_count, test_cases);
+    ASSERT(strcmp(test_cases[0].name, "my_allocating_scope") == 0);
+
+    run(&test_cases[0], &summary);
+    ASSERT(summary.failure_count == 1);
+    ASSERT(summary.failures[0].line == 23);
+    rx_summary_terminate(&summary);
+
+    run(&test_cases[1], &summary);
+    ASSERT(summary.failure_count == 0);
+    rx_summary_terminate(&summary);
+
+    ASSERT(strcmp(test_cases[2].name, "my_unbegun_scope") == 0);
+    run(&test_cases[2], &summary);
+    ASSERT(summary.failure_count == 1);
+    ASSERT(summary.failures[0].line == 50);
+    rx_summary_terminate(&summary);
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+#define RX_ENABLE_ALLOC_TRACKING
+
+#include <malloc.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+static void *volatile block;
+
+RX_TEST_CASE(my_test_suite, my_allocating_test_case)
+{
+    void *other;
+
+    block = malloc(100);
+    other = calloc(10, 10);
+    block = realloc(block, 200);
+    free(other);
+}
+
+RX_TEST_CASE(my_test_suite, my_foreign_test_case)
+{
+    void *aligned;
+
+    /* The block allocated before the test case started is left out. */
+    free(block);
+
+    aligned = memalign(64, 100);
+    RX_PTR_REQUIRE_NOT_EQUAL(aligned, NULL);
+    free(aligned);
+
+    RX_INT_REQUIRE_EQUAL(posix_memalign(&aligned, 64, 100), 0);
+    free(aligned);
+
+    block = valloc(100);
+}
+
+RX_TEST_CASE(my_test_suite, my_failing_test_case)
+{
+    /* Recording the failure allocates, but not on behalf of the test case. */
+    RX_INT_CHECK_EQUAL(1, 2);
+}
+
+static void
+run(const struct rx_test_case *test_case, struct rx_summary *summary)
+{
+    ASSERT(rx_summary_initialize(summary, test_case) == RX_SUCCESS);
+    ASSERT(rx_test_case_run(summary, test_case) == RX_SUCCESS);
+    rx_summary_print(summary);
+}
+
+int
+main(void)
+{
+    rx_size test_case_count;
+    struct rx_test_case test_cases[3];
+    struct rx_summary summary;
+    void *untracked;
+
+    rx_enumerate_test_cases(&test_case_count, NULL);
+    ASSERT(test_case_count == 3);
+    rx_enumerate_test_cases(&test_case_count, test_cases);
+    ASSERT(strcmp(test_cases[0].name, "my_allocating_test_case") == 0);
+
+    run(&test_cases[0], &summary);
+    ASSERT(summary.alloc_stats.available);
+    ASSERT(summary.alloc_stats.allocation_count == 3);
+    ASSERT(summary.alloc_stats.free_count == 2);
+    ASSERT(summary.alloc_stats.allocated_bytes == 400);
+    ASSERT(summary.alloc_stats.peak_bytes >= 300);
+    ASSERT(summary.alloc_stats.live_count == 1);
+    ASSERT(summary.alloc_stats.live_bytes >= 200);
+    ASSERT(summary.alloc_stats.live_bytes < summary.alloc_stats.peak_bytes);
+    rx_summary_terminate(&summary);
+
+    ASSERT(strcmp(test_cases[2].name, "my_foreign_test_case") == 0);
+    run(&test_cases[2], &summary);
+    ASSERT(summary.alloc_stats.available);
+    ASSERT(summary.alloc_stats.allocation_count == 3);
+    ASSERT(summary.alloc_stats.free_count == 2);
+    ASSERT(summary.alloc_stats.allocated_bytes == 300);
+    ASSERT(summary.alloc_stats.peak_bytes >= 100);
+    ASSERT(summary.alloc_stats.live_count == 1);
+    ASSERT(summary.alloc_stats.live_bytes >= 100);
+    rx_summary_terminate(&summary);
+    free(block);
+
+    run(&test_cases[1], &summary);
+    ASSERT(summary.failure_count == 1);
+    ASSERT(summary.alloc_stats.available);
+    ASSERT(summary.alloc_stats.allocation_count == 0);
+    ASSERT(summary.alloc_stats.free_count == 0);
+    rx_summary_terminate(&summary);
+
+    /* Nothing is tracked outside of the test cases. */
+    untracked = malloc(1);
+    ASSERT(untracked != NULL);
+    free(untracked);
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+#define BASELINE_PATH "bench-compare.rexo-baseline"
+
+static volatile unsigned long sink;
+
+RX_BENCHMARK(my_test_suite, my_benchmark)
+{
+    unsigned long i;
+
+    for (i = 0; i < 64; ++i) {
+        sink += i;
+    }
+}
+
+static void
+write_baseline(const char *samples)
+{
+    FILE *file;
+
+    file = fopen(BASELINE_PATH, "w");
+    ASSERT(file != NULL);
+    fprintf(file, "my_test_suite\tmy_benchmark\t%s\n", samples);
+    fclose(file);
+}
+
+int
+main(void)
+{
+    char buf[1024];
+    FILE *file;
+    size_t length;
+    struct rx_run_config config;
+    const char *const argv_1[] = {"bench-compare",
+                                  "--bench-min-time=0.001",
+                                  "--bench-repetitions=5",
+                                  "--bench-save=" BASELINE_PATH};
+    const char *const argv_2[] = {"bench-compare",
+                                  "--bench-min-time=0.001",
+                                  "--bench-repetitions=5",
+                                  "--bench-compare=" BASELINE_PATH,
+                                  "--bench-threshold=1000"};
+    const char *const argv_3[] = {"bench-compare",
+                                  "--bench-min-time=0.001",
+                                  "--bench-repetitions=5",
+                                  "--bench-compare=" BASELINE_PATH};
+
+    ASSERT(rx_run_config_parse(&config, 5, argv_2) == RX_SUCCESS);
+    ASSERT(config.bench);
+    ASSERT(config.bench_save_path == NULL);
+    ASSERT(strcmp(config.bench_compare_path, BASELINE_PATH) == 0);
+    ASSERT(config.bench_threshold > 999.0 && config.bench_threshold < 1001.0);
+
+    remove(BASELINE_PATH);
+
+    /* Comparing against a missing baseline file is an error. */
+    ASSERT(rx_main(0, NULL, 4, argv_3) != RX_SUCCESS);
+
+    /* Save the samples as the baseline. */
+    ASSERT(rx_main(0, NULL, 4, argv_1) == RX_SUCCESS);
+    file = fopen(BASELINE_PATH, "r");
+    ASSERT(file != NULL);
+    length = fread(buf, 1, sizeof buf - 1, file);
+    buf[length] = '\0';
+    fclose(file);
+    ASSERT(strncmp(buf, "my_test_suite\tmy_benchmark\t", 27) == 0);
+    ASSERT(buf[length - 1] == '\n');
+
+    /* Comparing against itself doesn't exceed a generous threshold. */
+    ASSERT(rx_main(0, NULL, 5, argv_2) == RX_SUCCESS);
+
+    /* Being faster than the baseline isn't a regression. */
+    write_baseline("1e12\t1e12\t1e12\t1e12\t1e12");
+    ASSERT(rx_main(0, NULL, 4, argv_3) == RX_SUCCESS);
+
+    /* Being much slower than the baseline is. */
+    write_baseline("1e-6\t1e-6\t1e-6\t1e-6\t1e-6");
+    ASSERT(rx_main(0, NULL, 4, argv_3) == RX_ERROR_ABORTED);
+
+    /* Benchmarks without any baseline are left out of the comparison. */
+    write_baseline("");
+    ASSERT(rx_main(0, NULL, 4, argv_3) == RX_SUCCESS);
+
+    remove(BASELINE_PATH);
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+static volatile unsigned long sink;
+static unsigned long seen_args;
+
+static void
+loop(unsigned long n)
+{
+    unsigned long i;
+
+    for (i = 0; i < n; ++i) {
+        sink += i;
+    }
+}
+
+RX_BENCHMARK(my_test_suite,
+             my_linear_benchmark,
+             .min_time = 0.001,
+             .repetition_count = 3,
+             .range_min = 1,
+             .range_max = 4096,
+             .range_multiplier = 4,
+             .complexity_bound = RX_COMPLEXITY_N_SQUARED)
+{
+    seen_args |= (unsigned long)RX_BENCHMARK_ARG;
+    loop((unsigned long)RX_BENCHMARK_ARG);
+}
+
+static void
+run_linear(RXP_DEFINE_PARAMS(void))
+{
+    loop((unsigned long)RX_BENCHMARK_ARG);
+}
+
+int
+main(void)
+{
+    struct rx_run_config config;
+    struct rx_benchmark benchmark;
+    struct rx_benchmark_summary summary;
+
+    memset(&config, 0, sizeof config);
+    config.bench = 1;
+
+    /* Each argument of the range is run, the last one being its bound. */
+    ASSERT(rx_run_with_config(&config, 0, NULL) == RX_SUCCESS);
+    ASSERT(seen_args == (1ul | 4ul | 16ul | 64ul | 256ul | 1024ul | 4096ul));
+
+    memset(&benchmark, 0, sizeof benchmark);
+    benchmark.suite_name = "my_test_suite";
+    benchmark.name = "my_bounded_benchmark";
+    benchmark.run = run_linear;
+    benchmark.config.min_time = 0.001;
+    benchmark.config.repetition_count = 3;
+    benchmark.config.range_min = 1;
+    benchmark.config.range_max = 4096;
+    benchmark.config.range_multiplier = 8;
+    benchmark.config.complexity_bound = RX_COMPLEXITY_1;
+
+    /* A linear benchmark exceeds a constant bound. */
+    ASSERT(rx_run_benchmarks(&config, 1, &benchmark) == RX_ERROR_ABORTED);
+
+    /* Single runs take their argument from the summary. */
+    ASSERT(rx_benchmark_summary_initialize(&summary, &benchmark)
+           == RX_SUCCESS);
+    summary.arg = 100;
+    ASSERT(rx_benchmark_run(&summary, &benchmark) == RX_SUCCESS);
+    ASSERT(summary.error == NULL);
+    ASSERT(summary.sample_count == 3);
+    rx_benchmark_summary_terminate(&summary);
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+#define JSON_PATH "bench-json.json"
+
+static volatile unsigned long sink;
+
+RX_BENCHMARK(my_test_suite,
+             my_benchmark,
+             .min_time = 0.001,
+             .repetition_count = 3,
+             .range_min = 16,
+             .range_max = 256,
+             .range_multiplier = 16)
+{
+    unsigned long i;
+
+    for (i = 0; i < (unsigned long)RX_BENCHMARK_ARG; ++i) {
+        sink += i;
+    }
+
+    RX_SET_BYTES_PROCESSED(RX_BENCHMARK_ARG);
+    RX_METRIC("my \"metric\"", 1.5);
+}
+
+static char buf[65536];
+
+static size_t
+count_occurrences(const char *s, const char *pattern)
+{
+    size_t count;
+
+    count = 0;
+    while ((s = strstr(s, pattern)) != NULL) {
+        ++count;
+        ++s;
+    }
+
+    return count;
+}
+
+int
+main(void)
+{
+    struct rx_run_config config;
+    FILE *file;
+    size_t length;
+    const char *const argv[] = {"bench-json", "--bench-json=" JSON_PATH};
+
+    ASSERT(rx_run_config_parse(&config, 2, argv) == RX_SUCCESS);
+    ASSERT(config.bench);
+    ASSERT(strcmp(config.bench_json_path, JSON_PATH) == 0);
+
+    remove(JSON_PATH);
+    ASSERT(rx_run_with_config(&config, 0, NULL) == RX_SUCCESS);
+
+    file = fopen(JSON_PATH, "r");
+    ASSERT(file != NULL);
+    length = fread(buf, 1, sizeof buf - 1, file);
+    buf[length] = '\0';
+    fclose(file);
+    remove(JSON_PATH);
+
+    ASSERT(strncmp(buf, "{\n  \"context\": {\n", 17) == 0);
+    ASSERT(strstr(buf, "\"num_cpus\": ") != NULL);
+    ASSERT(strstr(buf, "\"benchmarks\": [") != NULL);
+    ASSERT(length > 7 && strcmp(&buf[length - 7], "\n  ]\n}\n") == 0);
+
+    /* 3 repetitions and 4 aggregates for each of the 2 arguments. */
+    ASSERT(count_occurrences(buf, "\"name\": \"my_test_suite/my_benchmark/16")
+           == 7);
+    ASSERT(count_occurrences(buf, "\"name\": \"my_test_suite/my_benchmark/256")
+           == 7);
+    ASSERT(count_occurrences(buf, "\"run_type\": \"iteration\"") == 6);
+    ASSERT(count_occurrences(buf, "\"aggregate_name\": \"median\"") == 2);
+    ASSERT(count_occurrences(buf, "\"cpu_time\": ") == 14);
+    ASSERT(count_occurrences(buf, "\"time_unit\": \"ns\"") == 15);
+
+    /* The metrics are reported for the runs and the mean and median. */
+    ASSERT(count_occurrences(buf, "\"bytes_per_second\": ") == 10);
+    ASSERT(count_occurrences(buf, "\"my \\\"metric\\\"\": 1.5") == 10);
+
+    /* Followed by the complexity fit. */
+    ASSERT(strstr(buf, "\"name\": \"my_test_suite/my_benchmark_BigO\"")
+           != NULL);
+    ASSERT(strstr(buf, "\"name\": \"my_test_suite/my_benchmark_RMS\"")
+           != NULL);
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+static volatile unsigned long sink;
+static unsigned long call_count;
+
+RX_BENCHMARK(my_test_suite, my_benchmark)
+{
+    unsigned long i;
+
+    ++call_count;
+    for (i = 0; i < 64; ++i) {
+        sink += i;
+    }
+}
+
+/* Retrieve the CPUs that the process is allowed to run on, if known. */
+static void
+get_allowed_cpus(char *buf, size_t size)
+{
+    FILE *file;
+    char line[1024];
+
+    buf[0] = '\0';
+
+    file = fopen("/proc/self/status", "r");
+    if (file == NULL) {
+        return;
+    }
+
+    while (fgets(line, sizeof line, file) != NULL) {
+        if (strncmp(line, "Cpus_allowed_list:", 18) == 0) {
+            strncpy(buf, line, size - 1);
+            buf[size - 1] = '\0';
+            break;
+        }
+    }
+
+    fclose(file);
+}
+
+int
+main(void)
+{
+    char cpus_before[1024];
+    char cpus_after[1024];
+    struct rx_run_config config;
+    const char *const argv_1[] = {"bench-stable",
+                                  "--bench-stable",
+                                  "--bench-min-time=0.001",
+                                  "--bench-repetitions=3",
+                                  "--bench-warm-up=1000000",
+                                  "--bench-max-cv=1000",
+                                  "--bench-max-repetitions=6"};
+    const char *const argv_2[] = {"bench-stable",
+                                  "--bench-stable",
+                                  "--bench-min-time=0.001",
+                                  "--bench-repetitions=3",
+                                  "--bench-max-cv=0.000001",
+                                  "--bench-max-repetitions=6"};
+
+    ASSERT(rx_run_config_parse(&config, 7, argv_1) == RX_SUCCESS);
+    ASSERT(config.bench);
+    ASSERT(config.bench_stable);
+    ASSERT(config.bench_warm_up_count == 1000000);
+    ASSERT(config.bench_max_cv > 999.0 && config.bench_max_cv < 1001.0);
+    ASSERT(config.bench_max_repetition_count == 6);
+
+    get_allowed_cpus(cpus_before, sizeof cpus_before);
+
+    /* The warm-up iterations run on top of the measured ones. */
+    ASSERT(rx_run_with_config(&config, 0, NULL) == RX_SUCCESS);
+    ASSERT(call_count > 1000000);
+
+    /* Benchmarks remaining unstable are flagged but don't fail the run. */
+    ASSERT(rx_main(0, NULL, 6, argv_2) == RX_SUCCESS);
+
+    /* The CPU affinity is restored once the benchmarks have run. */
+    get_allowed_cpus(cpus_after, sizeof cpus_after);
+    ASSERT(strcmp(cpus_before, cpus_after) == 0);
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+static void
+prepare(void)
+{
+    unsigned long i;
+
+    for (i = 0; i < 10000ul; ++i) {
+        RX_DO_NOT_OPTIMIZE(i);
+    }
+}
+
+static void
+run_unpaused(RXP_DEFINE_PARAMS(void))
+{
+    unsigned long value;
+
+    prepare();
+    value = 42;
+    RX_DO_NOT_OPTIMIZE(value);
+}
+
+static void
+run_paused(RXP_DEFINE_PARAMS(void))
+{
+    unsigned long value;
+
+    RX_PAUSE_TIMING();
+    prepare();
+    RX_RESUME_TIMING();
+
+    value = 42;
+    RX_DO_NOT_OPTIMIZE(value);
+    RX_CLOBBER_MEMORY();
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case)
+{
+    int value;
+
+    /* The timing can't be paused outside of the benchmarks. */
+    RX_PAUSE_TIMING();
+    RX_RESUME_TIMING();
+
+    value = 1;
+    RX_DO_NOT_OPTIMIZE(value);
+    RX_INT_REQUIRE_EQUAL(value, 1);
+}
+
+/*
+   The fastest repetition is the one the least disturbed by the other
+   processes running alongside, such as the other tests.
+*/
+static double
+measure(rx_run_fn run)
+{
+    struct rx_benchmark benchmark;
+    struct rx_benchmark_summary summary;
+    double min;
+    rx_size i;
+
+    memset(&benchmark, 0, sizeof benchmark);
+    benchmark.suite_name = "my_test_suite";
+    benchmark.name = "my_benchmark";
+    benchmark.run = run;
+    benchmark.config.min_time = 0.001;
+    benchmark.config.repetition_count = 5;
+
+    ASSERT(rx_benchmark_summary_initialize(&summary, &benchmark)
+           == RX_SUCCESS);
+    ASSERT(rx_benchmark_run(&summary, &benchmark) == RX_SUCCESS);
+    ASSERT(summary.error == NULL);
+    ASSERT(summary.sample_count == 5);
+
+    min = summary.samples[0];
+    for (i = 1; i < summary.sample_count; ++i) {
+        min = summary.samples[i] < min ? summary.samples[i] : min;
+    }
+
+    rx_benchmark_summary_terminate(&summary);
+    return min;
+}
+
+int
+main(int argc, const char **argv)
+{
+    double unpaused;
+    double paused;
+
+    unpaused = measure(run_unpaused);
+    paused = measure(run_paused);
+
+    /* Pausing the timing leaves the preparation out of the measure. */
+    ASSERT(paused * 10.0 < unpaused);
+
+    return rx_main(0, NULL, argc, argv) == RX_SUCCESS ? EXIT_SUCCESS
+                                                      : EXIT_FAILURE;
+}
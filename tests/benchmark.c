@@ -0,0 +1,110 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+static int test_case_run_count = 0;
+static unsigned long iteration_count = 0;
+static int fail = 0;
+
+RX_TEST_CASE(my_test_suite, my_test_case)
+{
+    ++test_case_run_count;
+
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+RX_BENCHMARK(my_test_suite, my_benchmark)
+{
+    ++iteration_count;
+}
+
+RX_BENCHMARK(my_test_suite, my_skipped_benchmark, .skip = 1)
+{
+    ASSERT(0);
+}
+
+static void
+my_failing_benchmark(RXP_DEFINE_PARAMS(void))
+{
+    RX_INT_REQUIRE_EQUAL(fail, 0);
+}
+
+int
+main(void)
+{
+    struct rx_run_config config;
+    struct rx_benchmark benchmark;
+    struct rx_benchmark_summary summary;
+    double min;
+    double max;
+    rx_size i;
+    const char *const argv_1[] = {"benchmark",
+                                  "--bench",
+                                  "--bench-min-time=0.001",
+                                  "--bench-repetitions=3"};
+
+    ASSERT(rx_run_config_parse(&config, 4, argv_1) == RX_SUCCESS);
+    ASSERT(config.bench);
+    ASSERT(config.bench_min_time > 0.0009 && config.bench_min_time < 0.0011);
+    ASSERT(config.bench_repetition_count == 3);
+
+    /* Only the benchmarks are run. */
+    ASSERT(rx_main(0, NULL, 4, argv_1) == RX_SUCCESS);
+    ASSERT(test_case_run_count == 0);
+    ASSERT(iteration_count > 3);
+
+    /* The test cases aren't run alongside the benchmarks. */
+    ASSERT(rx_main(0, NULL, 1, argv_1) == RX_SUCCESS);
+    ASSERT(test_case_run_count == 1);
+
+    memset(&benchmark, 0, sizeof benchmark);
+    benchmark.suite_name = "my_test_suite";
+    benchmark.name = "my_failing_benchmark";
+    benchmark.run = my_failing_benchmark;
+    benchmark.config.min_time = 0.001;
+    benchmark.config.repetition_count = 5;
+
+    ASSERT(rx_benchmark_summary_initialize(&summary, &benchmark)
+           == RX_SUCCESS);
+    ASSERT(rx_benchmark_run(&summary, &benchmark) == RX_SUCCESS);
+    ASSERT(summary.error == NULL);
+    ASSERT(summary.sample_count == 5);
+    ASSERT(summary.iteration_count > 0);
+
+    /* The samples are kept in the order of the repetitions. */
+    min = max = summary.samples[0];
+    for (i = 1; i < summary.sample_count; ++i) {
+        min = summary.samples[i] < min ? summary.samples[i] : min;
+        max = summary.samples[i] > max ? summary.samples[i] : max;
+    }
+
+    ASSERT(min <= summary.median);
+    ASSERT(summary.median <= max);
+    ASSERT(summary.mean > 0.0);
+    rx_benchmark_summary_terminate(&summary);
+
+    /* A failing assessment stops the benchmark. */
+    fail = 1;
+    ASSERT(rx_run_benchmarks(&config, 1, &benchmark) == RX_ERROR_ABORTED);
+
+    ASSERT(rx_benchmark_summary_initialize(&summary, &benchmark)
+           == RX_SUCCESS);
+    ASSERT(rx_benchmark_run(&summary, &benchmark) == RX_SUCCESS);
+    ASSERT(summary.error != NULL);
+    ASSERT(summary.sample_count == 0);
+    ASSERT(summary.failure_count == 1);
+    ASSERT(summary.failures[0].severity == RX_FATAL);
+    ASSERT(summary.failures[0].file != NULL);
+    ASSERT(summary.failures[0].line > 0);
+    rx_benchmark_summary_terminate(&summary);
+    ASSERT(summary.failures == NULL);
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <stdlib.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+static int runs[4];
+
+RX_TEST_CASE(my_test_suite, my_test_case_1)
+{
+    ++runs[0];
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_2)
+{
+    ++runs[1];
+    RX_INT_CHECK_EQUAL(42, 0);
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_3)
+{
+    ++runs[2];
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_4)
+{
+    ++runs[3];
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+int
+main(void)
+{
+    struct rx_run_config config;
+    const char *const argv_1[] = {"fail-fast", "--fail-fast"};
+    const char *const argv_2[] = {"fail-fast"};
+
+    ASSERT(rx_run_config_parse(&config, 2, argv_1) == RX_SUCCESS);
+    ASSERT(config.fail_fast);
+
+    /* No test case is dispatched after the first failure. */
+    ASSERT(rx_main(0, NULL, 2, argv_1) == RX_SUCCESS);
+    ASSERT(runs[0] == 1);
+    ASSERT(runs[1] == 1);
+    ASSERT(runs[2] == 0);
+    ASSERT(runs[3] == 0);
+
+    ASSERT(rx_main(0, NULL, 1, argv_2) == RX_SUCCESS);
+    ASSERT(runs[0] == 2);
+    ASSERT(runs[1] == 2);
+    ASSERT(runs[2] == 1);
+    ASSERT(runs[3] == 1);
+
+    return 0;
+}
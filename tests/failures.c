@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+#define FAILURES_PATH "failures.rexo-failures"
+
+static int fail;
+static int order[3];
+static int run_count;
+
+RX_TEST_CASE(my_test_suite, my_test_case_1)
+{
+    order[run_count++] = 1;
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_2)
+{
+    order[run_count++] = 2;
+    RX_INT_CHECK_EQUAL(fail, 0);
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_3)
+{
+    order[run_count++] = 3;
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+static int
+read_failures(char *buf, size_t size)
+{
+    FILE *file;
+    size_t length;
+
+    file = fopen(FAILURES_PATH, "r");
+    ASSERT(file != NULL);
+    length = fread(buf, 1, size - 1, file);
+    buf[length] = '\0';
+    fclose(file);
+    return (int)length;
+}
+
+int
+main(void)
+{
+    char buf[256];
+    struct rx_run_config config;
+    const char *const argv_1[] = {"failures", "--failures=" FAILURES_PATH};
+    const char *const argv_2[]
+        = {"failures", "--failures=" FAILURES_PATH, "--only-failed"};
+    const char *const argv_3[]
+        = {"failures", "--failures=" FAILURES_PATH, "--failed-first"};
+    const char *const argv_4[] = {"failures", "--only-failed"};
+
+    ASSERT(rx_run_config_parse(&config, 2, argv_4) == RX_SUCCESS);
+    ASSERT(config.only_failed);
+    ASSERT(strcmp(config.failures_path, ".rexo-failures") == 0);
+
+    remove(FAILURES_PATH);
+
+    /* Record the failures. */
+    fail = 1;
+    ASSERT(rx_main(0, NULL, 2, argv_1) == RX_SUCCESS);
+    ASSERT(run_count == 3);
+    read_failures(buf, sizeof buf);
+    ASSERT(strcmp(buf, "my_test_suite\tmy_test_case_2\t1\n") == 0);
+
+    /* Only run the failing test case, which still fails. */
+    run_count = 0;
+    ASSERT(rx_main(0, NULL, 3, argv_2) == RX_SUCCESS);
+    ASSERT(run_count == 1);
+    ASSERT(order[0] == 2);
+    read_failures(buf, sizeof buf);
+    ASSERT(strcmp(buf, "my_test_suite\tmy_test_case_2\t2\n") == 0);
+
+    /* Run the failing test case first, which now passes. */
+    fail = 0;
+    run_count = 0;
+    ASSERT(rx_main(0, NULL, 3, argv_3) == RX_SUCCESS);
+    ASSERT(run_count == 3);
+    ASSERT(order[0] == 2);
+    ASSERT(order[1] == 1);
+    ASSERT(order[2] == 3);
+    ASSERT(read_failures(buf, sizeof buf) == 0);
+
+    /* Run everything when nothing failed. */
+    run_count = 0;
+    ASSERT(rx_main(0, NULL, 3, argv_2) == RX_SUCCESS);
+    ASSERT(run_count == 3);
+
+    remove(FAILURES_PATH);
+    return 0;
+}
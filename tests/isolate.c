@@ -0,0 +1,127 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+static int fds[2];
+
+RX_TEST_CASE(my_test_suite, my_test_case_1)
+{
+    /* Crash the worker process. */
+    abort();
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_2)
+{
+    char c;
+
+    c = 'x';
+    ASSERT(write(fds[1], &c, 1) == 1);
+
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_3)
+{
+    char c;
+
+    c = 'y';
+    ASSERT(write(fds[1], &c, 1) == 1);
+
+    /* The histograms are sent back along with the summary. */
+    RX_INT_CHECK_EQUAL(RX_RECORD_LATENCY("my_latency", 1000), RX_SUCCESS);
+    RX_INT_CHECK_EQUAL(42, 42);
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_4)
+{
+    RX_INT_CHECK_EQUAL(1, 2);
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_5)
+{
+    RX_INT_REQUIRE_EQUAL(1, 2);
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_6)
+{
+    char c;
+
+    c = 'z';
+    ASSERT(write(fds[1], &c, 1) == 1);
+}
+
+static void
+find_test_case(struct rx_test_case *test_case, const char *name)
+{
+    rx_size test_case_count;
+    struct rx_test_case test_cases[6];
+    rx_size i;
+
+    rx_enumerate_test_cases(&test_case_count, NULL);
+    ASSERT(test_case_count == 6);
+    rx_enumerate_test_cases(&test_case_count, test_cases);
+
+    for (i = 0; i < test_case_count; ++i) {
+        if (strcmp(test_cases[i].name, name) == 0) {
+            *test_case = test_cases[i];
+            return;
+        }
+    }
+
+    ASSERT(0);
+}
+
+int
+main(void)
+{
+    char buf[3];
+    struct pollfd poll_fd;
+    struct rx_test_case test_cases[2];
+    const char *const argv_1[] = {"isolate", "--isolate"};
+    const char *const argv_2[] = {"isolate", "--isolate", "--jobs", "2"};
+    const char *const argv_3[] = {"isolate", "--isolate", "--fail-fast"};
+
+    find_test_case(&test_cases[1], "my_test_case_6");
+
+    ASSERT(pipe(fds) == 0);
+
+    /* The crash is reported as a fatal failure without stopping the run. */
+    ASSERT(rx_main(0, NULL, 2, argv_1) == RX_ERROR_ABORTED);
+    ASSERT(read(fds[0], buf, 3) == 3);
+    ASSERT(buf[0] == 'x');
+    ASSERT(buf[1] == 'y');
+    ASSERT(buf[2] == 'z');
+
+    ASSERT(rx_main(0, NULL, 4, argv_2) == RX_ERROR_ABORTED);
+    ASSERT(read(fds[0], buf, 3) == 3);
+
+    /* The failures are sent back, and the next test case still runs. */
+    find_test_case(&test_cases[0], "my_test_case_5");
+    ASSERT(rx_main(2, test_cases, 2, argv_1) == RX_ERROR_ABORTED);
+    ASSERT(read(fds[0], buf, 1) == 1);
+    ASSERT(buf[0] == 'z');
+
+    find_test_case(&test_cases[0], "my_test_case_4");
+    ASSERT(rx_main(2, test_cases, 2, argv_1) == RX_SUCCESS);
+    ASSERT(read(fds[0], buf, 1) == 1);
+    ASSERT(buf[0] == 'z');
+
+    /* A non-fatal failure is enough to stop the run when failing fast. */
+    ASSERT(rx_main(2, test_cases, 3, argv_3) == RX_SUCCESS);
+    poll_fd.fd = fds[0];
+    poll_fd.events = POLLIN;
+    ASSERT(poll(&poll_fd, 1, 0) == 0);
+
+    /* Nothing runs after the crash when failing fast. */
+    ASSERT(rx_main(0, NULL, 3, argv_3) == RX_ERROR_ABORTED);
+    ASSERT(poll(&poll_fd, 1, 0) == 0);
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+#define ASSERT_NEAR(x, expected)                                               \
+    ASSERT((double)(x) >= (double)(expected) * 0.99                            \
+           && (double)(x) <= (double)(expected) * 1.01)
+
+static const char *const names[] = {
+    "requests",
+    "small",
+    "h2",
+    "h3",
+    "h4",
+};
+
+RX_TEST_CASE(my_test_suite, my_test_case)
+{
+    rx_uint64 i;
+
+    /* Shuffle the values a bit, the order doesn't matter. */
+    for (i = 1; i <= 1000; ++i) {
+        RX_INT_REQUIRE_EQUAL(
+            RX_RECORD_LATENCY(names[0], ((i * 7) % 1000 + 1) * 1000),
+            RX_SUCCESS);
+    }
+
+    for (i = 0; i < 100; ++i) {
+        RX_INT_REQUIRE_EQUAL(RX_RECORD_LATENCY(names[1], i), RX_SUCCESS);
+    }
+
+    RX_INT_REQUIRE_EQUAL(RX_RECORD_LATENCY(names[2], 0), RX_SUCCESS);
+    RX_INT_REQUIRE_EQUAL(RX_RECORD_LATENCY(names[3], (rx_uint64)-1),
+                         RX_SUCCESS);
+    RX_INT_REQUIRE_EQUAL(RX_RECORD_LATENCY(names[4], 1),
+                         RX_ERROR_MAX_SIZE_EXCEEDED);
+}
+
+int
+main(void)
+{
+    rx_size test_case_count;
+    struct rx_test_case test_case;
+    struct rx_summary summary;
+    const struct rx_latency_histogram *histogram;
+
+    rx_enumerate_test_cases(&test_case_count, NULL);
+    ASSERT(test_case_count == 1);
+    rx_enumerate_test_cases(&test_case_count, &test_case);
+
+    ASSERT(rx_summary_initialize(&summary, &test_case) == RX_SUCCESS);
+    ASSERT(rx_test_case_run(&summary, &test_case) == RX_SUCCESS);
+    ASSERT(summary.failure_count == 0);
+    ASSERT(summary.latencies.count == 4);
+
+    histogram = &summary.latencies.values[0];
+    ASSERT(strcmp(histogram->name, "requests") == 0);
+    ASSERT(histogram->count == 1000);
+    ASSERT(histogram->min == 1000);
+    ASSERT(histogram->max == 1000000);
+    ASSERT_NEAR(rx_latency_histogram_get_percentile(histogram, 50.0), 500000);
+    ASSERT_NEAR(rx_latency_histogram_get_percentile(histogram, 90.0), 900000);
+    ASSERT_NEAR(rx_latency_histogram_get_percentile(histogram, 99.0), 990000);
+    ASSERT_NEAR(rx_latency_histogram_get_percentile(histogram, 99.9), 999000);
+    ASSERT(rx_latency_histogram_get_percentile(histogram, 100.0) == 1000000);
+    ASSERT_NEAR(rx_latency_histogram_get_percentile(histogram, 0.0), 1000);
+
+    /* Small values are recorded exactly. */
+    histogram = &summary.latencies.values[1];
+    ASSERT(histogram->count == 100);
+    ASSERT(rx_latency_histogram_get_percentile(histogram, 50.0) == 49);
+    ASSERT(rx_latency_histogram_get_percentile(histogram, 99.0) == 98);
+
+    histogram = &summary.latencies.values[2];
+    ASSERT(rx_latency_histogram_get_percentile(histogram, 50.0) == 0);
+
+    /* Values out of range are counted in the last bucket. */
+    histogram = &summary.latencies.values[3];
+    ASSERT(histogram->max == (rx_uint64)-1);
+    ASSERT(rx_latency_histogram_get_percentile(histogram, 50.0)
+           == (rx_uint64)-1);
+
+    rx_summary_print(&summary);
+    rx_summary_terminate(&summary);
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+static const char *const names[] = {
+    "m0", "m1", "m2", "m3", "m4", "m5", "m6", "m7", "m8",
+};
+
+RX_TEST_CASE(my_test_suite, my_test_case)
+{
+    size_t i;
+
+    RX_SET_BYTES_PROCESSED(1024);
+    RX_SET_ITEMS_PROCESSED(16);
+    RX_SET_ITEMS_PROCESSED(32);
+
+    for (i = 0; i < sizeof names / sizeof *names - 1; ++i) {
+        RX_INT_REQUIRE_EQUAL(RX_METRIC(names[i], 1.0), RX_SUCCESS);
+    }
+
+    /* Setting a metric again overwrites it. */
+    RX_INT_REQUIRE_EQUAL(RX_METRIC(names[0], 2.0), RX_SUCCESS);
+
+    RX_INT_REQUIRE_EQUAL(RX_METRIC(names[i], 1.0),
+                         RX_ERROR_MAX_SIZE_EXCEEDED);
+}
+
+static void
+run(RXP_DEFINE_PARAMS(void))
+{
+    static char src[4096];
+    static char dst[4096];
+
+    memcpy(dst, src, sizeof dst);
+    RX_CLOBBER_MEMORY();
+
+    RX_SET_BYTES_PROCESSED(sizeof dst);
+    RX_METRIC("copies", 1.0);
+}
+
+int
+main(void)
+{
+    rx_size test_case_count;
+    struct rx_test_case test_case;
+    struct rx_summary summary;
+    struct rx_benchmark benchmark;
+    struct rx_benchmark_summary benchmark_summary;
+
+    rx_enumerate_test_cases(&test_case_count, NULL);
+    ASSERT(test_case_count == 1);
+    rx_enumerate_test_cases(&test_case_count, &test_case);
+
+    ASSERT(rx_summary_initialize(&summary, &test_case) == RX_SUCCESS);
+    ASSERT(rx_test_case_run(&summary, &test_case) == RX_SUCCESS);
+    ASSERT(summary.failure_count == 0);
+    ASSERT(summary.metrics.bytes_processed == 1024);
+    ASSERT(summary.metrics.items_processed == 32);
+    ASSERT(summary.metrics.count == sizeof names / sizeof *names - 1);
+    ASSERT(strcmp(summary.metrics.values[0].name, "m0") == 0);
+    ASSERT(summary.metrics.values[0].value > 1.5);
+    rx_summary_print(&summary);
+    rx_summary_terminate(&summary);
+
+    memset(&benchmark, 0, sizeof benchmark);
+    benchmark.suite_name = "my_test_suite";
+    benchmark.name = "my_benchmark";
+    benchmark.run = run;
+    benchmark.config.min_time = 0.001;
+    benchmark.config.repetition_count = 3;
+
+    /* The metrics of the benchmarks are set for each iteration. */
+    ASSERT(rx_benchmark_summary_initialize(&benchmark_summary, &benchmark)
+           == RX_SUCCESS);
+    ASSERT(rx_benchmark_run(&benchmark_summary, &benchmark) == RX_SUCCESS);
+    ASSERT(benchmark_summary.error == NULL);
+    ASSERT(benchmark_summary.metrics.bytes_processed == 4096);
+    ASSERT(benchmark_summary.metrics.items_processed == 0);
+    ASSERT(benchmark_summary.metrics.count == 1);
+    ASSERT(strcmp(benchmark_summary.metrics.values[0].name, "copies") == 0);
+    rx_benchmark_summary_print(&benchmark_summary);
+    rx_benchmark_summary_terminate(&benchmark_summary);
+
+    return 0;
+}
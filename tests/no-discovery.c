@@ -30,7 +30,7 @@ static const struct rx_test_case my_test_cases[] = {
         "my_test_suite",
         "my_test_case_2",
         my_test_suite_my_test_case_2,
-        {0, {0, {NULL, NULL}}},
+        {0, {0, {NULL, NULL}}, 0, {0, {NULL, NULL}}},
     },
 };
 
@@ -0,0 +1,52 @@
+#include <stdlib.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+static volatile unsigned long sink;
+
+RX_TEST_CASE(my_test_suite, my_test_case)
+{
+    unsigned long i;
+
+    for (i = 0; i < 100000; ++i) {
+        sink += i;
+    }
+
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+int
+main(void)
+{
+    struct rx_run_config config;
+    rx_size test_case_count;
+    struct rx_test_case test_case;
+    struct rx_summary summary;
+    const char *const argv_1[] = {"perf-counters", "--perf-counters"};
+    const char *const argv_2[]
+        = {"perf-counters", "--perf-counters", "--jobs=2"};
+
+    ASSERT(rx_run_config_parse(&config, 2, argv_1) == RX_SUCCESS);
+    ASSERT(config.perf_counters);
+
+    /* The run carries on whether the counters are available or not. */
+    ASSERT(rx_main(0, NULL, 2, argv_1) == RX_SUCCESS);
+    ASSERT(rx_main(0, NULL, 3, argv_2) == RX_SUCCESS);
+
+    /* Single test cases run without any counters. */
+    rx_enumerate_test_cases(&test_case_count, NULL);
+    ASSERT(test_case_count == 1);
+    rx_enumerate_test_cases(&test_case_count, &test_case);
+    ASSERT(rx_summary_initialize(&summary, &test_case) == RX_SUCCESS);
+    ASSERT(rx_test_case_run(&summary, &test_case) == RX_SUCCESS);
+    ASSERT(!summary.perf_counters.available);
+    rx_summary_terminate(&summary);
+
+    return 0;
+}
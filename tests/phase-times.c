@@ -0,0 +1,79 @@
+#include <stdlib.h>
+#include <time.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+#define MS 1000000ul
+
+static volatile unsigned long sink;
+
+RX_SET_UP(my_set_up)
+{
+    unsigned long i;
+
+    for (i = 0; i < 10000000; ++i) {
+        sink += i;
+    }
+
+    return RX_SUCCESS;
+}
+
+RX_TEAR_DOWN(my_tear_down)
+{
+    ++sink;
+}
+
+RX_VOID_FIXTURE(my_fixture, .set_up = my_set_up, .tear_down = my_tear_down);
+
+RX_TEST_CASE(my_test_suite, my_test_case, .fixture = my_fixture)
+{
+    struct timespec duration;
+
+    /* Block without using the CPU. */
+    duration.tv_sec = 0;
+    duration.tv_nsec = 50 * MS;
+    nanosleep(&duration, NULL);
+}
+
+int
+main(void)
+{
+    rx_size test_case_count;
+    struct rx_test_case test_case;
+    struct rx_summary summary;
+
+    ASSERT(rx_main(0, NULL, 0, NULL) == RX_SUCCESS);
+
+    rx_enumerate_test_cases(&test_case_count, NULL);
+    ASSERT(test_case_count == 1);
+    rx_enumerate_test_cases(&test_case_count, &test_case);
+
+    ASSERT(rx_summary_initialize(&summary, &test_case) == RX_SUCCESS);
+    ASSERT(rx_test_case_run(&summary, &test_case) == RX_SUCCESS);
+    ASSERT(summary.wall_time.set_up_available);
+    ASSERT(summary.wall_time.run_available);
+    ASSERT(summary.wall_time.tear_down_available);
+    ASSERT(summary.cpu_time.set_up_available);
+    ASSERT(summary.cpu_time.run_available);
+    ASSERT(summary.cpu_time.tear_down_available);
+    ASSERT(summary.elapsed == summary.wall_time.run);
+
+    /* The set-up is CPU-bound. */
+    ASSERT(summary.cpu_time.set_up > 0);
+    ASSERT(summary.wall_time.set_up > 0);
+
+    /* The run is mostly spent blocked. */
+    ASSERT(summary.wall_time.run >= 50 * MS);
+    ASSERT(summary.cpu_time.run < summary.wall_time.run / 2);
+
+    ASSERT(summary.wall_time.tear_down < summary.wall_time.run);
+    rx_summary_terminate(&summary);
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+#define PROFILE_PATH "./my_test_suite.my_test_case.folded"
+
+static volatile unsigned long sink;
+
+RX_TEST_CASE(my_test_suite, my_test_case)
+{
+    unsigned long i;
+
+    /* Spend enough CPU time to be sampled a few times. */
+    for (i = 0; i < 100000000; ++i) {
+        sink += i;
+    }
+}
+
+/* Each line lists the frames separated by semicolons, then a count. */
+static unsigned long
+read_sample_count(FILE *file)
+{
+    char line[4096];
+    unsigned long total;
+
+    total = 0;
+    while (fgets(line, sizeof line, file) != NULL) {
+        const char *count;
+
+        ASSERT(strchr(line, '\n') != NULL);
+        count = strrchr(line, ' ');
+        ASSERT(count != NULL);
+        ASSERT(count > line);
+        ASSERT(strtoul(count + 1, NULL, 10) > 0);
+        total += strtoul(count + 1, NULL, 10);
+    }
+
+    return total;
+}
+
+int
+main(void)
+{
+    struct rx_run_config config;
+    FILE *file;
+    const char *const argv_1[] = {"profile", "--profile"};
+    const char *const argv_2[] = {"profile", "--profile=."};
+
+    ASSERT(rx_run_config_parse(&config, 2, argv_1) == RX_SUCCESS);
+    ASSERT(strcmp(config.profile_path, ".") == 0);
+
+    remove(PROFILE_PATH);
+
+    /* The run carries on whether the profiler is available or not. */
+    ASSERT(rx_main(0, NULL, 2, argv_2) == RX_SUCCESS);
+
+    file = fopen(PROFILE_PATH, "r");
+#if defined(__linux__) && defined(__GLIBC__) && defined(__GNUC__)
+    ASSERT(file != NULL);
+#endif
+    if (file != NULL) {
+        ASSERT(read_sample_count(file) > 0);
+        fclose(file);
+        remove(PROFILE_PATH);
+    }
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+static int runs[2];
+
+RX_TEST_CASE(my_test_suite, my_test_case_1)
+{
+    ++runs[0];
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_2)
+{
+    /* Fail every third run. */
+    ++runs[1];
+    RX_INT_CHECK_NOT_EQUAL(runs[1] % 3, 0);
+}
+
+int
+main(void)
+{
+    struct rx_run_config config;
+    struct rx_test_case test_cases[2];
+    struct rx_repetition_summary summary;
+    rx_size test_case_count;
+    const char *const argv_1[] = {"repeat", "--repeat", "10"};
+    const char *const argv_2[] = {"repeat", "--until-fail"};
+    const char *const argv_3[] = {"repeat", "--until-fail", "--repeat=2"};
+    const char *const argv_4[] = {"repeat", "--repeat=abc"};
+
+    ASSERT(rx_run_config_parse(&config, 3, argv_1) == RX_SUCCESS);
+    ASSERT(config.repeat_count == 10);
+    ASSERT(!config.until_fail);
+
+    ASSERT(rx_run_config_parse(&config, 2, argv_4) == RX_ERROR);
+
+    ASSERT(rx_main(0, NULL, 3, argv_1) == RX_SUCCESS);
+    ASSERT(runs[0] == 10);
+    ASSERT(runs[1] == 10);
+
+    /* Stop at the first failure. */
+    memset(runs, 0, sizeof runs);
+    ASSERT(rx_main(0, NULL, 2, argv_2) == RX_SUCCESS);
+    ASSERT(runs[0] == 3);
+    ASSERT(runs[1] == 3);
+
+    memset(runs, 0, sizeof runs);
+    ASSERT(rx_main(0, NULL, 3, argv_3) == RX_SUCCESS);
+    ASSERT(runs[0] == 2);
+    ASSERT(runs[1] == 2);
+
+    /* A test case without any run is neither passed nor failed. */
+    rx_enumerate_test_cases(&test_case_count, NULL);
+    ASSERT(test_case_count == 2);
+    rx_enumerate_test_cases(&test_case_count, test_cases);
+    memset(&summary, 0, sizeof summary);
+    summary.test_case = &test_cases[0];
+    rx_repetition_summary_print(&summary);
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+#define BUFFER_SIZE (32 * 1024 * 1024)
+
+static volatile unsigned long sink;
+
+RX_TEST_CASE(my_test_suite, my_allocating_test_case)
+{
+    char *buffer;
+
+    buffer = (char *)malloc(BUFFER_SIZE);
+    RX_REQUIRE(buffer != NULL);
+
+    /* Touch every page so that they count towards the resident set. */
+    memset(buffer, 1, BUFFER_SIZE);
+    sink += (unsigned long)buffer[BUFFER_SIZE - 1];
+    free(buffer);
+}
+
+RX_TEST_CASE(my_test_suite, my_spinning_test_case)
+{
+    unsigned long i;
+
+    for (i = 0; i < 10000000; ++i) {
+        sink += i;
+    }
+}
+
+int
+main(void)
+{
+    rx_size test_case_count;
+    struct rx_test_case test_cases[2];
+    struct rx_summary summary;
+    struct rx_run_config config;
+    const char *const argv_1[] = {"resource-usage", "--top=1"};
+    const char *const argv_2[]
+        = {"resource-usage", "--top=5", "--top-by=max-rss"};
+    const char *const argv_3[] = {"resource-usage", "--top-by=disk"};
+
+    ASSERT(rx_run_config_parse(&config, 2, argv_1) == RX_SUCCESS);
+    ASSERT(config.top_count == 1);
+    ASSERT(config.top_metric == RX_USAGE_CPU_TIME);
+
+    ASSERT(rx_run_config_parse(&config, 3, argv_2) == RX_SUCCESS);
+    ASSERT(config.top_count == 5);
+    ASSERT(config.top_metric == RX_USAGE_MAX_RSS_GROWTH);
+
+    ASSERT(rx_run_config_parse(&config, 2, argv_3) != RX_SUCCESS);
+
+    ASSERT(rx_main(0, NULL, 2, argv_1) == RX_SUCCESS);
+    ASSERT(rx_main(0, NULL, 3, argv_2) == RX_SUCCESS);
+
+    rx_enumerate_test_cases(&test_case_count, NULL);
+    ASSERT(test_case_count == 2);
+    rx_enumerate_test_cases(&test_case_count, test_cases);
+
+    ASSERT(strcmp(test_cases[0].name, "my_allocating_test_case") == 0);
+    ASSERT(rx_summary_initialize(&summary, &test_cases[0]) == RX_SUCCESS);
+    ASSERT(rx_test_case_run(&summary, &test_cases[0]) == RX_SUCCESS);
+    ASSERT(summary.resource_usage.available);
+    ASSERT(summary.resource_usage.minor_faults > 0);
+    rx_summary_terminate(&summary);
+
+    ASSERT(strcmp(test_cases[1].name, "my_spinning_test_case") == 0);
+    ASSERT(rx_summary_initialize(&summary, &test_cases[1]) == RX_SUCCESS);
+    ASSERT(rx_test_case_run(&summary, &test_cases[1]) == RX_SUCCESS);
+    ASSERT(summary.resource_usage.available);
+    ASSERT(summary.resource_usage.user_time
+               + summary.resource_usage.system_time
+           > 0);
+    rx_summary_terminate(&summary);
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+#define TIMINGS_PATH "shard.rexo-timings"
+#define MANIFEST_PATH "shard.manifest"
+
+static int runs[4];
+
+RX_TEST_CASE(my_test_suite, my_test_case_1)
+{
+    ++runs[0];
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_2)
+{
+    ++runs[1];
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_3)
+{
+    ++runs[2];
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_4)
+{
+    ++runs[3];
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+static int
+count_manifest_entries(unsigned long shard)
+{
+    FILE *file;
+    char line[256];
+    char prefix[32];
+    int out;
+
+    sprintf(prefix, "%lu\t", shard);
+
+    file = fopen(MANIFEST_PATH, "r");
+    ASSERT(file != NULL);
+
+    out = 0;
+    while (fgets(line, sizeof line, file) != NULL) {
+        if (strncmp(line, prefix, strlen(prefix)) == 0) {
+            ++out;
+        }
+    }
+
+    fclose(file);
+    return out;
+}
+
+int
+main(void)
+{
+    int i;
+    FILE *file;
+    struct rx_run_config config;
+    const char *const argv_1[]
+        = {"shard", "--shard-index=1", "--shard-count=2"};
+    const char *const argv_2[]
+        = {"shard", "--shard-index=2", "--shard-count=2"};
+    const char *const argv_3[] = {"shard", "--shard-index=1"};
+    const char *const argv_4[]
+        = {"shard", "--shard-count=3", "--shard-manifest=" MANIFEST_PATH};
+    const char *const argv_5[] = {"shard",
+                                  "--shard-index=0",
+                                  "--shard-count=2",
+                                  "--timings=" TIMINGS_PATH};
+
+    ASSERT(rx_run_config_parse(&config, 3, argv_1) == RX_SUCCESS);
+    ASSERT(config.shard_index == 1);
+    ASSERT(config.shard_count == 2);
+
+    ASSERT(rx_run_config_parse(&config, 3, argv_2) == RX_ERROR);
+    ASSERT(rx_run_config_parse(&config, 2, argv_3) == RX_ERROR);
+
+    /* Without any timings, each test case runs in exactly one shard. */
+    ASSERT(rx_run_config_parse(&config, 3, argv_4) == RX_SUCCESS);
+
+    for (i = 0; i < 3; ++i) {
+        int total;
+
+        memset(runs, 0, sizeof runs);
+        config.shard_index = (rx_size)i;
+        ASSERT(rx_run_with_config(&config, 0, NULL) == RX_SUCCESS);
+
+        total = runs[0] + runs[1] + runs[2] + runs[3];
+        ASSERT(total == count_manifest_entries((unsigned long)i));
+    }
+
+    ASSERT(count_manifest_entries(0) + count_manifest_entries(1)
+               + count_manifest_entries(2)
+           == 4);
+
+    /* With timings, the shards are balanced by duration. */
+    file = fopen(TIMINGS_PATH, "w");
+    ASSERT(file != NULL);
+    fputs("my_test_suite\tmy_test_case_1\t400\n", file);
+    fputs("my_test_suite\tmy_test_case_2\t300\n", file);
+    fputs("my_test_suite\tmy_test_case_3\t200\n", file);
+    fputs("my_test_suite\tmy_test_case_4\t100\n", file);
+    fclose(file);
+
+    memset(runs, 0, sizeof runs);
+    ASSERT(rx_main(0, NULL, 4, argv_5) == RX_SUCCESS);
+    ASSERT(runs[0] == 1);
+    ASSERT(runs[1] == 0);
+    ASSERT(runs[2] == 0);
+    ASSERT(runs[3] == 1);
+
+    remove(TIMINGS_PATH);
+    remove(MANIFEST_PATH);
+    return 0;
+}
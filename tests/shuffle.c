@@ -0,0 +1,69 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+static int order[8];
+static int run_count;
+
+#define DEFINE_TEST_CASE(ID)                                                   \
+    RX_TEST_CASE(my_test_suite, my_test_case_##ID)                             \
+    {                                                                          \
+        order[run_count++] = ID;                                               \
+        RX_INT_REQUIRE_EQUAL(42, 42);                                          \
+    }
+
+DEFINE_TEST_CASE(0)
+DEFINE_TEST_CASE(1)
+DEFINE_TEST_CASE(2)
+DEFINE_TEST_CASE(3)
+DEFINE_TEST_CASE(4)
+DEFINE_TEST_CASE(5)
+DEFINE_TEST_CASE(6)
+DEFINE_TEST_CASE(7)
+
+int
+main(void)
+{
+    int i;
+    int shuffled;
+    int first_order[8];
+    struct rx_run_config config;
+    const char *const argv_1[] = {"shuffle", "--shuffle=42"};
+    const char *const argv_2[] = {"shuffle", "--shuffle"};
+    const char *const argv_3[] = {"shuffle", "--shuffle", "--longest-first"};
+
+    ASSERT(rx_run_config_parse(&config, 2, argv_1) == RX_SUCCESS);
+    ASSERT(config.shuffle);
+    ASSERT(config.shuffle_seed == 42);
+
+    ASSERT(rx_run_config_parse(&config, 2, argv_2) == RX_SUCCESS);
+    ASSERT(config.shuffle);
+
+    ASSERT(rx_run_config_parse(&config, 3, argv_3) == RX_ERROR);
+
+    ASSERT(rx_main(0, NULL, 2, argv_1) == RX_SUCCESS);
+    ASSERT(run_count == 8);
+    memcpy(first_order, order, sizeof order);
+
+    shuffled = 0;
+    for (i = 0; i < 8; ++i) {
+        shuffled |= order[i] != i;
+    }
+
+    ASSERT(shuffled);
+
+    /* The same seed replays the same order. */
+    run_count = 0;
+    ASSERT(rx_main(0, NULL, 2, argv_1) == RX_SUCCESS);
+    ASSERT(run_count == 8);
+    ASSERT(memcmp(first_order, order, sizeof order) == 0);
+
+    return 0;
+}
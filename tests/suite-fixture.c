@@ -0,0 +1,156 @@
+#include <stdlib.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+static int set_up_count = 0;
+static int tear_down_count = 0;
+static int run_count = 0;
+static int serial = 1;
+static int expected_set_up_count = 1;
+
+struct my_suite_data {
+    int value;
+};
+
+struct my_data {
+    int value;
+};
+
+RX_SET_UP(my_suite_set_up)
+{
+    struct my_suite_data *data;
+
+    data = (struct my_suite_data *)RX_DATA;
+
+    ++set_up_count;
+    data->value = 123;
+
+    /* Assessments report to a summary of their own. */
+    RX_INT_REQUIRE_EQUAL(data->value, 123);
+    return RX_SUCCESS;
+}
+
+RX_TEAR_DOWN(my_suite_tear_down)
+{
+    struct my_suite_data *data;
+
+    data = (struct my_suite_data *)RX_DATA;
+
+    ++tear_down_count;
+    ASSERT(data->value == 123);
+    RX_INT_CHECK_EQUAL(data->value, 123);
+}
+
+RX_FIXTURE(my_suite_fixture,
+           struct my_suite_data,
+           .set_up = my_suite_set_up,
+           .tear_down = my_suite_tear_down);
+
+RX_SET_UP(my_set_up)
+{
+    const struct my_suite_data *suite_data;
+    struct my_data *data;
+
+    suite_data = (const struct my_suite_data *)RX_SUITE_DATA;
+    data = (struct my_data *)RX_DATA;
+
+    ASSERT(suite_data != NULL);
+    data->value = suite_data->value + 1;
+    return RX_SUCCESS;
+}
+
+RX_FIXTURE(my_fixture, struct my_data, .set_up = my_set_up);
+
+RX_TEST_SUITE(my_test_suite, .suite_fixture = my_suite_fixture);
+
+static void
+check_suite_data(const struct my_suite_data *data)
+{
+    ASSERT(data != NULL);
+    ASSERT(data->value == 123);
+
+    if (serial) {
+        ++run_count;
+        ASSERT(set_up_count == expected_set_up_count);
+        ASSERT(tear_down_count == expected_set_up_count - 1);
+    }
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_1)
+{
+    check_suite_data((const struct my_suite_data *)RX_SUITE_DATA);
+
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_2, .fixture = my_fixture)
+{
+    struct my_data *data;
+
+    data = (struct my_data *)RX_DATA;
+
+    check_suite_data((const struct my_suite_data *)RX_SUITE_DATA);
+    ASSERT(data->value == 124);
+
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_3)
+{
+    check_suite_data((const struct my_suite_data *)RX_SUITE_DATA);
+
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_4, .skip = 1)
+{
+    ASSERT(0);
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_5, .suite_fixture = NULL)
+{
+    ASSERT(RX_SUITE_DATA == NULL);
+
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+RX_TEST_CASE(my_other_test_suite, my_test_case)
+{
+    ASSERT(RX_SUITE_DATA == NULL);
+
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+int
+main(void)
+{
+    const char *const argv_1[] = {"suite-fixture"};
+    const char *const argv_2[] = {"suite-fixture", "--jobs=4"};
+    const char *const argv_3[] = {"suite-fixture", "--shuffle=42"};
+
+    ASSERT(rx_main(0, NULL, 1, argv_1) == RX_SUCCESS);
+    ASSERT(run_count == 3);
+    ASSERT(set_up_count == 1);
+    ASSERT(tear_down_count == 1);
+
+    serial = 0;
+    ASSERT(rx_main(0, NULL, 2, argv_2) == RX_SUCCESS);
+    ASSERT(set_up_count == 2);
+    ASSERT(tear_down_count == 2);
+
+    serial = 1;
+    run_count = 0;
+    expected_set_up_count = 3;
+    ASSERT(rx_main(0, NULL, 2, argv_3) == RX_SUCCESS);
+    ASSERT(run_count == 3);
+    ASSERT(set_up_count == 3);
+    ASSERT(tear_down_count == 3);
+
+    return 0;
+}
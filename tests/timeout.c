@@ -0,0 +1,103 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#include <sys/wait.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+static volatile int stop;
+static int fds[2];
+
+RX_TEST_SUITE(my_test_suite, .timeout = 0.2);
+
+RX_TEST_CASE(my_test_suite, my_test_case_1)
+{
+    /* Hang until killed. */
+    while (!stop) {
+        continue;
+    }
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_2, .timeout = 30.0)
+{
+    char c;
+
+    c = 'x';
+    ASSERT(write(fds[1], &c, 1) == 1);
+
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+static int
+run_in_child(const struct rx_run_config *config,
+             const struct rx_test_case *test_case)
+{
+    pid_t pid;
+    int status;
+
+    fflush(NULL);
+
+    pid = fork();
+    ASSERT(pid >= 0);
+
+    if (pid == 0) {
+        rx_run_with_config(config, 1, test_case);
+        _exit(0);
+    }
+
+    ASSERT(waitpid(pid, &status, 0) == pid);
+    ASSERT(WIFEXITED(status));
+    return WEXITSTATUS(status);
+}
+
+int
+main(void)
+{
+    char c;
+    rx_size test_case_count;
+    struct rx_test_case test_cases[2];
+    struct rx_test_case test_case;
+    struct rx_run_config config;
+    const char *const argv_1[] = {"timeout", "--timeout=0.5"};
+    const char *const argv_2[] = {"timeout", "--timeout=abc"};
+    const char *const argv_3[] = {"timeout", "--isolate"};
+
+    ASSERT(rx_run_config_parse(&config, 2, argv_1) == RX_SUCCESS);
+    ASSERT(config.timeout > 0.49 && config.timeout < 0.51);
+
+    ASSERT(rx_run_config_parse(&config, 2, argv_2) == RX_ERROR);
+
+    /* The timeouts are inherited from the test suites. */
+    test_case_count = 2;
+    rx_enumerate_test_cases(&test_case_count, test_cases);
+    ASSERT(test_case_count == 2);
+    ASSERT(strcmp(test_cases[0].name, "my_test_case_1") == 0);
+    ASSERT(test_cases[0].config.timeout > 0.19
+           && test_cases[0].config.timeout < 0.21);
+    ASSERT(test_cases[1].config.timeout > 29.9
+           && test_cases[1].config.timeout < 30.1);
+
+    ASSERT(pipe(fds) == 0);
+
+    /* The hanging worker process is killed without stopping the run. */
+    ASSERT(rx_main(0, NULL, 2, argv_3) == RX_ERROR_ABORTED);
+    ASSERT(read(fds[0], &c, 1) == 1);
+    ASSERT(c == 'x');
+
+    /* When run in-process, the watchdog terminates the whole process. */
+    memset(&config, 0, sizeof config);
+    ASSERT(run_in_child(&config, &test_cases[0]) == EXIT_FAILURE);
+
+    test_case = test_cases[0];
+    test_case.config.timeout = 0.0;
+    config.timeout = 0.1;
+    ASSERT(run_in_child(&config, &test_case) == EXIT_FAILURE);
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rexo.h>
+
+#define ASSERT(x)                                                              \
+    (void)(                                                                    \
+        (x)                                                                    \
+        || (printf(__FILE__ ":%d: assertion `" #x "` failed\n", __LINE__), 0)  \
+        || (abort(), 0))
+
+#define TIMINGS_PATH "timings.rexo-timings"
+
+static int order[3];
+static int run_count;
+
+RX_TEST_CASE(my_test_suite, my_test_case_1)
+{
+    order[run_count++] = 1;
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_2)
+{
+    order[run_count++] = 2;
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+RX_TEST_CASE(my_test_suite, my_test_case_3)
+{
+    order[run_count++] = 3;
+    RX_INT_REQUIRE_EQUAL(42, 42);
+}
+
+static int
+has_entry(const char *suite_name, const char *name)
+{
+    FILE *file;
+    char line[256];
+    char prefix[128];
+    int out;
+
+    sprintf(prefix, "%s\t%s\t", suite_name, name);
+
+    file = fopen(TIMINGS_PATH, "r");
+    ASSERT(file != NULL);
+
+    out = 0;
+    while (fgets(line, sizeof line, file) != NULL) {
+        if (strncmp(line, prefix, strlen(prefix)) == 0) {
+            out = 1;
+        }
+    }
+
+    fclose(file);
+    return out;
+}
+
+int
+main(void)
+{
+    FILE *file;
+    struct rx_run_config config;
+    const char *const argv_1[] = {"timings", "--longest-first"};
+    const char *const argv_2[] = {"timings", "--timings"};
+    const char *const argv_3[]
+        = {"timings", "--timings=" TIMINGS_PATH, "--longest-first"};
+
+    ASSERT(rx_run_config_parse(&config, 2, argv_1) == RX_SUCCESS);
+    ASSERT(config.longest_first);
+    ASSERT(strcmp(config.timings_path, ".rexo-timings") == 0);
+
+    ASSERT(rx_run_config_parse(&config, 2, argv_2) == RX_SUCCESS);
+    ASSERT(!config.longest_first);
+    ASSERT(strcmp(config.timings_path, ".rexo-timings") == 0);
+
+    file = fopen(TIMINGS_PATH, "w");
+    ASSERT(file != NULL);
+    fputs("my_test_suite\tmy_test_case_1\t1000\n", file);
+    fputs("my_test_suite\tmy_test_case_2\t300000\n", file);
+    fputs("malformed line\n", file);
+    fputs("my_other_test_suite\tmy_test_case\t5\n", file);
+    fclose(file);
+
+    ASSERT(rx_main(0, NULL, 3, argv_3) == RX_SUCCESS);
+
+    /* Unknown durations first, then the longest ones. */
+    ASSERT(run_count == 3);
+    ASSERT(order[0] == 3);
+    ASSERT(order[1] == 2);
+    ASSERT(order[2] == 1);
+
+    ASSERT(has_entry("my_test_suite", "my_test_case_1"));
+    ASSERT(has_entry("my_test_suite", "my_test_case_2"));
+    ASSERT(has_entry("my_test_suite", "my_test_case_3"));
+    ASSERT(has_entry("my_other_test_suite", "my_test_case"));
+
+    remove(TIMINGS_PATH);
+    return 0;
+}